@@ -1,5 +1,5 @@
 install(
-    TARGETS NUTC24_exe
+    TARGETS NUTC24_exe NUTC24_loadgen NUTC24_backtest
     RUNTIME COMPONENT NUTC24_Runtime
 )
 
@@ -0,0 +1,165 @@
+#include "backtest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nutc {
+namespace backtest {
+
+template <typename T>
+static void
+append(std::vector<T>& to, const std::vector<T>& from)
+{
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+NoiseTrader::NoiseTrader(
+    const std::vector<TickerConfig>& tickers, int orders_per_step, float price_stddev,
+    float drift_stddev, uint64_t seed
+) :
+    tickers(tickers),
+    orders_per_step(orders_per_step), price_stddev(price_stddev),
+    drift_stddev(drift_stddev), rng(seed)
+{}
+
+std::vector<MarketOrder>
+NoiseTrader::next_step()
+{
+    std::vector<MarketOrder> orders;
+    if (tickers.empty())
+        return orders;
+
+    std::normal_distribution<float> drift(0, drift_stddev);
+    for (auto& ticker : tickers) {
+        // Floored so a long downward walk can't produce invalid prices
+        ticker.reference_price = std::max(ticker.reference_price + drift(rng), 1.0f);
+    }
+
+    std::uniform_int_distribution<size_t> pick_ticker(0, tickers.size() - 1);
+    std::bernoulli_distribution is_buy(0.5);
+    std::normal_distribution<float> price_offset(0, price_stddev);
+    std::uniform_int_distribution<int> quantity(1, 10);
+
+    orders.reserve(static_cast<size_t>(orders_per_step));
+    for (int i = 0; i < orders_per_step; i++) {
+        const TickerConfig& ticker = tickers[pick_ticker(rng)];
+        float price =
+            std::round((ticker.reference_price + price_offset(rng)) * 100) / 100;
+        orders.emplace_back(
+            BACKGROUND_UID, is_buy(rng) ? SIDE::BUY : SIDE::SELL, ticker.ticker,
+            static_cast<float>(quantity(rng)), std::max(price, 0.01f)
+        );
+    }
+    return orders;
+}
+
+Backtest::Backtest(
+    std::string uid, const std::vector<TickerConfig>& tickers, float starting_capital
+) :
+    uid(std::move(uid)),
+    starting_capital(starting_capital), tickers(tickers)
+{
+    clients.add_client(this->uid, starting_capital, true);
+    clients.add_client(BACKGROUND_UID, LOAD_TEST_CAPITAL, true);
+    for (const auto& ticker : tickers) {
+        engines.add_engine(ticker.ticker);
+        clients.modify_holdings(BACKGROUND_UID, ticker.ticker, LOAD_TEST_HOLDINGS);
+        last_prices[ticker.ticker] = ticker.reference_price;
+    }
+}
+
+messages::BacktestUpdate
+Backtest::start()
+{
+    messages::BacktestUpdate update;
+    for (const auto& ticker : tickers) {
+        liquidity::LadderConfig ladder{
+            ticker.ticker, ticker.reference_price, LIQUIDITY_TICK_SIZE,
+            LIQUIDITY_LEVELS, BACKTEST_LADDER_QUANTITY / LIQUIDITY_LEVELS
+        };
+        append(update.ob_updates, engines.add_liquidity_ladder(ladder, true));
+    }
+    return update;
+}
+
+messages::BacktestUpdate
+Backtest::step(
+    std::vector<MarketOrder> strategy_orders, std::vector<MarketOrder> background_orders
+)
+{
+    steps++;
+    messages::BacktestUpdate update;
+
+    for (auto& order : strategy_orders) {
+        order.client_uid = uid;
+        orders_placed++;
+        if (!submit(order, update))
+            orders_rejected++;
+    }
+    for (auto& order : background_orders) {
+        order.client_uid = BACKGROUND_UID;
+        submit(order, update);
+    }
+
+    return update;
+}
+
+bool
+Backtest::submit(MarketOrder& order, messages::BacktestUpdate& update)
+{
+    std::optional<EngineRef> engine = engines.get_engine(order.ticker);
+    if (!engine.has_value())
+        return false;
+    if (engine.value().get().validate_order(order, clients).has_value())
+        return false;
+
+    auto [matches, ob_updates] =
+        engine.value().get().match_validated_order(order, clients);
+    append(update.ob_updates, ob_updates);
+
+    for (const auto& match : matches) {
+        last_prices[match.ticker] = match.price;
+        if (match.buyer_uid == uid) {
+            fills++;
+            update.account_updates.push_back(
+                {clients.get_capital(uid), match.ticker, SIDE::BUY, match.price,
+                 match.quantity}
+            );
+        }
+        if (match.seller_uid == uid) {
+            fills++;
+            update.account_updates.push_back(
+                {clients.get_capital(uid), match.ticker, SIDE::SELL, match.price,
+                 match.quantity}
+            );
+        }
+    }
+    append(update.matches, matches);
+
+    if (!matches.empty())
+        append(update.ob_updates, engines.requote_after_matches(order.ticker, matches));
+    return true;
+}
+
+messages::BacktestResult
+Backtest::result() const
+{
+    float capital = clients.get_capital(uid);
+    float portfolio_value = capital;
+    for (const auto& [ticker, price] : last_prices)
+        portfolio_value += clients.get_holdings(uid, ticker) * price;
+
+    messages::BacktestResult result{};
+    result.steps = steps;
+    result.starting_capital = starting_capital;
+    result.capital = capital;
+    result.portfolio_value = portfolio_value;
+    result.pnl = portfolio_value - starting_capital;
+    result.orders_placed = orders_placed;
+    result.orders_rejected = orders_rejected;
+    result.fills = fills;
+    return result;
+}
+
+} // namespace backtest
+} // namespace nutc
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "client_manager/client_manager.hpp"
+#include "matching/manager/engine_manager.hpp"
+#include "utils/messages.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nutc {
+/**
+ * @brief Runs a single strategy against the real matching engine, offline
+ *
+ * The market is stepped rather than run in real time. Each step, the strategy's
+ * orders are matched first, then the step's background flow, which is either
+ * synthetic (NoiseTrader) or replayed from a recording. The resulting updates go back
+ * to the strategy, and the loop continues. Nothing is rate limited, since steps run
+ * as fast as the strategy answers
+ */
+namespace backtest {
+
+struct TickerConfig {
+    std::string ticker;
+    float reference_price;
+};
+
+// Places the background flow; holds enough of everything to never be rejected
+inline constexpr const char* BACKGROUND_UID = "BACKTEST_BACKGROUND";
+
+/**
+ * @brief Generates random background orders around a randomly walking price
+ */
+class NoiseTrader {
+public:
+    NoiseTrader(
+        const std::vector<TickerConfig>& tickers, int orders_per_step,
+        float price_stddev, float drift_stddev, uint64_t seed
+    );
+
+    std::vector<MarketOrder> next_step();
+
+private:
+    std::vector<TickerConfig> tickers;
+    int orders_per_step;
+    float price_stddev;
+    float drift_stddev;
+    std::mt19937_64 rng;
+};
+
+class Backtest {
+public:
+    Backtest(
+        std::string uid, const std::vector<TickerConfig>& tickers,
+        float starting_capital = STARTING_CAPITAL
+    );
+
+    /**
+     * @brief Seeds every ticker with a liquidity ladder
+     * @return The orderbook updates for the ladders, to show the strategy first
+     */
+    messages::BacktestUpdate start();
+
+    /**
+     * @brief Matches the strategy's orders, then the background orders
+     * @param strategy_orders Placed by the strategy in response to the last update;
+     * their client_uid is overwritten with the strategy's
+     */
+    messages::BacktestUpdate step(
+        std::vector<MarketOrder> strategy_orders,
+        std::vector<MarketOrder> background_orders
+    );
+
+    [[nodiscard]] messages::BacktestResult result() const;
+
+private:
+    std::string uid;
+    float starting_capital;
+    std::vector<TickerConfig> tickers;
+    manager::ClientManager clients;
+    engine_manager::Manager engines;
+    std::unordered_map<std::string, float> last_prices;
+    int steps = 0;
+    int orders_placed = 0;
+    int orders_rejected = 0;
+    int fills = 0;
+
+    // Returns false if the order was rejected
+    bool submit(MarketOrder& order, messages::BacktestUpdate& update);
+};
+
+} // namespace backtest
+} // namespace nutc
@@ -0,0 +1,199 @@
+#include "backtest/backtest.hpp"
+#include "config.h"
+#include "logging.hpp"
+
+#include <argparse/argparse.hpp>
+#include <glaze/glaze.hpp>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bt = nutc::backtest;
+
+/**
+ * NUTC24-backtest runs one strategy against the matching engine, speaking a line
+ * based protocol over stdin and stdout. It writes a JSON BacktestUpdate per line and,
+ * unless the update carries the result, reads back one JSON MarketOrderBatch with
+ * the strategy's orders. Logs go to stderr.
+ */
+struct BacktestArguments {
+    std::string uid;
+    int steps;
+    std::vector<bt::TickerConfig> tickers;
+    int background_orders;
+    uint64_t seed;
+    // JSON lines of MarketOrderBatch, one per step; empty for synthetic flow
+    std::string replay_file;
+};
+
+static bt::TickerConfig
+parse_ticker(const std::string& arg)
+{
+    size_t pos = arg.find('=');
+    if (pos == std::string::npos || pos == 0)
+        throw std::runtime_error("Ticker must be given as NAME=PRICE, got " + arg);
+    return bt::TickerConfig{arg.substr(0, pos), std::stof(arg.substr(pos + 1))};
+}
+
+static BacktestArguments
+process_arguments(int argc, const char** argv)
+{
+    argparse::ArgumentParser program(
+        "NUTC24-backtest", VERSION, argparse::default_arguments::help
+    );
+
+    program.add_argument("-u", "--uid")
+        .help("uid the strategy trades as")
+        .default_value(std::string("backtest"));
+
+    program.add_argument("-s", "--steps")
+        .help("Number of market steps to run")
+        .default_value(BACKTEST_STEPS)
+        .scan<'i', int>();
+
+    program.add_argument("-t", "--ticker")
+        .help("Ticker and reference price as NAME=PRICE; may be repeated")
+        .default_value(std::vector<std::string>{"A=100", "B=200", "C=300"})
+        .append();
+
+    program.add_argument("-b", "--background-orders")
+        .help("Synthetic background orders per step")
+        .default_value(BACKTEST_BACKGROUND_ORDERS)
+        .scan<'i', int>();
+
+    program.add_argument("--seed")
+        .help("Seed for the synthetic background flow")
+        .default_value(0)
+        .scan<'i', int>();
+
+    program.add_argument("-r", "--replay")
+        .help("Replay recorded background orders (JSON MarketOrderBatch per line)")
+        .default_value(std::string());
+
+    BacktestArguments args;
+    try {
+        program.parse_args(argc, argv);
+
+        args.uid = program.get<std::string>("--uid");
+        args.steps = program.get<int>("--steps");
+        args.background_orders = program.get<int>("--background-orders");
+        args.seed = static_cast<uint64_t>(program.get<int>("--seed"));
+        args.replay_file = program.get<std::string>("--replay");
+        for (const auto& ticker : program.get<std::vector<std::string>>("--ticker"))
+            args.tickers.push_back(parse_ticker(ticker));
+
+        if (args.steps <= 0 || args.background_orders < 0 || args.tickers.empty())
+            throw std::runtime_error("Invalid backtest configuration");
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        exit(1); // NOLINT(concurrency-*)
+    }
+
+    return args;
+}
+
+static std::optional<std::vector<std::vector<MarketOrder>>>
+read_replay(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        log_e(main, "Failed to open replay file {}", path);
+        return std::nullopt;
+    }
+
+    std::vector<std::vector<MarketOrder>> steps;
+    std::string line;
+    while (std::getline(file, line)) {
+        nutc::messages::MarketOrderBatch batch;
+        auto err = glz::read_json(batch, line);
+        if (err) {
+            log_e(main, "Malformed replay line {}: {}", steps.size() + 1, line);
+            return std::nullopt;
+        }
+        steps.push_back(std::move(batch.orders));
+    }
+    return steps;
+}
+
+static bool
+send_update(FILE* out, const nutc::messages::BacktestUpdate& update)
+{
+    std::string buffer;
+    glz::write<glz::opts{}>(update, buffer);
+    buffer += '\n';
+    return std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size()
+           && std::fflush(out) == 0;
+}
+
+static std::optional<nutc::messages::MarketOrderBatch>
+receive_orders()
+{
+    std::string line;
+    if (!std::getline(std::cin, line))
+        return std::nullopt;
+
+    nutc::messages::MarketOrderBatch batch;
+    auto err = glz::read_json(batch, line);
+    if (err) {
+        log_e(main, "Malformed order batch from strategy: {}", line);
+        return std::nullopt;
+    }
+    return batch;
+}
+
+int
+main(int argc, const char** argv)
+{
+    BacktestArguments args = process_arguments(argc, argv);
+
+    // The protocol owns stdout, so the logger's console output is sent to stderr
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    nutc::logging::init(quill::LogLevel::Warning);
+
+    std::optional<std::vector<std::vector<MarketOrder>>> replay;
+    if (!args.replay_file.empty()) {
+        replay = read_replay(args.replay_file);
+        if (!replay.has_value())
+            return 1;
+        if (replay->empty()) {
+            log_e(main, "Replay file {} has no steps", args.replay_file);
+            return 1;
+        }
+        args.steps = std::min(args.steps, static_cast<int>(replay->size()));
+    }
+    bt::NoiseTrader noise(
+        args.tickers, args.background_orders, BACKTEST_PRICE_STDDEV,
+        BACKTEST_DRIFT_STDDEV, args.seed
+    );
+
+    bt::Backtest backtest(args.uid, args.tickers);
+    if (!send_update(out, backtest.start()))
+        return 1;
+
+    for (int step = 0; step < args.steps; step++) {
+        std::optional<nutc::messages::MarketOrderBatch> orders = receive_orders();
+        if (!orders.has_value()) {
+            log_e(main, "Strategy stopped responding after {} steps", step);
+            return 1;
+        }
+
+        auto step_index = static_cast<size_t>(step);
+        std::vector<MarketOrder> background =
+            replay.has_value() ? replay->at(step_index) : noise.next_step();
+        nutc::messages::BacktestUpdate update =
+            backtest.step(std::move(orders->orders), std::move(background));
+        if (step == args.steps - 1)
+            update.result = backtest.result();
+        if (!send_update(out, update))
+            return 1;
+    }
+
+    return 0;
+}
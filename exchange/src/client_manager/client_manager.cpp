@@ -51,7 +51,7 @@ ClientManager::validate_match(const messages::Match& match) const
     bool insufficient_holdings =
         get_holdings(match.seller_uid, match.ticker) - match.quantity < 0;
 
-    if (insufficient_capital) [[unlikely]]
+    if (match.buyer_uid != "SIMULATED" && insufficient_capital) [[unlikely]]
         return messages::SIDE::BUY;
 
     if (match.seller_uid != "SIMULATED" && insufficient_holdings) [[unlikely]]
@@ -60,6 +60,32 @@ ClientManager::validate_match(const messages::Match& match) const
     return std::nullopt;
 }
 
+bool
+ClientManager::has_client(const std::string& uid) const
+{
+    return user_exists(uid);
+}
+
+bool
+ClientManager::consume_order_token(const std::string& uid)
+{
+    if (!user_exists(uid)) [[unlikely]]
+        return false;
+
+    return clients[uid].order_limiter.try_consume();
+}
+
+void
+ClientManager::set_order_rate_limit(
+    const std::string& uid, double burst, double per_sec
+)
+{
+    if (!user_exists(uid))
+        return;
+
+    clients[uid].order_limiter = rate_limiter::TokenBucket{burst, per_sec};
+}
+
 void
 ClientManager::initialize_from_firebase(const glz::json_t::object_t& users)
 {
@@ -1,6 +1,7 @@
 #pragma once
 // keep track of active users and account information
 #include "config.h"
+#include "rate_limiter/rate_limiter.hpp"
 #include "utils/messages.hpp"
 
 #include <glaze/glaze.hpp>
@@ -22,6 +23,9 @@ struct Client {
     bool active;
     float capital_remaining;
     std::unordered_map<std::string, float> holdings;
+    rate_limiter::TokenBucket order_limiter{
+        ORDER_RATE_LIMIT_BURST, ORDER_RATE_LIMIT_PER_SEC
+    };
 };
 
 class ClientManager {
@@ -44,6 +48,21 @@ public:
         const std::string& uid, const std::string& ticker, float change_in_holdings
     );
 
+    bool has_client(const std::string& uid) const;
+
+    /**
+     * @brief Spends one of the client's order tokens
+     * @return false if the client is over its rate limit, or is not a client at all,
+     * and the order must be rejected
+     */
+    bool consume_order_token(const std::string& uid);
+
+    /**
+     * @brief Replaces the client's order rate limit, which starts out as
+     * ORDER_RATE_LIMIT_BURST and ORDER_RATE_LIMIT_PER_SEC
+     */
+    void set_order_rate_limit(const std::string& uid, double burst, double per_sec);
+
     [[nodiscard]] std::optional<messages::SIDE>
     validate_match(const messages::Match& match) const;
 
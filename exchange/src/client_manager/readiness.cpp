@@ -0,0 +1,48 @@
+#include "readiness.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nutc {
+namespace manager {
+
+ReadinessTracker::ReadinessTracker(
+    size_t expected, double quorum, clock::duration deadline, clock::time_point now
+) :
+    expected(expected),
+    quorum_size(static_cast<size_t>(
+        std::ceil(static_cast<double>(expected) * std::clamp(quorum, 0.0, 1.0))
+    )),
+    deadline(now + deadline)
+{}
+
+void
+ReadinessTracker::record(const std::string& uid, bool is_ready)
+{
+    // The latest answer wins, so a client that failed and was restarted can recover
+    if (is_ready) {
+        not_ready.erase(uid);
+        ready.insert(uid);
+    }
+    else {
+        ready.erase(uid);
+        not_ready.insert(uid);
+    }
+}
+
+bool
+ReadinessTracker::should_start(clock::time_point now) const
+{
+    return num_ready() >= quorum_size || num_answered() >= expected || now >= deadline;
+}
+
+std::chrono::milliseconds
+ReadinessTracker::time_left(clock::time_point now) const
+{
+    if (now >= deadline)
+        return std::chrono::milliseconds(0);
+    return std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+}
+
+} // namespace manager
+} // namespace nutc
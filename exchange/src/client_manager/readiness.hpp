@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+
+namespace nutc {
+namespace manager {
+
+/**
+ * @class ReadinessTracker
+ * @brief Decides when enough clients have initialized for trading to start
+ *
+ * Trading starts once a quorum of the expected clients is ready, every client has
+ * answered, or the deadline passes, whichever comes first. Clients that initialize
+ * afterwards are admitted late instead of holding up everyone else
+ */
+class ReadinessTracker {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @param quorum Fraction of the expected clients that must be ready, in [0, 1]
+     */
+    ReadinessTracker(
+        size_t expected, double quorum, clock::duration deadline,
+        clock::time_point now = clock::now()
+    );
+
+    // Repeated init messages from the same client, e.g. after a restart, count once
+    void record(const std::string& uid, bool ready);
+
+    bool should_start(clock::time_point now = clock::now()) const;
+
+    // How long to keep waiting before starting regardless; zero once it has passed
+    std::chrono::milliseconds time_left(clock::time_point now = clock::now()) const;
+
+    size_t
+    num_ready() const
+    {
+        return ready.size();
+    }
+
+    size_t
+    num_answered() const
+    {
+        return ready.size() + not_ready.size();
+    }
+
+    size_t
+    num_expected() const
+    {
+        return expected;
+    }
+
+private:
+    size_t expected;
+    size_t quorum_size;
+    clock::time_point deadline;
+    std::unordered_set<std::string> ready;
+    std::unordered_set<std::string> not_ready;
+};
+
+} // namespace manager
+} // namespace nutc
@@ -2,7 +2,59 @@
 #define STARTING_CAPITAL 100000
 #define DEBUG_NUM_USERS 2
 
-#define CLIENT_WAIT_SECS 10
+// dev mode, load test and load generator clients are named <prefix><index>
+#define CLIENT_UID_PREFIX "algo_"
+
+// trading starts once this fraction of the clients is ready, every client has
+// answered, or the deadline passes; later clients join with a snapshot of the books
+#define CLIENT_READY_QUORUM        1.0
+#define CLIENT_READY_DEADLINE_SECS 60
+// gives the start time message a moment to reach every client
+#define CLIENT_START_DELAY_MS      1000
+
+// start every client from one NUTC-client fork server instead of one exec per user
+#define SPAWN_WITH_FORK_SERVER true
+
+// limits applied to every client process (0 is unlimited)
+#define CLIENT_CPU_LIMIT_SECS  600
+#define CLIENT_MEMORY_LIMIT_MB 2048
+#define CLIENT_NICENESS        10
+// times a crashed client is restarted before it is given up on, by the supervisor or
+// the fork server
+#define CLIENT_MAX_RESTARTS    2
+// clients never run on the first N cpus, which are left to the exchange
+#define EXCHANGE_RESERVED_CPUS 2
+
+// low latency mode (--low-latency); both cpus should be within the reserved ones
+#define MATCHING_THREAD_CPU    0
+#define LOGGING_THREAD_CPU     1
+#define SCHED_FIFO_PRIORITY    80
+#define SOCKET_BUSY_POLL_USECS 50
+
+// per-client order rate limit, enforced with a token bucket
+#define ORDER_RATE_LIMIT_BURST   30
+#define ORDER_RATE_LIMIT_PER_SEC 0.5
+
+// synthetic clients registered by --load-test; their rate limit is high enough that
+// the load generator, not the exchange, decides the order rate
+#define LOAD_TEST_CAPITAL                  1e9f
+#define LOAD_TEST_HOLDINGS                 1e7f
+#define LOAD_TEST_ORDER_RATE_LIMIT_BURST   10000
+#define LOAD_TEST_ORDER_RATE_LIMIT_PER_SEC 10000
+
+// --batch-auction clears each ticker's orders together at this interval
+#define BATCH_AUCTION_INTERVAL_MS 100
+
+// simulated liquidity ladders
+#define LIQUIDITY_LEVELS    5
+#define LIQUIDITY_TICK_SIZE 1.0f
+
+// offline backtests (NUTC24-backtest)
+#define BACKTEST_STEPS                 1000
+#define BACKTEST_BACKGROUND_ORDERS     2
+#define BACKTEST_PRICE_STDDEV          2.0f
+#define BACKTEST_DRIFT_STDDEV          0.1f
+#define BACKTEST_LADDER_QUANTITY       1000.0f
 
 // logging
 #define LOG_BACKTRACE_SIZE 10
@@ -15,5 +67,9 @@
 #define LOG_BACKUP_COUNT   5
 
 // firebase
+#define ALGO_CACHE_DIR             "algo_cache"
+#define ALGO_DOWNLOAD_PARALLELISM  32
+#define ALGO_DOWNLOAD_TIMEOUT_SECS 30L
+
 #define FIREBASE_URL "https://finrl-contest-2023-default-rtdb.firebaseio.com/"
 // #define FIREBASE_URL "127.0.0.1:9000"
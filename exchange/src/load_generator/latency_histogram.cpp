@@ -0,0 +1,53 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nutc {
+namespace load_generator {
+
+void
+LatencyHistogram::record(std::chrono::nanoseconds latency)
+{
+    auto latency_us = static_cast<uint64_t>(std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(latency).count()
+    ));
+    size_t bucket = std::min<size_t>(latency_us / BUCKET_WIDTH_US, NUM_BUCKETS - 1);
+    buckets[bucket]++;
+    samples++;
+    max_latency_us = std::max(max_latency_us, latency_us);
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+        buckets[i] += other.buckets[i];
+    }
+    samples += other.samples;
+    max_latency_us = std::max(max_latency_us, other.max_latency_us);
+}
+
+uint64_t
+LatencyHistogram::percentile_us(double percentile) const
+{
+    if (samples == 0)
+        return 0;
+
+    auto target = static_cast<uint64_t>(
+        std::ceil(percentile / 100.0 * static_cast<double>(samples))
+    );
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+        seen += buckets[i];
+        // The last bucket has no upper bound of its own
+        if (seen >= target && i + 1 < NUM_BUCKETS)
+            return std::min((i + 1) * BUCKET_WIDTH_US, max_latency_us);
+    }
+    return max_latency_us;
+}
+
+} // namespace load_generator
+} // namespace nutc
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace nutc {
+namespace load_generator {
+
+/**
+ * @brief Fixed-width latency histogram that can be shipped between processes
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint64_t BUCKET_WIDTH_US = 10;
+    // Covers up to 100ms; slower samples land in the last bucket
+    static constexpr size_t NUM_BUCKETS = 10000;
+
+    void record(std::chrono::nanoseconds latency);
+    void merge(const LatencyHistogram& other);
+
+    [[nodiscard]] uint64_t
+    count() const
+    {
+        return samples;
+    }
+
+    [[nodiscard]] uint64_t
+    max_us() const
+    {
+        return max_latency_us;
+    }
+
+    /**
+     * @brief Upper bound, in microseconds, of the bucket holding the given percentile
+     * @param percentile Between 0 and 100
+     */
+    [[nodiscard]] uint64_t percentile_us(double percentile) const;
+
+private:
+    std::array<uint64_t, NUM_BUCKETS> buckets{};
+    uint64_t samples = 0;
+    uint64_t max_latency_us = 0;
+};
+
+} // namespace load_generator
+} // namespace nutc
@@ -0,0 +1,453 @@
+#include "load_generator.hpp"
+
+#include "utils/messages.hpp"
+
+#include <fmt/format.h>
+#include <glaze/glaze.hpp>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <optional>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+
+#include <rabbitmq-c/amqp.h>
+#include <rabbitmq-c/tcp_socket.h>
+
+namespace nutc {
+namespace load_generator {
+
+std::vector<std::string>
+worker_uids(const LoadConfig& config, int worker_index)
+{
+    std::vector<std::string> uids;
+    for (int i = worker_index; i < config.num_clients; i += config.num_processes) {
+        uids.push_back(config.uid_prefix + std::to_string(i));
+    }
+    return uids;
+}
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+using IncomingMessage = std::variant<
+    messages::StartTime, messages::ShutdownMessage, messages::ObUpdate,
+    messages::Match, messages::AccountUpdate, messages::OrderAck,
+    messages::OrderReject>;
+
+// Orders not observed within this window are counted as unobserved
+constexpr auto LATENCY_TIMEOUT = std::chrono::seconds(5);
+// Time to keep reading after the last order so in-flight samples are counted
+constexpr auto DRAIN_TIME = std::chrono::seconds(1);
+// The exchange waits for every client's init message before sending start times
+constexpr auto START_TIMEOUT = std::chrono::seconds(300);
+
+class Connection {
+public:
+    explicit Connection(const LoadConfig& config) : conn(amqp_new_connection())
+    {
+        amqp_socket_t* socket = amqp_tcp_socket_new(conn);
+        if (!socket || amqp_socket_open(socket, config.host.c_str(), config.port)) {
+            fmt::print(
+                stderr, "Failed to open socket to {}:{}\n", config.host, config.port
+            );
+            failed = true;
+            return;
+        }
+
+        amqp_rpc_reply_t reply = amqp_login(
+            conn, "/", 0, 131072, 0, AMQP_SASL_METHOD_PLAIN, "NUFT", "ADMIN"
+        );
+        if (reply.reply_type != AMQP_RESPONSE_NORMAL) {
+            fmt::print(stderr, "Failed to login to RabbitMQ\n");
+            failed = true;
+            return;
+        }
+
+        amqp_channel_open(conn, 1);
+        failed = !check_reply("Failed to open channel");
+    }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    ~Connection()
+    {
+        amqp_channel_close(conn, 1, AMQP_REPLY_SUCCESS);
+        amqp_connection_close(conn, AMQP_REPLY_SUCCESS);
+        amqp_destroy_connection(conn);
+    }
+
+    bool
+    declare_and_consume(const std::string& queue)
+    {
+        amqp_queue_declare(
+            conn, 1, amqp_cstring_bytes(queue.c_str()), 0, 0, 0, 1, amqp_empty_table
+        );
+        if (!check_reply("Failed to declare queue"))
+            return false;
+
+        amqp_basic_consume(
+            conn, 1, amqp_cstring_bytes(queue.c_str()), amqp_empty_bytes, 0, 1, 0,
+            amqp_empty_table
+        );
+        return check_reply("Failed to consume queue");
+    }
+
+    bool
+    publish(const std::string& queue, const std::string& message)
+    {
+        int status = amqp_basic_publish(
+            conn, 1, amqp_cstring_bytes(""), amqp_cstring_bytes(queue.c_str()), 0, 0,
+            nullptr, amqp_cstring_bytes(message.c_str())
+        );
+        if (status != AMQP_STATUS_OK) {
+            fmt::print(stderr, "Failed to publish message\n");
+            failed = true;
+        }
+        return !failed;
+    }
+
+    /**
+     * @brief Waits up to the given time for a message on any consumed queue
+     * @return The message body, or nullopt on timeout or failure
+     */
+    std::optional<std::string>
+    consume(std::chrono::microseconds timeout)
+    {
+        auto micros = std::max<int64_t>(0, timeout.count());
+        timeval tv{
+            static_cast<time_t>(micros / 1'000'000),
+            static_cast<suseconds_t>(micros % 1'000'000)
+        };
+
+        amqp_envelope_t envelope;
+        amqp_maybe_release_buffers(conn);
+        amqp_rpc_reply_t res = amqp_consume_message(conn, &envelope, &tv, 0);
+
+        if (res.reply_type == AMQP_RESPONSE_LIBRARY_EXCEPTION
+            && res.library_error == AMQP_STATUS_TIMEOUT) {
+            return std::nullopt;
+        }
+        if (res.reply_type != AMQP_RESPONSE_NORMAL) {
+            fmt::print(stderr, "Failed to consume message\n");
+            failed = true;
+            return std::nullopt;
+        }
+
+        std::string message(
+            reinterpret_cast<char*>(envelope.message.body.bytes),
+            envelope.message.body.len
+        );
+        amqp_destroy_envelope(&envelope);
+        return message;
+    }
+
+    [[nodiscard]] bool
+    has_failed() const
+    {
+        return failed;
+    }
+
+private:
+    amqp_connection_state_t conn;
+    bool failed = false;
+
+    bool
+    check_reply(const char* error)
+    {
+        if (amqp_get_rpc_reply(conn).reply_type != AMQP_RESPONSE_NORMAL) {
+            fmt::print(stderr, "{}\n", error);
+            failed = true;
+        }
+        return !failed;
+    }
+};
+
+std::string
+order_key(const std::string& ticker, messages::SIDE side, float price, float quantity)
+{
+    return fmt::format("{} {} {} {}", ticker, static_cast<int>(side), price, quantity);
+}
+
+/**
+ * @brief Matches orders to the acknowledgement the exchange sends back
+ *
+ * Acks echo the order but carry no id, so orders are keyed by their contents and
+ * identical orders are assumed to be acknowledged in the order they were sent
+ */
+class LatencyTracker {
+public:
+    void
+    sent(const std::string& key, steady_clock::time_point when)
+    {
+        pending[key].push_back(when);
+    }
+
+    void
+    observed(const std::string& key, steady_clock::time_point when)
+    {
+        auto it = pending.find(key);
+        if (it == pending.end())
+            return;
+
+        histogram.record(when - it->second.front());
+        it->second.pop_front();
+        if (it->second.empty())
+            pending.erase(it);
+    }
+
+    // Forgets an order that was rejected rather than acknowledged
+    void
+    discard(const std::string& key)
+    {
+        auto it = pending.find(key);
+        if (it == pending.end())
+            return;
+
+        it->second.pop_front();
+        if (it->second.empty())
+            pending.erase(it);
+    }
+
+    // Drops samples older than LATENCY_TIMEOUT, returning how many were dropped
+    uint64_t
+    expire(steady_clock::time_point now)
+    {
+        uint64_t expired = 0;
+        for (auto it = pending.begin(); it != pending.end();) {
+            auto& times = it->second;
+            while (!times.empty() && now - times.front() > LATENCY_TIMEOUT) {
+                times.pop_front();
+                expired++;
+            }
+            it = times.empty() ? pending.erase(it) : std::next(it);
+        }
+        return expired;
+    }
+
+    uint64_t
+    expire_all()
+    {
+        uint64_t expired = 0;
+        for (const auto& [_, times] : pending)
+            expired += times.size();
+        pending.clear();
+        return expired;
+    }
+
+    LatencyHistogram histogram;
+
+private:
+    std::unordered_map<std::string, std::deque<steady_clock::time_point>> pending;
+};
+
+class OrderGenerator {
+public:
+    OrderGenerator(const LoadConfig& config, int worker_index) :
+        config(config),
+        rng(std::random_device{}() ^ static_cast<uint64_t>(worker_index)),
+        ticker_dist(0, config.tickers.size() - 1), price_noise(0, config.price_stddev),
+        side_dist(config.buy_ratio),
+        quantity_dist(config.min_quantity, config.max_quantity),
+        interarrival(config.orders_per_sec / config.num_processes)
+    {}
+
+    messages::MarketOrder
+    next_order(const std::string& uid)
+    {
+        const TickerConfig& ticker = config.tickers[ticker_dist(rng)];
+        float price = ticker.reference_price + price_noise(rng);
+        price = std::max(0.01f, std::round(price * 100) / 100);
+        return messages::MarketOrder{
+            uid, side_dist(rng) ? messages::SIDE::BUY : messages::SIDE::SELL,
+            ticker.ticker, static_cast<float>(quantity_dist(rng)), price
+        };
+    }
+
+    steady_clock::duration
+    next_interarrival()
+    {
+        double secs = config.poisson_arrivals ? interarrival(rng)
+                                              : 1.0 / interarrival.lambda();
+        return std::chrono::duration_cast<steady_clock::duration>(
+            std::chrono::duration<double>(secs)
+        );
+    }
+
+private:
+    const LoadConfig& config;
+    std::mt19937_64 rng;
+    std::uniform_int_distribution<size_t> ticker_dist;
+    std::normal_distribution<float> price_noise;
+    std::bernoulli_distribution side_dist;
+    std::uniform_int_distribution<int> quantity_dist;
+    std::exponential_distribution<double> interarrival;
+};
+
+std::optional<IncomingMessage>
+parse_message(const std::string& buf)
+{
+    IncomingMessage data{};
+    auto err = glz::read_json(data, buf);
+    if (err) {
+        fmt::print(
+            stderr, "Failed to parse message: {}\n", glz::format_error(err, buf)
+        );
+        return std::nullopt;
+    }
+    return data;
+}
+
+bool
+wait_for_start(Connection& conn, size_t num_clients)
+{
+    size_t starts_received = 0;
+    long long start_time_ns = 0;
+    auto deadline = steady_clock::now() + START_TIMEOUT;
+
+    while (starts_received < num_clients && !conn.has_failed()) {
+        auto remaining = deadline - steady_clock::now();
+        if (remaining <= steady_clock::duration::zero()) {
+            fmt::print(stderr, "Timed out waiting for start time\n");
+            return false;
+        }
+        auto buf = conn.consume(
+            std::chrono::duration_cast<std::chrono::microseconds>(remaining)
+        );
+        if (!buf.has_value())
+            continue;
+
+        auto message = parse_message(buf.value());
+        if (message.has_value()
+            && std::holds_alternative<messages::StartTime>(message.value())) {
+            start_time_ns =
+                std::get<messages::StartTime>(message.value()).start_time_ns;
+            starts_received++;
+        }
+    }
+
+    std::this_thread::sleep_until(std::chrono::high_resolution_clock::time_point(
+        std::chrono::nanoseconds(start_time_ns)
+    ));
+    return !conn.has_failed();
+}
+
+} // namespace
+
+WorkerReport
+run_worker(const LoadConfig& config, int worker_index)
+{
+    WorkerReport report;
+    std::vector<std::string> uids = worker_uids(config, worker_index);
+    if (uids.empty() || config.tickers.empty()) {
+        return report;
+    }
+
+    Connection conn{config};
+    for (const auto& uid : uids) {
+        if (conn.has_failed() || !conn.declare_and_consume(uid)) {
+            report.failed = true;
+            return report;
+        }
+    }
+    for (const auto& uid : uids) {
+        conn.publish("market_order", glz::write_json(messages::InitMessage{uid, true}));
+    }
+    if (!wait_for_start(conn, uids.size())) {
+        report.failed = true;
+        return report;
+    }
+
+    OrderGenerator generator{config, worker_index};
+    LatencyTracker tracker;
+    std::uniform_int_distribution<size_t> uid_dist(0, uids.size() - 1);
+    std::mt19937_64 uid_rng(static_cast<uint64_t>(worker_index));
+
+    auto handle_message = [&](const std::string& buf, steady_clock::time_point now) {
+        report.messages_received++;
+        auto message = parse_message(buf);
+        if (!message.has_value())
+            return true;
+        if (std::holds_alternative<messages::ShutdownMessage>(message.value()))
+            return false;
+        if (std::holds_alternative<messages::OrderAck>(message.value())) {
+            const auto& ack = std::get<messages::OrderAck>(message.value());
+            tracker.observed(
+                order_key(ack.ticker, ack.side, ack.price, ack.quantity), now
+            );
+        }
+        else if (std::holds_alternative<messages::OrderReject>(message.value())) {
+            const auto& reject = std::get<messages::OrderReject>(message.value());
+            tracker.discard(
+                order_key(reject.ticker, reject.side, reject.price, reject.quantity)
+            );
+            report.rejected_orders++;
+        }
+        return true;
+    };
+
+    auto start = steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<steady_clock::duration>(
+                                std::chrono::duration<double>(config.duration_secs)
+                            );
+    auto next_order = start;
+    auto next_expiry = start + LATENCY_TIMEOUT;
+    bool running = true;
+
+    while (running && !conn.has_failed()) {
+        auto now = steady_clock::now();
+        if (now >= deadline)
+            break;
+
+        if (now >= next_order) {
+            messages::MarketOrder order = generator.next_order(uids[uid_dist(uid_rng)]);
+            tracker.sent(
+                order_key(order.ticker, order.side, order.price, order.quantity), now
+            );
+            conn.publish("market_order", glz::write_json(order));
+            report.orders_sent++;
+            next_order += generator.next_interarrival();
+        }
+
+        if (now >= next_expiry) {
+            report.unobserved_orders += tracker.expire(now);
+            next_expiry = now + LATENCY_TIMEOUT;
+        }
+
+        // Zero timeout when behind schedule so the socket is still drained
+        auto wait = std::max(
+            std::min(next_order, deadline) - now, steady_clock::duration::zero()
+        );
+        auto buf =
+            conn.consume(std::chrono::duration_cast<std::chrono::microseconds>(wait));
+        if (buf.has_value())
+            running = handle_message(buf.value(), steady_clock::now());
+    }
+    report.elapsed_secs =
+        std::chrono::duration<double>(steady_clock::now() - start).count();
+
+    auto drain_until = steady_clock::now() + DRAIN_TIME;
+    while (running && !conn.has_failed()) {
+        auto remaining = drain_until - steady_clock::now();
+        if (remaining <= steady_clock::duration::zero())
+            break;
+        auto buf = conn.consume(
+            std::chrono::duration_cast<std::chrono::microseconds>(remaining)
+        );
+        if (buf.has_value())
+            running = handle_message(buf.value(), steady_clock::now());
+    }
+
+    report.unobserved_orders += tracker.expire_all();
+    report.latencies = tracker.histogram;
+    report.failed = conn.has_failed();
+    return report;
+}
+
+} // namespace load_generator
+} // namespace nutc
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "config.h"
+#include "load_generator/latency_histogram.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nutc {
+/**
+ * @brief Native stress-testing client that speaks the exchange's RabbitMQ protocol
+ *
+ * Each worker process owns a slice of the simulated clients, declares and consumes
+ * their queues on a single connection, and publishes randomly generated orders to
+ * the exchange at a configured rate. Latency is measured from publishing an order
+ * until its OrderAck arrives. Run the exchange with --load-test so it registers the
+ * same uids instead of spawning NUTC-client processes.
+ */
+namespace load_generator {
+
+struct TickerConfig {
+    std::string ticker;
+    float reference_price;
+};
+
+struct LoadConfig {
+    std::string host = "localhost";
+    int port = 5672;
+    std::string uid_prefix = CLIENT_UID_PREFIX;
+    int num_clients = 1000;
+    int num_processes = 4;
+    double duration_secs = 30;
+    // Total across all processes
+    double orders_per_sec = 1000;
+    // Exponential inter-arrival times if true, evenly spaced otherwise
+    bool poisson_arrivals = true;
+    std::vector<TickerConfig> tickers;
+    // Prices are drawn from N(reference_price, price_stddev) and rounded to cents
+    float price_stddev = 2;
+    float buy_ratio = 0.5f;
+    // Quantities are drawn uniformly from whole numbers in [min, max]
+    int min_quantity = 1;
+    int max_quantity = 10;
+};
+
+/**
+ * @brief Results of a single worker, written raw over a pipe to the parent process
+ */
+struct WorkerReport {
+    uint64_t orders_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t rejected_orders = 0;
+    // Orders that were neither acknowledged nor rejected within a few seconds
+    uint64_t unobserved_orders = 0;
+    double elapsed_secs = 0;
+    bool failed = false;
+    LatencyHistogram latencies;
+};
+
+/**
+ * @brief The uids simulated by the given worker; clients are split evenly
+ */
+std::vector<std::string> worker_uids(const LoadConfig& config, int worker_index);
+
+/**
+ * @brief Connects, initializes every client of this worker, waits for the start
+ * time and then generates load for the configured duration
+ */
+WorkerReport run_worker(const LoadConfig& config, int worker_index);
+
+} // namespace load_generator
+} // namespace nutc
@@ -0,0 +1,231 @@
+#include "config.h"
+#include "load_generator/load_generator.hpp"
+
+#include <argparse/argparse.hpp>
+#include <fmt/format.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace lg = nutc::load_generator;
+
+static lg::TickerConfig
+parse_ticker(const std::string& arg)
+{
+    size_t pos = arg.find('=');
+    if (pos == std::string::npos || pos == 0)
+        throw std::runtime_error("Ticker must be given as NAME=PRICE, got " + arg);
+    return lg::TickerConfig{arg.substr(0, pos), std::stof(arg.substr(pos + 1))};
+}
+
+static lg::LoadConfig
+process_arguments(int argc, const char** argv)
+{
+    argparse::ArgumentParser program(
+        "NUTC24-loadgen", VERSION, argparse::default_arguments::help
+    );
+
+    program.add_argument("-c", "--clients")
+        .help("Number of simulated clients; must match the exchange's --load-test")
+        .default_value(1000)
+        .scan<'i', int>();
+
+    program.add_argument("-p", "--processes")
+        .help("Number of worker processes the clients are split across")
+        .default_value(4)
+        .scan<'i', int>();
+
+    program.add_argument("-d", "--duration")
+        .help("Seconds to generate load for")
+        .default_value(30.0)
+        .scan<'g', double>();
+
+    program.add_argument("-r", "--rate")
+        .help("Total orders per second across all processes")
+        .default_value(1000.0)
+        .scan<'g', double>();
+
+    program.add_argument("-t", "--ticker")
+        .help("Ticker and reference price as NAME=PRICE; may be repeated")
+        .default_value(std::vector<std::string>{"A=100", "B=200", "C=300"})
+        .append();
+
+    program.add_argument("--price-stddev")
+        .help("Standard deviation of order prices around the reference price")
+        .default_value(2.0f)
+        .scan<'g', float>();
+
+    program.add_argument("--buy-ratio")
+        .help("Fraction of orders that are buys")
+        .default_value(0.5f)
+        .scan<'g', float>();
+
+    program.add_argument("--min-quantity").default_value(1).scan<'i', int>();
+    program.add_argument("--max-quantity").default_value(10).scan<'i', int>();
+
+    program.add_argument("--constant-rate")
+        .help("Space orders evenly instead of using Poisson arrivals")
+        .action([](const auto& /* unused */) {})
+        .default_value(false)
+        .implicit_value(true)
+        .nargs(0);
+
+    program.add_argument("--host").default_value(std::string("localhost"));
+    program.add_argument("--port").default_value(5672).scan<'i', int>();
+    program.add_argument("--uid-prefix")
+        .help("Must match the exchange's CLIENT_UID_PREFIX")
+        .default_value(std::string(CLIENT_UID_PREFIX));
+
+    lg::LoadConfig config;
+    try {
+        program.parse_args(argc, argv);
+
+        config.num_clients = program.get<int>("--clients");
+        config.num_processes = program.get<int>("--processes");
+        config.duration_secs = program.get<double>("--duration");
+        config.orders_per_sec = program.get<double>("--rate");
+        config.price_stddev = program.get<float>("--price-stddev");
+        config.buy_ratio = program.get<float>("--buy-ratio");
+        config.min_quantity = program.get<int>("--min-quantity");
+        config.max_quantity = program.get<int>("--max-quantity");
+        config.poisson_arrivals = !program.get<bool>("--constant-rate");
+        config.host = program.get<std::string>("--host");
+        config.port = program.get<int>("--port");
+        config.uid_prefix = program.get<std::string>("--uid-prefix");
+        for (const auto& ticker : program.get<std::vector<std::string>>("--ticker"))
+            config.tickers.push_back(parse_ticker(ticker));
+
+        if (config.num_clients <= 0 || config.num_processes <= 0
+            || config.orders_per_sec <= 0 || config.min_quantity <= 0
+            || config.max_quantity < config.min_quantity) {
+            throw std::runtime_error("Invalid load configuration");
+        }
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        exit(1); // NOLINT(concurrency-*)
+    }
+
+    config.num_processes = std::min(config.num_processes, config.num_clients);
+    return config;
+}
+
+static bool
+read_report(int fd, lg::WorkerReport& report)
+{
+    auto* buf = reinterpret_cast<char*>(&report);
+    size_t remaining = sizeof(report);
+    while (remaining > 0) {
+        ssize_t bytes = read(fd, buf, remaining);
+        if (bytes <= 0)
+            return false;
+        buf += bytes;
+        remaining -= static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+static void
+write_report(int fd, const lg::WorkerReport& report)
+{
+    const auto* buf = reinterpret_cast<const char*>(&report);
+    size_t remaining = sizeof(report);
+    while (remaining > 0) {
+        ssize_t bytes = write(fd, buf, remaining);
+        if (bytes <= 0)
+            return;
+        buf += bytes;
+        remaining -= static_cast<size_t>(bytes);
+    }
+}
+
+int
+main(int argc, const char** argv)
+{
+    lg::LoadConfig config = process_arguments(argc, argv);
+
+    fmt::println(
+        "Generating {} orders/s from {} clients in {} processes for {}s",
+        config.orders_per_sec, config.num_clients, config.num_processes,
+        config.duration_secs
+    );
+
+    struct Worker {
+        pid_t pid;
+        int fd;
+    };
+
+    std::vector<Worker> workers;
+    for (int i = 0; i < config.num_processes; i++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            std::cerr << "Failed to create pipe" << std::endl;
+            return 1;
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            write_report(fds[1], lg::run_worker(config, i));
+            close(fds[1]);
+            _exit(0);
+        }
+        if (pid < 0) {
+            std::cerr << "Failed to fork" << std::endl;
+            return 1;
+        }
+
+        close(fds[1]);
+        workers.push_back({pid, fds[0]});
+    }
+
+    lg::WorkerReport total;
+    double elapsed_secs = 0;
+    int failed_workers = 0;
+    for (const auto& worker : workers) {
+        lg::WorkerReport report;
+        if (!read_report(worker.fd, report) || report.failed)
+            failed_workers++;
+
+        total.orders_sent += report.orders_sent;
+        total.messages_received += report.messages_received;
+        total.rejected_orders += report.rejected_orders;
+        total.unobserved_orders += report.unobserved_orders;
+        total.latencies.merge(report.latencies);
+        elapsed_secs = std::max(elapsed_secs, report.elapsed_secs);
+
+        close(worker.fd);
+        waitpid(worker.pid, nullptr, 0);
+    }
+
+    if (failed_workers > 0)
+        fmt::println("{} of {} workers failed", failed_workers, workers.size());
+    if (elapsed_secs <= 0) {
+        fmt::println("No load was generated");
+        return 1;
+    }
+
+    const auto& latencies = total.latencies;
+    fmt::println(
+        "Sent {} orders ({:.1f}/s), received {} messages ({:.1f}/s)",
+        total.orders_sent, static_cast<double>(total.orders_sent) / elapsed_secs,
+        total.messages_received,
+        static_cast<double>(total.messages_received) / elapsed_secs
+    );
+    fmt::println(
+        "Order to acknowledgement latency over {} samples ({} rejected, {} "
+        "unanswered):",
+        latencies.count(), total.rejected_orders, total.unobserved_orders
+    );
+    fmt::println(
+        "  p50 {}us  p90 {}us  p99 {}us  p99.9 {}us  max {}us",
+        latencies.percentile_us(50), latencies.percentile_us(90),
+        latencies.percentile_us(99), latencies.percentile_us(99.9), latencies.max_us()
+    );
+
+    return failed_workers > 0 ? 1 : 0;
+}
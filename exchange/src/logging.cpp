@@ -30,7 +30,7 @@ using namespace quill; // NOLINT(*-using-namespace)
 using cc = quill::ConsoleColours;
 
 void
-init(quill::LogLevel log_level)
+init(quill::LogLevel log_level, int backend_cpu)
 {
     detail::application_log_level = log_level;
 
@@ -44,6 +44,10 @@ init(quill::LogLevel log_level)
     // Set main logger name
     cfg.default_logger_name = "main";
 
+    // Keep the backend off the cores doing latency sensitive work
+    if (backend_cpu >= 0)
+        cfg.backend_thread_cpu_affinity = static_cast<uint16_t>(backend_cpu);
+
     //
     // Initialize print handler
     //
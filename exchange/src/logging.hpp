@@ -49,8 +49,9 @@ set_thread_name(const std::string& name)
 
 /**
  * Set up logging.
+ * If backend_cpu is not negative, the logging backend thread is pinned to it.
  */
-void init(quill::LogLevel log_level = DEFAULT_LOG_LEVEL);
+void init(quill::LogLevel log_level = DEFAULT_LOG_LEVEL, int backend_cpu = -1);
 
 /******************************************************************************
  *                                 LOGGERS
@@ -6,10 +6,13 @@
 #include "networking/firebase/firebase.hpp"
 #include "networking/rabbitmq/rabbitmq.hpp"
 #include "process_spawning/spawning.hpp"
+#include "process_spawning/supervisor.hpp"
 #include "utils/dev_mode/dev_mode.hpp"
+#include "utils/realtime/realtime.hpp"
 
 #include <argparse/argparse.hpp>
 
+#include <chrono>
 #include <iostream>
 #include <string>
 
@@ -20,7 +23,16 @@ namespace rmq = nutc::rabbitmq;
 nutc::manager::ClientManager users;
 nutc::engine_manager::Manager engine_manager;
 
-static std::tuple<bool>
+struct ExchangeArguments {
+    bool development_mode;
+    bool market_maker;
+    int load_test_clients;
+    bool low_latency;
+    bool sched_fifo;
+    bool batch_auction;
+};
+
+static ExchangeArguments
 process_arguments(int argc, const char** argv)
 {
     argparse::ArgumentParser program(
@@ -34,6 +46,39 @@ process_arguments(int argc, const char** argv)
         .implicit_value(true)
         .nargs(0);
 
+    program.add_argument("-M", "--market-maker")
+        .help("Requote the simulated liquidity ladders after they are traded against")
+        .action([](const auto& /* unused */) {})
+        .default_value(false)
+        .implicit_value(true)
+        .nargs(0);
+
+    program.add_argument("-L", "--load-test")
+        .help("Register N algo_i clients for NUTC24-loadgen instead of spawning clients")
+        .default_value(0)
+        .scan<'i', int>();
+
+    program.add_argument("-R", "--low-latency")
+        .help("Pin the matching and logging threads to their cores and busy poll")
+        .action([](const auto& /* unused */) {})
+        .default_value(false)
+        .implicit_value(true)
+        .nargs(0);
+
+    program.add_argument("--sched-fifo")
+        .help("Run the matching thread under SCHED_FIFO (needs CAP_SYS_NICE)")
+        .action([](const auto& /* unused */) {})
+        .default_value(false)
+        .implicit_value(true)
+        .nargs(0);
+
+    program.add_argument("-B", "--batch-auction")
+        .help("Clear orders in periodic uniform price auctions instead of continuously")
+        .action([](const auto& /* unused */) {})
+        .default_value(false)
+        .implicit_value(true)
+        .nargs(0);
+
     program.add_argument("-V", "--version")
         .help("prints version information and exits")
         .action([&](const auto& /* unused */) {
@@ -52,13 +97,20 @@ process_arguments(int argc, const char** argv)
         exit(1); // NOLINT(concurrency-*)
     }
 
-    return std::make_tuple(program.get<bool>("--dev"));
+    return ExchangeArguments{
+        program.get<bool>("--dev"), program.get<bool>("--market-maker"),
+        program.get<int>("--load-test"), program.get<bool>("--low-latency"),
+        program.get<bool>("--sched-fifo"), program.get<bool>("--batch-auction")
+    };
 }
 
 void
 handle_sigint(int sig)
 {
     log_i(rabbitmq, "Caught SIGINT, closing connection");
+    auto& supervisor = nutc::client::Supervisor::get_instance();
+    log_i(main, "Stopping {} clients", supervisor.num_running());
+    supervisor.signal_all(SIGTERM);
     sleep(1);
     exit(sig);
 }
@@ -66,10 +118,13 @@ handle_sigint(int sig)
 int
 main(int argc, const char** argv)
 {
-    auto [dev_mode] = process_arguments(argc, argv);
+    auto [dev_mode, market_maker, load_test_clients, low_latency, sched_fifo,
+          batch_auction] = process_arguments(argc, argv);
 
     // Set up logging
-    nutc::logging::init(quill::LogLevel::TraceL3);
+    nutc::logging::init(
+        quill::LogLevel::TraceL3, low_latency ? LOGGING_THREAD_CPU : -1
+    );
 
     if (dev_mode) {
         log_t1(main, "Initializing NUTC24 in development mode...");
@@ -87,25 +142,55 @@ main(int argc, const char** argv)
         return 1;
     }
 
-    int num_clients = nutc::client::initialize(users, dev_mode);
+    int num_clients = load_test_clients;
+    if (load_test_clients > 0) {
+        log_i(main, "Waiting for {} load generator clients", load_test_clients);
+        nutc::dev_mode::initialize_load_test_clients(
+            users, load_test_clients, {"A", "B", "C"}
+        );
+    }
+    else {
+        num_clients = nutc::client::initialize(users, dev_mode);
+    }
 
-    engine_manager.add_engine("A");
-    engine_manager.add_engine("B");
-    engine_manager.add_engine("C");
+    auto matching_mode = batch_auction ? nutc::matching::MatchingMode::BATCH_AUCTION
+                                       : nutc::matching::MatchingMode::CONTINUOUS;
+    engine_manager.add_engine("A", matching_mode);
+    engine_manager.add_engine("B", matching_mode);
+    engine_manager.add_engine("C", matching_mode);
 
     // Run exchange
     rmq::RabbitMQClientManager::waitForClients(users, num_clients);
-    rmq::RabbitMQClientManager::sendStartTime(users, CLIENT_WAIT_SECS);
-    rmq::RabbitMQOrderHandler::addLiquidityToTicker(
-        users, engine_manager, "A", 1000, 100
+    rmq::RabbitMQClientManager::sendStartTime(
+        users, std::chrono::milliseconds(CLIENT_START_DELAY_MS)
     );
-    rmq::RabbitMQOrderHandler::addLiquidityToTicker(
-        users, engine_manager, "B", 2000, 200
-    );
-    rmq::RabbitMQOrderHandler::addLiquidityToTicker(
-        users, engine_manager, "C", 3000, 300
+    auto add_ladder = [&](const std::string& ticker, float price, float quantity) {
+        nutc::liquidity::LadderConfig ladder{
+            ticker, price, LIQUIDITY_TICK_SIZE, LIQUIDITY_LEVELS,
+            quantity / LIQUIDITY_LEVELS
+        };
+        rmq::RabbitMQOrderHandler::addLiquidityLadder(
+            users, engine_manager, ladder, market_maker
+        );
+    };
+    add_ladder("A", 100, 1000);
+    add_ladder("B", 200, 2000);
+    add_ladder("C", 300, 3000);
+
+    // Done after spawning so that helper threads don't inherit the pinning/priority
+    if (low_latency) {
+        nutc::realtime::pin_current_thread(MATCHING_THREAD_CPU);
+        rmq::RabbitMQConsumer::enableBusyPoll();
+    }
+    if (sched_fifo) {
+        nutc::realtime::enable_fifo_scheduling(SCHED_FIFO_PRIORITY);
+    }
+    std::chrono::milliseconds auction_interval{
+        batch_auction ? BATCH_AUCTION_INTERVAL_MS : 0
+    };
+    rmq::RabbitMQConsumer::handleIncomingMessages(
+        users, engine_manager, auction_interval
     );
-    rmq::RabbitMQConsumer::handleIncomingMessages(users, engine_manager);
 
     return 0;
 }
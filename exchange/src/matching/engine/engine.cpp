@@ -2,32 +2,99 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <vector>
 
 namespace nutc {
 namespace matching {
 
-void
-Engine::add_order_without_matching(MarketOrder order)
+ObUpdate
+Engine::add_order_without_matching(const MarketOrder& order)
+{
+    get_orders(order.side).push(order);
+    float& level = get_levels(order.side)[order.price];
+    level += order.quantity;
+    return ObUpdate{order.ticker, order.side, order.price, level};
+}
+
+float
+Engine::level_quantity(SIDE side, float price) const
 {
-    if (order.side == SIDE::BUY) {
-        bids.push(order);
+    const std::map<float, float>& levels = side == SIDE::BUY ? bid_levels : ask_levels;
+    auto level = levels.find(price);
+    return level == levels.end() ? 0 : level->second;
+}
+
+std::vector<ObUpdate>
+Engine::snapshot() const
+{
+    std::vector<ObUpdate> updates;
+    if (!bids.empty()) {
+        for (const auto& [price, quantity] : bid_levels)
+            updates.push_back(ObUpdate{bids.top().ticker, SIDE::BUY, price, quantity});
     }
-    else {
-        asks.push(order);
+    if (!asks.empty()) {
+        for (const auto& [price, quantity] : ask_levels)
+            updates.push_back(ObUpdate{asks.top().ticker, SIDE::SELL, price, quantity});
+    }
+    return updates;
+}
+
+std::map<float, float>&
+Engine::get_levels(SIDE side)
+{
+    return side == SIDE::SELL ? this->ask_levels : this->bid_levels;
+}
+
+void
+Engine::touch_level(const MarketOrder& order)
+{
+    for (const auto& level : touched_levels) {
+        if (level.side == order.side && level.price == order.price)
+            return;
     }
+    float quantity = level_quantity(order.side, order.price);
+    touched_levels.push_back({order.ticker, order.side, order.price, quantity});
 }
 
-constexpr ObUpdate
-create_ob_update(const MarketOrder& order, float quantity)
+void
+Engine::add_to_book(const MarketOrder& order)
 {
-    return ObUpdate{order.ticker, order.side, order.price, quantity};
+    touch_level(order);
+    add_order_without_matching(order);
 }
 
 void
-add_ob_update(std::vector<ObUpdate>& vec, const MarketOrder& order, float quantity)
+Engine::remove_top(SIDE side)
 {
-    vec.push_back(create_ob_update(order, quantity));
+    std::priority_queue<MarketOrder>& orders = get_orders(side);
+    const MarketOrder& order = orders.top();
+    touch_level(order);
+
+    std::map<float, float>& levels = get_levels(side);
+    auto level = levels.find(order.price);
+    level->second -= order.quantity;
+    if (messages::is_close_to_zero(level->second))
+        levels.erase(level);
+    orders.pop();
+}
+
+std::vector<ObUpdate>
+Engine::take_level_updates()
+{
+    std::vector<ObUpdate> updates;
+    for (bool grown : {false, true}) {
+        for (const auto& level : touched_levels) {
+            float quantity = level_quantity(level.side, level.price);
+            if (messages::is_close_to_zero(quantity - level.quantity_before))
+                continue;
+            if ((quantity > level.quantity_before) == grown)
+                updates.push_back({level.ticker, level.side, level.price, quantity});
+        }
+    }
+    touched_levels.clear();
+    return updates;
 }
 
 std::priority_queue<MarketOrder>&
@@ -53,24 +120,148 @@ insufficient_holdings(const MarketOrder& order, const manager::ClientManager& ma
     return order.side == SIDE::SELL && order.quantity > holdings;
 }
 
+static constexpr SIDE
+opposite(SIDE side)
+{
+    return side == SIDE::BUY ? SIDE::SELL : SIDE::BUY;
+}
+
+// Market orders are matched as limit orders priced to cross anything on the other side
+static MarketOrder
+with_limit_price(const MarketOrder& order)
+{
+    MarketOrder limit_order = order;
+    if (order.type == messages::OrderType::MARKET) {
+        limit_order.price =
+            order.side == SIDE::BUY ? std::numeric_limits<float>::max() : 0;
+    }
+    return limit_order;
+}
+
+std::optional<messages::RejectReason>
+Engine::validate_order(const MarketOrder& order, const manager::ClientManager& manager)
+{
+    bool is_market = order.type == messages::OrderType::MARKET;
+    if (!(order.quantity > 0) || (!is_market && !(order.price > 0))) [[unlikely]]
+        return messages::RejectReason::INVALID_ORDER;
+
+    bool is_post_only = order.type == messages::OrderType::POST_ONLY;
+    if (is_post_only && order.time_in_force != messages::TimeInForce::GTC)
+        return messages::RejectReason::INVALID_ORDER;
+
+    // Both are defined against the book at arrival, which auctions don't have
+    if (mode == MatchingMode::BATCH_AUCTION
+        && (is_post_only || order.time_in_force == messages::TimeInForce::FOK))
+        return messages::RejectReason::INVALID_ORDER;
+
+    // What a market buy costs is only known as it fills, so each fill is checked
+    if (!is_market && insufficient_capital(order, manager))
+        return messages::RejectReason::INSUFFICIENT_CAPITAL;
+
+    if (insufficient_holdings(order, manager))
+        return messages::RejectReason::INSUFFICIENT_HOLDINGS;
+
+    if (is_post_only) {
+        std::priority_queue<MarketOrder>& makers = get_orders(opposite(order.side));
+        if (!makers.empty() && order.can_match(makers.top()))
+            return messages::RejectReason::WOULD_CROSS;
+    }
+
+    return std::nullopt;
+}
+
 MatchResult
 Engine::match_order(MarketOrder& order, manager::ClientManager& manager)
 {
-    MatchResult result;
+    if (validate_order(order, manager).has_value()) {
+        return {};
+    }
+
+    return match_validated_order(order, manager);
+}
 
-    if (insufficient_capital(order, manager)) {
-        return result;
+MatchResult
+Engine::match_validated_order(MarketOrder& order, manager::ClientManager& manager)
+{
+    if (mode == MatchingMode::BATCH_AUCTION) {
+        pending.push_back(with_limit_price(order));
+        return {};
     }
 
-    if (insufficient_holdings(order, manager)) {
-        return result;
+    if (!order.can_rest()) {
+        return match_immediately(with_limit_price(order), manager);
     }
 
-    get_orders(order.side).push(order);
+    add_to_book(order);
+    MatchResult result = attempt_matches(manager);
+    result.ob_updates = take_level_updates();
+    return result;
+}
 
-    MatchResult res = attempt_matches(manager, order);
+MatchResult
+Engine::match_immediately(const MarketOrder& order, manager::ClientManager& manager)
+{
+    std::priority_queue<MarketOrder>& makers = get_orders(opposite(order.side));
+    if (makers.empty() || !order.can_match(makers.top()))
+        return {};
+
+    if (order.time_in_force == messages::TimeInForce::FOK) {
+        float unfillable = order.quantity - fillable_quantity(order, manager);
+        if (unfillable > 0 && !messages::is_close_to_zero(unfillable))
+            return {};
+    }
+
+    // The book was uncrossed before, so an order that crosses it is the best on its
+    // side, and whatever is left of it after matching is still on top
+    std::priority_queue<MarketOrder>& own_side = get_orders(order.side);
+    add_to_book(order);
+    MatchResult result = attempt_matches(manager);
+    if (!own_side.empty() && own_side.top().order_index == order.order_index)
+        remove_top(order.side);
+    result.ob_updates = take_level_updates();
+    return result;
+}
+
+float
+Engine::fillable_quantity(
+    const MarketOrder& order, const manager::ClientManager& manager
+)
+{
+    std::priority_queue<MarketOrder>& makers = get_orders(opposite(order.side));
+    std::vector<MarketOrder> seen;
+    float quantity = 0;
+    float cost = 0;
+    float capital = manager.get_capital(order.client_uid);
+    while (!makers.empty() && quantity < order.quantity
+           && order.can_match(makers.top())) {
+        const MarketOrder& maker = makers.top();
+        float fill = std::min(order.quantity - quantity, maker.quantity);
+        bool is_buy = order.side == SIDE::BUY;
+        std::string buyer_uid = is_buy ? order.client_uid : maker.client_uid;
+        std::string seller_uid = is_buy ? maker.client_uid : order.client_uid;
+        Match match{order.ticker, buyer_uid,   seller_uid,
+                    order.side,   maker.price, fill};
+
+        // Resting orders whose owners can no longer settle them are skipped when
+        // matching, so they don't count towards the fill
+        std::optional<SIDE> match_failure = manager.validate_match(match);
+        if (!match_failure.has_value()) {
+            if (is_buy && cost + fill * maker.price > capital)
+                break;
+            quantity += fill;
+            cost += fill * maker.price;
+        }
+        else if (match_failure.value() == order.side) {
+            break;
+        }
 
-    return res;
+        seen.push_back(maker);
+        makers.pop();
+    }
+
+    for (const auto& maker : seen)
+        makers.push(maker);
+    return quantity;
 }
 
 inline constexpr bool
@@ -85,6 +276,23 @@ is_same_value(float value1, float value2, float epsilon = 1e-6f)
     return std::fabs(value1 - value2) < epsilon;
 }
 
+// Logs the match, adds it to the result and moves the capital and shares it trades
+static void
+settle_match(MatchResult& result, const Match& match, manager::ClientManager& manager)
+{
+    events::Logger& logger = events::Logger::get_logger();
+    std::string buf;
+    glz::write<glz::opts{}>(match, buf);
+    logger.log_event(events::MESSAGE_TYPE::MATCH, buf);
+
+    result.matches.push_back(match);
+
+    manager.modify_capital(match.buyer_uid, -match.quantity * match.price);
+    manager.modify_capital(match.seller_uid, match.quantity * match.price);
+    manager.modify_holdings(match.seller_uid, match.ticker, -match.quantity);
+    manager.modify_holdings(match.buyer_uid, match.ticker, match.quantity);
+}
+
 float
 Engine::get_match_quantity(
     const MarketOrder& passive_order, const MarketOrder& aggressive_order
@@ -108,13 +316,9 @@ Engine::get_aggressive_side(const MarketOrder& order1, const MarketOrder& order2
 }
 
 MatchResult
-Engine::attempt_matches(
-    manager::ClientManager& manager, const MarketOrder& aggressive_order
-)
+Engine::attempt_matches(manager::ClientManager& manager)
 {
     MatchResult result;
-    float aggressive_quantity = aggressive_order.quantity;
-    float aggressive_index = aggressive_order.order_index;
 
     while (bids.size() > 0 && asks.size() > 0 && bids.top().can_match(asks.top())) {
         MarketOrder sell_order = asks.top();
@@ -131,67 +335,200 @@ Engine::attempt_matches(
 
         Match toMatch = Match{sell_order.ticker, buyer_uid,      seller_uid,
                               aggressive_side,   price_to_match, quantity_to_match};
+        toMatch.buy_order_index = buy_order.order_index;
+        toMatch.sell_order_index = sell_order.order_index;
 
         std::optional<SIDE> match_failure = manager.validate_match(toMatch);
         if (match_failure.has_value()) {
-            SIDE side = match_failure.value();
-            if (side == SIDE::BUY)
-                bids.pop();
-            else
-                asks.pop();
+            remove_top(match_failure.value());
             continue;
         }
 
         last_sell_price = price_to_match;
 
-        bids.pop();
-        asks.pop();
+        remove_top(SIDE::BUY);
+        remove_top(SIDE::SELL);
 
         buy_order.quantity -= quantity_to_match;
         sell_order.quantity -= quantity_to_match;
 
-        events::Logger& logger = events::Logger::get_logger();
-        std::string buf;
-        glz::write<glz::opts{}>(toMatch, buf);
-        logger.log_event(events::MESSAGE_TYPE::MATCH, buf);
+        settle_match(result, toMatch, manager);
 
-        result.matches.push_back(toMatch);
+        if (!is_close_to_zero(buy_order.quantity))
+            add_to_book(buy_order);
 
-        bool sell_aggressive = is_same_value(sell_order.order_index, aggressive_index);
-        bool buy_aggressive = is_same_value(buy_order.order_index, aggressive_index);
+        if (!is_close_to_zero(sell_order.quantity))
+            add_to_book(sell_order);
+    }
 
-        if (buy_aggressive)
-            aggressive_quantity -= quantity_to_match;
-        else
-            add_ob_update(result.ob_updates, buy_order, 0);
+    return result;
+}
 
-        if (sell_aggressive)
-            aggressive_quantity -= quantity_to_match;
-        else
-            add_ob_update(result.ob_updates, sell_order, 0);
+// Highest priority first, as the book would pop them
+static void
+sort_by_priority(std::vector<MarketOrder>& orders)
+{
+    std::stable_sort(
+        orders.begin(), orders.end(),
+        [](const MarketOrder& a, const MarketOrder& b) { return b < a; }
+    );
+}
 
-        if (!is_close_to_zero(buy_order.quantity)) {
-            if (!buy_aggressive)
-                add_ob_update(result.ob_updates, buy_order, buy_order.quantity);
-            bids.push(buy_order);
+/**
+ * @param bids Crossed bids, highest price first
+ * @param asks Crossed asks, lowest price first
+ * @return nullopt if only market orders crossed, so there is no price to trade at
+ */
+static std::optional<float>
+find_clearing_price(
+    const std::vector<MarketOrder>& bids, const std::vector<MarketOrder>& asks
+)
+{
+    // Market orders take any price, so only limit prices are candidates
+    std::vector<float> prices;
+    float demand = 0;
+    for (const auto& bid : bids) {
+        if (bid.type != messages::OrderType::MARKET)
+            prices.push_back(bid.price);
+        demand += bid.quantity;
+    }
+    for (const auto& ask : asks) {
+        if (ask.type != messages::OrderType::MARKET)
+            prices.push_back(ask.price);
+    }
+    if (prices.empty())
+        return std::nullopt;
+    std::sort(prices.begin(), prices.end());
+    prices.erase(std::unique(prices.begin(), prices.end()), prices.end());
+
+    // Walks the candidate prices upwards, so supply only grows and demand only shrinks
+    float supply = 0;
+    size_t next_ask = 0;
+    size_t lowest_bid = bids.size();
+    float best_volume = -1;
+    float best_imbalance = 0;
+    float low = prices.front();
+    float high = prices.front();
+    for (float price : prices) {
+        while (next_ask < asks.size() && asks[next_ask].price <= price)
+            supply += asks[next_ask++].quantity;
+        while (lowest_bid > 0 && bids[lowest_bid - 1].price < price)
+            demand -= bids[--lowest_bid].quantity;
+
+        float volume = std::min(demand, supply);
+        float imbalance = std::fabs(demand - supply);
+        bool same_volume = is_same_value(volume, best_volume);
+        if ((!same_volume && volume > best_volume)
+            || (same_volume && !is_same_value(imbalance, best_imbalance)
+                && imbalance < best_imbalance)) {
+            best_volume = volume;
+            best_imbalance = imbalance;
+            low = price;
+            high = price;
         }
+        else if (same_volume && is_same_value(imbalance, best_imbalance)) {
+            high = price;
+        }
+    }
+    return (low + high) / 2;
+}
 
-        if (!is_close_to_zero(sell_order.quantity)) {
-            if (!sell_aggressive)
-                add_ob_update(result.ob_updates, sell_order, sell_order.quantity);
-            asks.push(sell_order);
+MatchResult
+Engine::clear_auction(manager::ClientManager& manager)
+{
+    MatchResult result;
+    std::vector<MarketOrder> batch = std::move(pending);
+    pending.clear();
+
+    // Orders that can't rest only take part in this auction, so never enter the book
+    std::vector<MarketOrder> takers;
+    std::optional<float> best_bid;
+    std::optional<float> best_ask;
+    for (const auto& order : batch) {
+        if (order.can_rest()) {
+            add_to_book(order);
+        }
+        else if (order.side == SIDE::BUY) {
+            takers.push_back(order);
+            best_bid = std::max(best_bid.value_or(order.price), order.price);
+        }
+        else {
+            takers.push_back(order);
+            best_ask = std::min(best_ask.value_or(order.price), order.price);
         }
+    }
+    if (!bids.empty())
+        best_bid = std::max(best_bid.value_or(bids.top().price), bids.top().price);
+    if (!asks.empty())
+        best_ask = std::min(best_ask.value_or(asks.top().price), asks.top().price);
+
+    // Only orders priced inside the crossed range can trade or move the price
+    std::vector<MarketOrder> crossed_bids;
+    std::vector<MarketOrder> crossed_asks;
+    if (best_bid.has_value() && best_ask.has_value()
+        && best_bid.value() >= best_ask.value()) {
+        for (; !bids.empty() && bids.top().price >= best_ask.value();
+             remove_top(SIDE::BUY))
+            crossed_bids.push_back(bids.top());
+        for (; !asks.empty() && asks.top().price <= best_bid.value();
+             remove_top(SIDE::SELL))
+            crossed_asks.push_back(asks.top());
+        for (const auto& taker : takers) {
+            if (taker.side == SIDE::BUY && taker.price >= best_ask.value())
+                crossed_bids.push_back(taker);
+            else if (taker.side == SIDE::SELL && taker.price <= best_bid.value())
+                crossed_asks.push_back(taker);
+        }
+        sort_by_priority(crossed_bids);
+        sort_by_priority(crossed_asks);
+    }
 
-        manager.modify_capital(buyer_uid, -quantity_to_match * price_to_match);
-        manager.modify_capital(seller_uid, quantity_to_match * price_to_match);
-        manager.modify_holdings(seller_uid, buy_order.ticker, -quantity_to_match);
-        manager.modify_holdings(buyer_uid, buy_order.ticker, quantity_to_match);
+    std::optional<float> clearing_price;
+    if (!crossed_bids.empty() && !crossed_asks.empty())
+        clearing_price = find_clearing_price(crossed_bids, crossed_asks);
+    if (clearing_price.has_value()) {
+        float price = clearing_price.value();
+        auto bid = crossed_bids.begin();
+        auto ask = crossed_asks.begin();
+        while (bid != crossed_bids.end() && ask != crossed_asks.end()
+               && bid->price >= price && ask->price <= price) {
+            MarketOrder& buy_order = *bid;
+            MarketOrder& sell_order = *ask;
+            float quantity = get_match_quantity(buy_order, sell_order);
+            SIDE aggressive_side = get_aggressive_side(sell_order, buy_order);
+            Match match{buy_order.ticker, buy_order.client_uid, sell_order.client_uid,
+                        aggressive_side,  price,                quantity};
+            match.buy_order_index = buy_order.order_index;
+            match.sell_order_index = sell_order.order_index;
+
+            std::optional<SIDE> match_failure = manager.validate_match(match);
+            if (match_failure.has_value()) {
+                MarketOrder& failed =
+                    match_failure.value() == SIDE::BUY ? *bid++ : *ask++;
+                failed.quantity = 0;
+                continue;
+            }
+
+            last_sell_price = price;
+            buy_order.quantity -= quantity;
+            sell_order.quantity -= quantity;
+            settle_match(result, match, manager);
+
+            if (is_close_to_zero(buy_order.quantity))
+                bid++;
+            if (is_close_to_zero(sell_order.quantity))
+                ask++;
+        }
     }
 
-    if (aggressive_quantity > 0) {
-        add_ob_update(result.ob_updates, aggressive_order, aggressive_quantity);
+    for (auto* side : {&crossed_bids, &crossed_asks}) {
+        for (const auto& order : *side) {
+            if (!is_close_to_zero(order.quantity) && order.can_rest())
+                add_to_book(order);
+        }
     }
 
+    result.ob_updates = take_level_updates();
     return result;
 }
 
@@ -7,6 +7,7 @@
 
 #include <chrono>
 
+#include <map>
 #include <optional>
 #include <queue>
 #include <vector>
@@ -27,35 +28,128 @@ struct MatchResult {
     std::vector<ObUpdate> ob_updates;
 };
 
+enum class MatchingMode {
+    // Every order is matched against the book as soon as it arrives
+    CONTINUOUS,
+    // Orders are held until clear_auction, which fills them all at one price
+    BATCH_AUCTION
+};
+
 class Engine {
 public:
     std::priority_queue<MarketOrder> bids;
     std::priority_queue<MarketOrder> asks;
 
+    explicit Engine(MatchingMode mode = MatchingMode::CONTINUOUS) : mode(mode) {}
+
+    MatchingMode
+    get_mode() const
+    {
+        return mode;
+    }
+
     /**
      * @brief Matches the given order against the current order book.
      * @param aggressive_order The order to match against the order book.
      * @param manager ClientManager to verify validity of orders/matches (correct
      * funds/holdings)
-     * @return a MatchResult containing all matches and a vector containing the
-     * orderbook updates
+     * @return a MatchResult containing all matches and an orderbook update for every
+     * price level whose total resting quantity changed. In batch auction mode the
+     * order is only queued for the next auction, so the result is always empty
+     *
+     * Orders that can't rest trade only against what is in the book on arrival, and
+     * whatever they leave unfilled is dropped without ever entering the book
      */
     MatchResult
     match_order(MarketOrder& aggressive_order, manager::ClientManager& manager);
 
-    void add_order_without_matching(MarketOrder aggressive_order);
+    /**
+     * @brief match_order without validation, for callers that already ran
+     * validate_order on the order to report why it was rejected
+     */
+    MatchResult match_validated_order(
+        MarketOrder& aggressive_order, manager::ClientManager& manager
+    );
+
+    /**
+     * @brief Rests the order in the book without matching it
+     * @return The update for the order's price level, carrying its new total
+     */
+    ObUpdate add_order_without_matching(const MarketOrder& order);
+
+    // Total quantity resting at the price on the given side of the book
+    float level_quantity(SIDE side, float price) const;
+
+    /**
+     * @brief Runs a batch auction over the book and every order queued since the last
+     *
+     * The clearing price maximizes the traded volume, then minimizes the volume left
+     * unfilled at it, then is the middle of whatever prices remain tied. Every fill is
+     * at that price, with orders filled in price-time priority. Queued orders that
+     * can't rest take part in this auction only
+     * @return The auction's matches and the orderbook updates for every price level
+     * it changed, including the levels queued orders now rest at
+     */
+    MatchResult clear_auction(manager::ClientManager& manager);
+
+    // Orders waiting for the next auction
+    size_t
+    num_pending() const
+    {
+        return pending.size();
+    }
+
+    /**
+     * @brief The resting quantity at every price level of the book
+     * @return Updates that rebuild the book from empty, for clients that join late
+     */
+    std::vector<ObUpdate> snapshot() const;
+
+    /**
+     * @brief Checks whether an order is well formed and affordable for its placer
+     * @return The reason the order must be rejected, or nullopt if it can be matched
+     */
+    std::optional<messages::RejectReason>
+    validate_order(const MarketOrder& order, const manager::ClientManager& manager);
 
 private:
-    float last_sell_price;
+    // A price level changed by the operation in progress, and its total before it
+    struct TouchedLevel {
+        std::string ticker;
+        SIDE side;
+        float price;
+        float quantity_before;
+    };
+
+    MatchingMode mode;
+    std::vector<MarketOrder> pending;
+    float last_sell_price{};
+    // Total resting quantity at each price, kept in step with bids and asks
+    std::map<float, float> bid_levels;
+    std::map<float, float> ask_levels;
+    std::vector<TouchedLevel> touched_levels;
     static std::string get_client_uid(
         SIDE side, const MarketOrder& aggressive, const MarketOrder& passive
     );
     float get_match_quantity(const MarketOrder& passive, const MarketOrder& aggressive);
 
     std::priority_queue<MarketOrder>& get_orders(SIDE side);
+    std::map<float, float>& get_levels(SIDE side);
+
+    // Book changes made while matching, which report the levels they touch
+    void add_to_book(const MarketOrder& order);
+    void remove_top(SIDE side);
+    void touch_level(const MarketOrder& order);
+    // One update per touched level whose total changed. Levels that shrank come
+    // first, so applying the updates in order never shows a crossed book
+    std::vector<ObUpdate> take_level_updates();
 
+    MatchResult attempt_matches(manager::ClientManager& manager);
     MatchResult
-    attempt_matches(manager::ClientManager& manager, const MarketOrder& aggressive);
+    match_immediately(const MarketOrder& order, manager::ClientManager& manager);
+    // How much of the order the book could fill right now
+    float
+    fillable_quantity(const MarketOrder& order, const manager::ClientManager& manager);
     SIDE get_aggressive_side(const MarketOrder& order1, const MarketOrder& order2);
     bool insufficient_capital(
         const MarketOrder& order, const manager::ClientManager& manager
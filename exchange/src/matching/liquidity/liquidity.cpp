@@ -0,0 +1,106 @@
+#include "liquidity.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nutc {
+namespace liquidity {
+
+std::vector<MarketOrder>
+build_ladder(const LadderConfig& config)
+{
+    std::vector<MarketOrder> orders;
+    orders.reserve(static_cast<size_t>(std::max(config.levels, 0)) * 2);
+
+    float quantity = config.quantity_per_level;
+    for (int level = 0; level < config.levels; level++) {
+        float offset = config.tick_size * static_cast<float>(level + 1);
+        orders.emplace_back(
+            "SIMULATED", SIDE::BUY, config.ticker, quantity,
+            config.reference_price - offset
+        );
+        orders.emplace_back(
+            "SIMULATED", SIDE::SELL, config.ticker, quantity,
+            config.reference_price + offset
+        );
+        quantity *= config.quantity_growth;
+    }
+
+    return orders;
+}
+
+MarketMaker::MarketMaker(const LadderConfig& config) : ticker(config.ticker)
+{
+    for (const auto& order : build_ladder(config)) {
+        levels.push_back(Level{order.side, order.price, order.quantity, 0});
+    }
+}
+
+std::vector<ObUpdate>
+MarketMaker::seed(matching::Engine& engine)
+{
+    for (auto& level : levels) {
+        level.resting_quantity = 0;
+    }
+    return requote(engine);
+}
+
+void
+MarketMaker::on_match(const Match& match)
+{
+    if (match.ticker != ticker) [[unlikely]]
+        return;
+
+    auto record_fill = [&](long long order_index) {
+        auto order = resting_orders.find(order_index);
+        if (order == resting_orders.end())
+            return;
+
+        Level& level = levels[order->second.level];
+        level.resting_quantity =
+            std::max(0.0f, level.resting_quantity - match.quantity);
+        order->second.quantity -= match.quantity;
+        if (order->second.quantity <= 0
+            || messages::is_close_to_zero(order->second.quantity)) {
+            resting_orders.erase(order);
+        }
+    };
+
+    if (match.buyer_uid == "SIMULATED")
+        record_fill(match.buy_order_index);
+    if (match.seller_uid == "SIMULATED")
+        record_fill(match.sell_order_index);
+}
+
+bool
+MarketMaker::crosses_book(const matching::Engine& engine, SIDE side, float price)
+{
+    if (side == SIDE::BUY)
+        return !engine.asks.empty() && engine.asks.top().price <= price;
+    return !engine.bids.empty() && engine.bids.top().price >= price;
+}
+
+std::vector<ObUpdate>
+MarketMaker::requote(matching::Engine& engine)
+{
+    std::vector<ObUpdate> updates;
+
+    for (size_t index = 0; index < levels.size(); index++) {
+        Level& level = levels[index];
+        float missing = level.target_quantity - level.resting_quantity;
+        if (missing <= 0 || messages::is_close_to_zero(missing))
+            continue;
+        if (crosses_book(engine, level.side, level.price))
+            continue;
+
+        MarketOrder order{"SIMULATED", level.side, ticker, missing, level.price};
+        updates.push_back(engine.add_order_without_matching(order));
+        resting_orders[order.order_index] = RestingOrder{index, missing};
+        level.resting_quantity = level.target_quantity;
+    }
+
+    return updates;
+}
+
+} // namespace liquidity
+} // namespace nutc
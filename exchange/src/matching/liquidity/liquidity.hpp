@@ -0,0 +1,94 @@
+#pragma once
+
+#include "matching/engine/engine.hpp"
+#include "utils/messages.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nutc {
+/**
+ * @brief Seeds order books with simulated liquidity and maintains it while trading
+ */
+namespace liquidity {
+
+/**
+ * @brief Describes a symmetric ladder of SIMULATED orders around a reference price
+ *
+ * Level i (0-indexed) on each side rests (i + 1) ticks away from the reference price,
+ * so the innermost bid and ask are two ticks apart
+ */
+struct LadderConfig {
+    std::string ticker;
+    float reference_price;
+    float tick_size;
+    int levels;
+    float quantity_per_level;
+    // Multiplier applied to the quantity of each level further from the reference
+    float quantity_growth = 1.0f;
+};
+
+/**
+ * @brief Builds the bids and asks of a ladder, innermost levels first
+ */
+std::vector<MarketOrder> build_ladder(const LadderConfig& config);
+
+/**
+ * @class MarketMaker
+ * @brief Passive market maker that keeps a ladder topped up inside the exchange
+ *
+ * Tracks how much of each ladder level is still resting in the book. After fills
+ * against SIMULATED orders, requote() reposts the missing quantity at the original
+ * level prices. Levels that would cross the opposite side of the book are skipped
+ * until a later requote, so the market maker never takes liquidity
+ *
+ * Fills are attributed to levels by the order that traded rather than the match
+ * price, since a batch auction fills every order at its clearing price
+ */
+class MarketMaker {
+public:
+    explicit MarketMaker(const LadderConfig& config);
+
+    /**
+     * @brief Places the full ladder into the engine without matching
+     * @return The orderbook updates for every level placed
+     */
+    std::vector<ObUpdate> seed(matching::Engine& engine);
+
+    /**
+     * @brief Records a fill; matches that don't involve an order the market maker
+     * placed are ignored
+     */
+    void on_match(const Match& match);
+
+    /**
+     * @brief Reposts the filled quantity of every level that doesn't cross the book
+     * @return The orderbook updates for the levels reposted to
+     */
+    std::vector<ObUpdate> requote(matching::Engine& engine);
+
+private:
+    struct Level {
+        SIDE side;
+        float price;
+        float target_quantity;
+        float resting_quantity;
+    };
+
+    // An order placed for a level and its unfilled quantity
+    struct RestingOrder {
+        size_t level;
+        float quantity;
+    };
+
+    std::string ticker;
+    std::vector<Level> levels;
+    // Keyed by order_index
+    std::unordered_map<long long, RestingOrder> resting_orders;
+
+    static bool crosses_book(const matching::Engine& engine, SIDE side, float price);
+};
+
+} // namespace liquidity
+} // namespace nutc
@@ -12,23 +12,72 @@ Manager::get_engine(const std::string& ticker)
     return std::nullopt;
 }
 
-void
-Manager::add_initial_liquidity(const std::string& ticker, float quantity, float price)
+std::vector<ObUpdate>
+Manager::add_liquidity_ladder(
+    const liquidity::LadderConfig& config, bool requote_on_fill
+)
 {
-    MarketOrder to_add{"SIMULATED", messages::SIDE::SELL, ticker, quantity,
-                       price};
-    auto it = engines.find(ticker);
-    if (it != engines.end()) {
-        it->second.add_order_without_matching(to_add);
+    auto it = engines.find(config.ticker);
+    if (it == engines.end()) {
+        return {};
+    }
+
+    liquidity::MarketMaker market_maker{config};
+    std::vector<ObUpdate> updates = market_maker.seed(it->second);
+    if (requote_on_fill) {
+        market_makers.insert_or_assign(config.ticker, std::move(market_maker));
     }
+    return updates;
+}
+
+std::vector<ObUpdate>
+Manager::requote_after_matches(
+    const std::string& ticker, const std::vector<Match>& matches
+)
+{
+    auto maker_it = market_makers.find(ticker);
+    auto engine_it = engines.find(ticker);
+    if (maker_it == market_makers.end() || engine_it == engines.end()) {
+        return {};
+    }
+
+    for (const auto& match : matches) {
+        maker_it->second.on_match(match);
+    }
+    return maker_it->second.requote(engine_it->second);
 }
 
 void
-Manager::add_engine(const std::string& ticker)
+Manager::add_engine(const std::string& ticker, matching::MatchingMode mode)
 {
     if (engines.find(ticker) == engines.end()) {
-        engines.emplace(ticker, matching::Engine());
+        engines.emplace(ticker, matching::Engine(mode));
+    }
+}
+
+std::map<std::string, matching::MatchResult>
+Manager::clear_auctions(manager::ClientManager& clients)
+{
+    std::map<std::string, matching::MatchResult> results;
+    for (auto& [ticker, engine] : engines) {
+        if (engine.get_mode() != matching::MatchingMode::BATCH_AUCTION)
+            continue;
+        matching::MatchResult result = engine.clear_auction(clients);
+        if (!result.matches.empty() || !result.ob_updates.empty())
+            results.emplace(ticker, std::move(result));
+    }
+    return results;
+}
+
+std::vector<ObUpdate>
+Manager::snapshot() const
+{
+    std::vector<ObUpdate> updates;
+    for (const auto& [ticker, engine] : engines) {
+        std::vector<ObUpdate> book = engine.snapshot();
+        updates.insert(updates.end(), book.begin(), book.end());
     }
+    return updates;
 }
 
 } // namespace engine_manager
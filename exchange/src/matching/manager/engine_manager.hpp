@@ -1,8 +1,11 @@
 #pragma once
 #include "matching/engine/engine.hpp"
+#include "matching/liquidity/liquidity.hpp"
 
+#include <map>
 #include <optional>
 #include <string>
+#include <vector>
 
 using Engine = nutc::matching::Engine;
 using EngineRef = std::reference_wrapper<nutc::matching::Engine>;
@@ -30,17 +33,49 @@ public:
     /**
      * @brief Adds an engine with the given ticker
      * @param ticker The ticker of the engine to add
+     * @param mode How the engine matches incoming orders
      * @return A reference to the engine with the given ticker
      */
-    void add_engine(const std::string& ticker);
+    void add_engine(
+        const std::string& ticker,
+        matching::MatchingMode mode = matching::MatchingMode::CONTINUOUS
+    );
 
-    /** @brief Adds initial liquidity by creating fake sell orders for a given ticker at
-     * a given quantity/price
+    /**
+     * @brief Clears the auction of every batch auction engine
+     * @return Each ticker's auction result, for the tickers that traded or have new
+     * orders in their book
+     */
+    std::map<std::string, matching::MatchResult>
+    clear_auctions(manager::ClientManager& clients);
+
+    /**
+     * @brief Seeds both sides of a ticker's book with a multi-level SIMULATED ladder
+     * @param config The ladder to place; its ticker must already have an engine
+     * @param requote_on_fill Whether an internal market maker should repost the
+     * ladder's filled quantity after trades (see requote_after_matches)
+     * @return The orderbook updates for every order placed
+     */
+    std::vector<ObUpdate> add_liquidity_ladder(
+        const liquidity::LadderConfig& config, bool requote_on_fill
+    );
+
+    /**
+     * @brief Lets the ticker's market maker, if any, react to the given matches
+     * @return The orderbook updates for any orders the market maker reposted
+     */
+    std::vector<ObUpdate> requote_after_matches(
+        const std::string& ticker, const std::vector<Match>& matches
+    );
+
+    /**
+     * @brief Every engine's book, as updates that rebuild it from empty
      */
-    void add_initial_liquidity(const std::string& ticker, float quantity, float price);
+    std::vector<ObUpdate> snapshot() const;
 
 private:
     std::map<std::string, matching::Engine> engines;
+    std::map<std::string, liquidity::MarketMaker> market_makers;
 };
 } // namespace engine_manager
 } // namespace nutc
@@ -0,0 +1,177 @@
+#include "networking/firebase/algo_cache.hpp"
+
+#include "config.h"
+#include "logging.hpp"
+#include "networking/http/http_client.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <fstream>
+#include <sstream>
+
+namespace nutc {
+namespace firebase {
+
+AlgoCache::AlgoCache(std::filesystem::path directory) : directory(std::move(directory))
+{
+    std::error_code error;
+    std::filesystem::create_directories(this->directory, error);
+    if (error) {
+        log_e(
+            firebase_fetching, "Failed to create algo cache {}: {}",
+            this->directory.string(), error.message()
+        );
+    }
+}
+
+std::optional<std::filesystem::path>
+AlgoCache::path_for(const std::string& algo_id) const
+{
+    // Ids come from firebase; refuse anything that could escape the directory
+    auto valid_char = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+    };
+    if (algo_id.empty() || !std::all_of(algo_id.begin(), algo_id.end(), valid_char))
+        return std::nullopt;
+
+    return directory / (algo_id + ".py");
+}
+
+bool
+AlgoCache::contains(const std::string& algo_id) const
+{
+    auto path = path_for(algo_id);
+    return path.has_value() && std::filesystem::exists(path.value());
+}
+
+std::optional<std::string>
+AlgoCache::get(const std::string& algo_id) const
+{
+    auto path = path_for(algo_id);
+    if (!path.has_value())
+        return std::nullopt;
+
+    std::ifstream file(path.value(), std::ios::binary);
+    if (!file)
+        return std::nullopt;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+bool
+AlgoCache::put(const std::string& algo_id, const std::string& algo) const
+{
+    auto path = path_for(algo_id);
+    if (!path.has_value()) {
+        log_w(firebase_fetching, "Not caching algo with invalid id {}", algo_id);
+        return false;
+    }
+
+    std::filesystem::path tmp_path = path.value();
+    tmp_path += ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !(file << algo)) {
+            log_e(firebase_fetching, "Failed to write {}", tmp_path.string());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmp_path, path.value(), error);
+    if (error) {
+        log_e(
+            firebase_fetching, "Failed to cache algo {}: {}", algo_id, error.message()
+        );
+        std::filesystem::remove(tmp_path, error);
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::optional<std::string>>
+batch_download(const std::vector<std::string>& urls, size_t max_parallel)
+{
+    std::vector<std::optional<std::string>> results(urls.size());
+    http::Client& client = http::Client::instance();
+
+    // Transfers to the same host share connections, so only the number of requests
+    // handed to the client at once needs bounding
+    std::deque<std::pair<size_t, std::future<http::Response>>> in_flight;
+    auto collect_oldest = [&] {
+        auto& [index, future] = in_flight.front();
+        http::Response response = future.get();
+        if (response.ok()) {
+            results[index] = std::move(response.body);
+        }
+        else {
+            log_e(
+                firebase_fetching, "Failed to download {}: {} (status {})", urls[index],
+                response.error.value_or("bad status"), response.status
+            );
+        }
+        in_flight.pop_front();
+    };
+
+    for (size_t i = 0; i < urls.size(); i++) {
+        if (in_flight.size() >= std::max<size_t>(max_parallel, 1))
+            collect_oldest();
+        http::Request request{"GET", urls[i]};
+        request.timeout_secs = ALGO_DOWNLOAD_TIMEOUT_SECS;
+        in_flight.emplace_back(i, client.perform_async(std::move(request)));
+    }
+    while (!in_flight.empty())
+        collect_oldest();
+    return results;
+}
+
+std::map<std::string, std::string>
+prefetch_latest_algos(const glz::json_t::object_t& users, const AlgoCache& cache)
+{
+    std::map<std::string, std::string> cached_ids;
+    std::vector<std::string> uids;
+    std::vector<std::string> algo_ids;
+    std::vector<std::string> urls;
+
+    for (const auto& [uid, user_json] : users) {
+        glz::json_t user = user_json;
+        if (!user.contains("latestAlgoId") || !user.contains("algos"))
+            continue;
+
+        std::string algo_id = user["latestAlgoId"].get<std::string>();
+        if (cache.contains(algo_id)) {
+            cached_ids.emplace(uid, algo_id);
+            continue;
+        }
+        if (!user["algos"].contains(algo_id))
+            continue;
+
+        glz::json_t algo_info = user["algos"][algo_id];
+        if (!algo_info.contains("downloadURL"))
+            continue;
+
+        uids.push_back(uid);
+        algo_ids.push_back(algo_id);
+        urls.push_back(algo_info["downloadURL"].get<std::string>());
+    }
+
+    log_i(
+        firebase_fetching, "Downloading {} algos, {} already cached", urls.size(),
+        cached_ids.size()
+    );
+
+    auto algos = batch_download(urls, ALGO_DOWNLOAD_PARALLELISM);
+    for (size_t i = 0; i < algos.size(); i++) {
+        if (algos[i].has_value() && cache.put(algo_ids[i], algos[i].value()))
+            cached_ids.emplace(uids[i], algo_ids[i]);
+    }
+    return cached_ids;
+}
+
+} // namespace firebase
+} // namespace nutc
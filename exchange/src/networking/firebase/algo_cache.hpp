@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glaze/glaze.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nutc {
+namespace firebase {
+
+/**
+ * @class AlgoCache
+ * @brief On-disk cache of algorithm files, keyed by their firebase algo id
+ *
+ * Algo ids are never reused for a new upload, so a cached file never goes stale and
+ * restarts can skip downloading it. NUTC-client reads the same directory
+ */
+class AlgoCache {
+public:
+    explicit AlgoCache(std::filesystem::path directory);
+
+    std::optional<std::string> get(const std::string& algo_id) const;
+
+    /**
+     * @brief Stores an algo; written to a temporary file and renamed into place so
+     * concurrent readers never see a partial file
+     */
+    bool put(const std::string& algo_id, const std::string& algo) const;
+
+    bool contains(const std::string& algo_id) const;
+
+private:
+    std::filesystem::path directory;
+
+    std::optional<std::filesystem::path> path_for(const std::string& algo_id) const;
+};
+
+/**
+ * @brief Downloads every url concurrently through the process's HTTP client
+ * @param max_parallel Upper bound on the number of simultaneous transfers
+ * @return The body of each url in the same order, or nullopt if it failed
+ */
+std::vector<std::optional<std::string>>
+batch_download(const std::vector<std::string>& urls, size_t max_parallel);
+
+/**
+ * @brief Makes sure the latest algo of every user is in the cache
+ *
+ * Only algos missing from the cache are downloaded, all in one batch
+ *
+ * @param users The users object from firebase, as returned by get_all_users
+ * @return The id of every user's latest algo that is now in the cache, by uid
+ */
+std::map<std::string, std::string>
+prefetch_latest_algos(const glz::json_t::object_t& users, const AlgoCache& cache);
+
+} // namespace firebase
+} // namespace nutc
@@ -1,61 +1,27 @@
 #include "networking/firebase/firebase.hpp"
 
 #include "logging.hpp"
+#include "networking/http/http_client.hpp"
 
 namespace nutc {
 namespace firebase {
 
-static size_t
-write_callback(void* contents, size_t size, size_t nmemb, void* userp)
-{
-    auto* str = reinterpret_cast<std::string*>(userp);
-    auto* data = static_cast<char*>(contents);
-
-    str->append(data, size * nmemb);
-    return size * nmemb;
-}
-
 glz::json_t
 firebase_request(
     const std::string& method, const std::string& url, const std::string& data
 )
 {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if (curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-
-        if (method == "POST") {
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-        }
-        else if (method == "PUT") {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-        }
-        else if (method == "DELETE") {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-        }
-
-        res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            log_e(
-                firebase_fetching, "curl_easy_perform() failed: {}",
-                curl_easy_strerror(res)
-            );
-        }
-
-        curl_easy_cleanup(curl);
+    http::Response response = http::Client::instance().perform({method, url, data});
+    if (response.error.has_value()) {
+        log_e(
+            firebase_fetching, "Request to {} failed: {}", url, response.error.value()
+        );
     }
 
     glz::json_t json{};
-    auto error = glz::read_json(json, readBuffer);
+    auto error = glz::read_json(json, response.body);
     if (error) {
-        std::string descriptive_error = glz::format_error(error, readBuffer);
+        std::string descriptive_error = glz::format_error(error, response.body);
         log_e(firebase_fetching, "glz::read_json() failed: {}", descriptive_error);
     }
     return json;
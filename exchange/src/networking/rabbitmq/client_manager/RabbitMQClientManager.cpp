@@ -1,10 +1,14 @@
 #include "RabbitMQClientManager.hpp"
 
 #include "client_manager/client_manager.hpp"
+#include "client_manager/readiness.hpp"
+#include "config.h"
 #include "logging.hpp"
 #include "networking/rabbitmq/consumer/RabbitMQConsumer.hpp"
 #include "networking/rabbitmq/publisher/RabbitMQPublisher.hpp"
 
+#include <algorithm>
+
 namespace nutc {
 namespace rabbitmq {
 
@@ -13,7 +17,10 @@ RabbitMQClientManager::waitForClients(
     manager::ClientManager& clients, const int num_clients
 )
 {
-    int num_running = 0;
+    manager::ReadinessTracker readiness(
+        static_cast<size_t>(std::max(num_clients, 0)), CLIENT_READY_QUORUM,
+        std::chrono::seconds(CLIENT_READY_DEADLINE_SECS)
+    );
 
     auto processMessage = [&](const auto& message) {
         using T = std::decay_t<decltype(message)>;
@@ -23,7 +30,8 @@ RabbitMQClientManager::waitForClients(
             );
             return false;
         }
-        else if constexpr (std::is_same_v<T, messages::MarketOrder>) {
+        else if constexpr (std::is_same_v<T, messages::MarketOrder>
+                           || std::is_same_v<T, messages::MarketOrderBatch>) {
             log_i(
                 rabbitmq,
                 "Received market order before initialization complete. Ignoring..."
@@ -36,40 +44,45 @@ RabbitMQClientManager::waitForClients(
             );
             if (message.ready) {
                 clients.set_active(message.client_uid);
-                num_running++;
             }
+            readiness.record(message.client_uid, message.ready);
         }
         return true; // indicate that function should continue
     };
 
-    for (int i = 0; i < num_clients; i++) {
-        auto data = RabbitMQConsumer::consumeMessage();
-        if (!std::visit(processMessage, data)) {
+    while (!readiness.should_start()) {
+        auto data = RabbitMQConsumer::consumeMessageFor(readiness.time_left());
+        if (data.has_value() && !std::visit(processMessage, data.value())) {
             return;
         }
     }
 
     log_i(
-        rabbitmq, "All {} clients ready. Starting exchange with {} ready clients",
-        num_clients, num_running
+        rabbitmq, "Starting exchange with {} of {} clients ready ({} answered)",
+        readiness.num_ready(), readiness.num_expected(), readiness.num_answered()
     );
 }
 
-void
-RabbitMQClientManager::sendStartTime(
-    const manager::ClientManager& manager, int wait_seconds
-)
+std::string
+RabbitMQClientManager::startTimeMessage(std::chrono::milliseconds wait)
 {
-    std::vector<manager::Client> active_clients = manager.get_clients(true);
     using time_point = std::chrono::high_resolution_clock::time_point;
-    time_point time =
-        std::chrono::high_resolution_clock::now() + std::chrono::seconds(wait_seconds);
+    time_point time = std::chrono::high_resolution_clock::now() + wait;
     long long time_ns = std::chrono::time_point_cast<std::chrono::nanoseconds>(time)
                             .time_since_epoch()
                             .count();
 
     messages::StartTime message{time_ns};
-    std::string buf = glz::write_json(message);
+    return glz::write_json(message);
+}
+
+void
+RabbitMQClientManager::sendStartTime(
+    const manager::ClientManager& manager, std::chrono::milliseconds wait
+)
+{
+    std::vector<manager::Client> active_clients = manager.get_clients(true);
+    std::string buf = startTimeMessage(wait);
     auto send_to_client = [buf](const manager::Client& client) {
         RabbitMQPublisher::publishMessage(client.uid, buf);
     };
@@ -79,5 +92,32 @@ RabbitMQClientManager::sendStartTime(
     }
 }
 
+void
+RabbitMQClientManager::admitLateClient(
+    manager::ClientManager& manager, engine_manager::Manager& engine_manager,
+    const messages::InitMessage& message
+)
+{
+    log_w(
+        rabbitmq, "Received init message from client {} after start with status {}",
+        message.client_uid, message.ready ? "ready" : "not ready"
+    );
+    if (!message.ready) {
+        return;
+    }
+
+    manager.set_active(message.client_uid);
+    RabbitMQPublisher::publishMessage(
+        message.client_uid, startTimeMessage(std::chrono::milliseconds(0))
+    );
+
+    // The client missed every update so far, so it starts from the current books
+    for (const auto& update : engine_manager.snapshot()) {
+        std::string buffer;
+        glz::write<glz::opts{}>(update, buffer);
+        RabbitMQPublisher::publishMessage(message.client_uid, buffer);
+    }
+}
+
 } // namespace rabbitmq
 } // namespace nutc
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "client_manager/client_manager.hpp"
+#include "matching/manager/engine_manager.hpp"
+#include "utils/messages.hpp"
+
+#include <chrono>
+#include <string>
 
 namespace nutc {
 namespace rabbitmq {
@@ -9,14 +14,30 @@ namespace rabbitmq {
 class RabbitMQClientManager {
 public:
     /**
-     * @brief On startup, waits for all clients to send an initialization message
+     * @brief On startup, waits for clients to send an initialization message
      *
-     * This ensures that all clients are connected to the exchange and have successfully
-     * started (vs a RMQ or firebase error)
+     * Returns once CLIENT_READY_QUORUM of the clients are ready, all of them have
+     * answered, or CLIENT_READY_DEADLINE_SECS have passed. The rest are admitted with
+     * admitLateClient when they initialize
      */
     static void waitForClients(manager::ClientManager& manager, int num_clients);
 
-    static void sendStartTime(const manager::ClientManager& manager, int wait_seconds);
+    static void sendStartTime(
+        const manager::ClientManager& manager, std::chrono::milliseconds wait
+    );
+
+    /**
+     * @brief Lets a client that initializes after the exchange started (e.g. one the
+     * supervisor restarted, or one that missed the readiness deadline) join
+     * immediately, sending it a snapshot of every book
+     */
+    static void admitLateClient(
+        manager::ClientManager& manager, engine_manager::Manager& engine_manager,
+        const messages::InitMessage& message
+    );
+
+private:
+    static std::string startTimeMessage(std::chrono::milliseconds wait);
 };
 } // namespace rabbitmq
 } // namespace nutc
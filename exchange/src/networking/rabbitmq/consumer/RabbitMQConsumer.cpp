@@ -1,53 +1,151 @@
 #include "RabbitMQConsumer.hpp"
 
+#include "config.h"
+#include "networking/rabbitmq/client_manager/RabbitMQClientManager.hpp"
 #include "networking/rabbitmq/connection_manager/RabbitMQConnectionManager.hpp"
 #include "networking/rabbitmq/order_handler/RabbitMQOrderHandler.hpp"
+#include "utils/realtime/realtime.hpp"
+
+#include <poll.h>
+
+#include <algorithm>
 
 namespace nutc {
 namespace rabbitmq {
 
 void
 RabbitMQConsumer::handleIncomingMessages(
-    manager::ClientManager& clients, engine_manager::Manager& engine_manager
+    manager::ClientManager& clients, engine_manager::Manager& engine_manager,
+    std::chrono::milliseconds auction_interval
 )
 {
     bool keepRunning = true;
 
+    if (auction_interval.count() <= 0) {
+        while (keepRunning) {
+            handleMessage(clients, engine_manager, consumeMessage());
+        }
+        return;
+    }
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point next_auction = clock::now() + auction_interval;
     while (keepRunning) {
-        auto incoming_message = consumeMessage();
-
-        // Use std::visit to deal with the variant
-        std::visit(
-            [&](auto&& arg) {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, messages::InitMessage>) {
-                    log_e(rabbitmq, "Not expecting initialization message");
-                    exit(1);
-                }
-                else if constexpr (std::is_same_v<T, messages::RMQError>) {
-                    log_e(rabbitmq, "Received RMQError: {}", arg.message);
-                }
-                else if constexpr (std::is_same_v<T, messages::MarketOrder>) {
-                    RabbitMQOrderHandler::handleIncomingMarketOrder(
-                        engine_manager, clients, arg
-                    );
-                }
-            },
-            incoming_message
+        clock::time_point now = clock::now();
+        if (now >= next_auction) {
+            RabbitMQOrderHandler::clearAuctions(engine_manager, clients);
+            // A slow auction delays the next one rather than causing a burst of them
+            next_auction = std::max(next_auction + auction_interval, now);
+            continue;
+        }
+
+        auto incoming_message = consumeMessageFor(
+            std::chrono::ceil<std::chrono::milliseconds>(next_auction - now)
         );
+        if (incoming_message.has_value())
+            handleMessage(clients, engine_manager, std::move(incoming_message.value()));
+    }
+}
+
+void
+RabbitMQConsumer::handleMessage(
+    manager::ClientManager& clients, engine_manager::Manager& engine_manager,
+    std::variant<
+        messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+        messages::RMQError>
+        incoming_message
+)
+{
+    // Use std::visit to deal with the variant
+    std::visit(
+        [&](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, messages::InitMessage>) {
+                RabbitMQClientManager::admitLateClient(clients, engine_manager, arg);
+            }
+            else if constexpr (std::is_same_v<T, messages::RMQError>) {
+                log_e(rabbitmq, "Received RMQError: {}", arg.message);
+            }
+            else if constexpr (std::is_same_v<T, messages::MarketOrder>) {
+                RabbitMQOrderHandler::handleIncomingMarketOrder(
+                    engine_manager, clients, arg
+                );
+            }
+            else if constexpr (std::is_same_v<T, messages::MarketOrderBatch>) {
+                RabbitMQOrderHandler::handleIncomingMarketOrderBatch(
+                    engine_manager, clients, arg
+                );
+            }
+        },
+        incoming_message
+    );
+}
+
+void
+RabbitMQConsumer::enableBusyPoll()
+{
+    const auto& connection_state =
+        RabbitMQConnectionManager::getInstance().get_connection_state();
+    int sockfd = amqp_socket_get_sockfd(amqp_get_socket(connection_state));
+    realtime::enable_socket_busy_poll(sockfd, SOCKET_BUSY_POLL_USECS);
+    busy_poll = true;
+}
+
+bool
+RabbitMQConsumer::spinUntilReadable(
+    amqp_connection_state_t connection_state,
+    std::optional<std::chrono::steady_clock::time_point> deadline
+)
+{
+    // Only the wait is spun; the read itself stays blocking so a message whose frames
+    // arrive separately is never abandoned halfway through
+    pollfd socket{amqp_socket_get_sockfd(amqp_get_socket(connection_state)), POLLIN, 0};
+    while (!amqp_frames_enqueued(connection_state)
+           && !amqp_data_in_buffer(connection_state)) {
+        if (poll(&socket, 1, 0) != 0)
+            return true;
+        if (deadline.has_value() && std::chrono::steady_clock::now() >= deadline)
+            return false;
     }
+    return true;
 }
 
 std::optional<std::string>
-RabbitMQConsumer::consumeMessageAsString()
+RabbitMQConsumer::consumeMessageAsString(timeval* timeout, bool& timed_out)
 {
     const auto& connection_state =
         RabbitMQConnectionManager::getInstance().get_connection_state();
 
     amqp_envelope_t envelope;
     amqp_maybe_release_buffers(connection_state);
-    amqp_rpc_reply_t res = amqp_consume_message(connection_state, &envelope, NULL, 0);
+    if (busy_poll && timeout == nullptr) {
+        spinUntilReadable(connection_state, std::nullopt);
+    }
+    else if (busy_poll) {
+        // Spins through the timeout too, then leaves what remains of it for the read
+        auto wait = std::chrono::seconds(timeout->tv_sec)
+                    + std::chrono::microseconds(timeout->tv_usec);
+        auto deadline = std::chrono::steady_clock::now() + wait;
+        if (!spinUntilReadable(connection_state, deadline)) {
+            timed_out = true;
+            return std::nullopt;
+        }
+        auto remaining = std::max(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - std::chrono::steady_clock::now()
+            ),
+            std::chrono::microseconds(0)
+        );
+        timeout->tv_sec = static_cast<time_t>(remaining.count() / 1000000);
+        timeout->tv_usec = static_cast<suseconds_t>(remaining.count() % 1000000);
+    }
+    amqp_rpc_reply_t res =
+        amqp_consume_message(connection_state, &envelope, timeout, 0);
 
+    timed_out = res.reply_type == AMQP_RESPONSE_LIBRARY_EXCEPTION
+                && res.library_error == AMQP_STATUS_TIMEOUT;
+    if (timed_out)
+        return std::nullopt;
     if (res.reply_type != AMQP_RESPONSE_NORMAL) {
         log_e(rabbitmq, "Failed to consume message.");
         return std::nullopt;
@@ -60,15 +158,19 @@ RabbitMQConsumer::consumeMessageAsString()
     return message;
 }
 
-std::variant<messages::InitMessage, messages::MarketOrder, messages::RMQError>
-RabbitMQConsumer::consumeMessage()
+static std::variant<
+    messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+    messages::RMQError>
+parse_message(const std::optional<std::string>& buf)
 {
-    std::optional<std::string> buf = consumeMessageAsString();
     if (!buf.has_value()) {
         return messages::RMQError{"Failed to consume message."};
     }
 
-    std::variant<messages::InitMessage, messages::MarketOrder, messages::RMQError> data;
+    std::variant<
+        messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+        messages::RMQError>
+        data;
     auto err = glz::read_json(data, buf.value());
     if (err) {
         return messages::RMQError{glz::format_error(err, buf.value())};
@@ -76,5 +178,32 @@ RabbitMQConsumer::consumeMessage()
     return data;
 }
 
+std::variant<
+    messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+    messages::RMQError>
+RabbitMQConsumer::consumeMessage()
+{
+    bool timed_out = false;
+    return parse_message(consumeMessageAsString(nullptr, timed_out));
+}
+
+std::optional<std::variant<
+    messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+    messages::RMQError>>
+RabbitMQConsumer::consumeMessageFor(std::chrono::milliseconds timeout)
+{
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+    timeval wait{
+        static_cast<time_t>(micros.count() / 1000000),
+        static_cast<suseconds_t>(micros.count() % 1000000)
+    };
+    bool timed_out = false;
+    std::optional<std::string> buf = consumeMessageAsString(&wait, timed_out);
+    if (timed_out) {
+        return std::nullopt;
+    }
+    return parse_message(buf);
+}
+
 } // namespace rabbitmq
 } // namespace nutc
@@ -5,6 +5,9 @@
 #include "logging.hpp"
 #include "utils/messages.hpp"
 
+#include <sys/time.h>
+
+#include <chrono>
 #include <optional>
 #include <string>
 
@@ -16,21 +19,64 @@ namespace rabbitmq {
 class RabbitMQConsumer {
 public:
     static std::variant<
-        messages::InitMessage, messages::MarketOrder, messages::RMQError>
+        messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+        messages::RMQError>
     consumeMessage();
 
+    /**
+     * @brief Like consumeMessage, but gives up once timeout passes
+     * @return nullopt if no message arrived in time
+     */
+    static std::optional<std::variant<
+        messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+        messages::RMQError>>
+    consumeMessageFor(std::chrono::milliseconds timeout);
+
     /**
      * @brief Main event loop, handles incoming messages from exchange
      *
      * Handles incoming orderbook updates, trade updates, account updates, and shutdown
      * messages from the exchange
+     * @param auction_interval How often to clear the batch auction engines' auctions,
+     * or zero if every engine matches continuously
      */
     static void handleIncomingMessages(
-        manager::ClientManager& clients, engine_manager::Manager& engine_manager
+        manager::ClientManager& clients, engine_manager::Manager& engine_manager,
+        std::chrono::milliseconds auction_interval = std::chrono::milliseconds(0)
     );
 
+    /**
+     * @brief Spin on the socket instead of blocking until a message arrives
+     *
+     * Trades a fully utilized core for not paying the wakeup latency on every message.
+     * Waits with a timeout, as between batch auctions, spin until it passes
+     */
+    static void enableBusyPoll();
+
 private:
-    static std::optional<std::string> consumeMessageAsString();
+    inline static bool busy_poll = false;
+
+    static void handleMessage(
+        manager::ClientManager& clients, engine_manager::Manager& engine_manager,
+        std::variant<
+            messages::InitMessage, messages::MarketOrder, messages::MarketOrderBatch,
+            messages::RMQError>
+            incoming_message
+    );
+
+    /**
+     * @param timeout How long to wait for a message, or nullptr to wait forever
+     * @param timed_out Set if nullopt was returned because nothing arrived in time
+     */
+    static std::optional<std::string>
+    consumeMessageAsString(timeval* timeout, bool& timed_out);
+    /**
+     * @return False if the deadline passed first
+     */
+    static bool spinUntilReadable(
+        amqp_connection_state_t connection_state,
+        std::optional<std::chrono::steady_clock::time_point> deadline
+    );
 };
 
 } // namespace rabbitmq
@@ -5,6 +5,17 @@
 namespace nutc {
 namespace rabbitmq {
 
+void
+RabbitMQOrderHandler::handleIncomingMarketOrderBatch(
+    engine_manager::Manager& engine_manager, manager::ClientManager& clients,
+    messages::MarketOrderBatch& batch
+)
+{
+    log_i(rabbitmq, "Received batch of {} market orders", batch.orders.size());
+    for (auto& order : batch.orders)
+        handleIncomingMarketOrder(engine_manager, clients, order);
+}
+
 void
 RabbitMQOrderHandler::handleIncomingMarketOrder(
     engine_manager::Manager& engine_manager, manager::ClientManager& clients,
@@ -25,16 +36,59 @@ RabbitMQOrderHandler::handleIncomingMarketOrder(
     }
 
     log_i(rabbitmq, "Received market order: {}", buffer);
+    if (!clients.has_client(order.client_uid)) [[unlikely]] {
+        rejectOrder(order, messages::RejectReason::UNKNOWN_CLIENT);
+        return;
+    }
+    if (!clients.consume_order_token(order.client_uid)) {
+        rejectOrder(order, messages::RejectReason::RATE_LIMITED);
+        return;
+    }
+
     std::optional<std::reference_wrapper<Engine>> engine =
         engine_manager.get_engine(order.ticker);
     if (!engine.has_value()) {
-        log_w(
-            matching, "Received order for unknown ticker {}. Discarding order",
-            order.ticker
-        );
+        rejectOrder(order, messages::RejectReason::UNKNOWN_TICKER);
         return;
     }
-    auto [matches, ob_updates] = engine.value().get().match_order(order, clients);
+    std::optional<messages::RejectReason> invalid =
+        engine.value().get().validate_order(order, clients);
+    if (invalid.has_value()) {
+        rejectOrder(order, invalid.value());
+        return;
+    }
+
+    matching::MatchResult result =
+        engine.value().get().match_validated_order(order, clients);
+    float filled_quantity = 0;
+    for (const auto& match : result.matches)
+        filled_quantity += match.quantity;
+    RabbitMQPublisher::publishOrderAck(order, filled_quantity);
+
+    broadcastMatchResult(engine_manager, clients, order.ticker, result);
+}
+
+void
+RabbitMQOrderHandler::clearAuctions(
+    engine_manager::Manager& engine_manager, manager::ClientManager& clients
+)
+{
+    for (const auto& [ticker, result] : engine_manager.clear_auctions(clients)) {
+        log_i(
+            matching, "Auction for ticker {} cleared with {} matches", ticker,
+            result.matches.size()
+        );
+        broadcastMatchResult(engine_manager, clients, ticker, result);
+    }
+}
+
+void
+RabbitMQOrderHandler::broadcastMatchResult(
+    engine_manager::Manager& engine_manager, manager::ClientManager& clients,
+    const std::string& ticker, const matching::MatchResult& result
+)
+{
+    const auto& [matches, ob_updates] = result;
     for (const auto& match : matches) {
         std::string buyer_uid = match.buyer_uid;
         std::string seller_uid = match.seller_uid;
@@ -55,21 +109,50 @@ RabbitMQOrderHandler::handleIncomingMarketOrder(
         RabbitMQPublisher::broadcastMatches(clients, matches);
     }
     if (ob_updates.size() > 0) {
-        RabbitMQPublisher::broadcastObUpdates(clients, ob_updates, order.client_uid);
+        RabbitMQPublisher::broadcastObUpdates(clients, ob_updates);
     }
+    if (matches.size() > 0) {
+        std::vector<messages::ObUpdate> requotes =
+            engine_manager.requote_after_matches(ticker, matches);
+        if (requotes.size() > 0) {
+            RabbitMQPublisher::broadcastObUpdates(clients, requotes);
+        }
+    }
+}
+
+void
+RabbitMQOrderHandler::rejectOrder(
+    const messages::MarketOrder& order, messages::RejectReason reason
+)
+{
+    uint64_t count = ++rejection_counts[static_cast<size_t>(reason)];
+    log_w(
+        matching, "Rejected order from {} with reason {} ({} so far)", order.client_uid,
+        messages::reject_reason_to_string(reason), count
+    );
+    RabbitMQPublisher::publishOrderReject(order, reason);
 }
 
 void
-RabbitMQOrderHandler::addLiquidityToTicker(
-    manager::ClientManager& clients, engine_manager::Manager& engine_manager, const std::string& ticker, float quantity,
-    float price
+RabbitMQOrderHandler::addLiquidityLadder(
+    manager::ClientManager& clients, engine_manager::Manager& engine_manager,
+    const liquidity::LadderConfig& config, bool requote_on_fill
 )
 {
-    engine_manager.add_initial_liquidity(ticker, quantity, price);
-    messages::ObUpdate update{ticker, messages::SIDE::SELL, price, quantity};
-    std::vector<messages::ObUpdate> vec{};
-    vec.push_back(update);
-  RabbitMQPublisher::broadcastObUpdates(clients, vec, "");
+    std::vector<messages::ObUpdate> updates =
+        engine_manager.add_liquidity_ladder(config, requote_on_fill);
+    if (updates.empty()) {
+        log_w(
+            matching, "No liquidity added for ticker {}; is there an engine for it?",
+            config.ticker
+        );
+        return;
+    }
+    log_i(
+        matching, "Seeded ticker {} with {} simulated levels", config.ticker,
+        updates.size()
+    );
+    RabbitMQPublisher::broadcastObUpdates(clients, updates);
 }
 
 } // namespace rabbitmq
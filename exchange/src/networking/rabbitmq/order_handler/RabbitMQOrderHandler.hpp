@@ -4,20 +4,54 @@
 #include "matching/manager/engine_manager.hpp"
 #include "utils/messages.hpp"
 
+#include <array>
+#include <cstdint>
 #include <string>
 
 namespace nutc {
 namespace rabbitmq {
 class RabbitMQOrderHandler {
 public:
-    static void addLiquidityToTicker(
+    /**
+     * @brief Seeds a ticker with a SIMULATED ladder and broadcasts the new levels
+     * @param requote_on_fill Whether to keep the ladder topped up after fills
+     */
+    static void addLiquidityLadder(
         manager::ClientManager& clients, engine_manager::Manager& engine_manager,
-        const std::string& ticker, float quantity, float price
+        const liquidity::LadderConfig& config, bool requote_on_fill
     );
     static void handleIncomingMarketOrder(
         engine_manager::Manager& engine_manager, manager::ClientManager& clients,
         messages::MarketOrder& order
     );
+
+    // Handles each order of the batch in turn, as if they had arrived separately
+    static void handleIncomingMarketOrderBatch(
+        engine_manager::Manager& engine_manager, manager::ClientManager& clients,
+        messages::MarketOrderBatch& batch
+    );
+
+    /**
+     * @brief Runs the auction of every batch auction ticker and broadcasts the results
+     *
+     * Orders for those tickers are only acked as they arrive; their fills, and their
+     * place in the book, are sent once the auction they were queued for clears
+     */
+    static void clearAuctions(
+        engine_manager::Manager& engine_manager, manager::ClientManager& clients
+    );
+
+private:
+    inline static std::array<uint64_t, messages::NUM_REJECT_REASONS> rejection_counts{};
+
+    static void
+    rejectOrder(const messages::MarketOrder& order, messages::RejectReason reason);
+
+    // Sends the matches and book updates, then whatever the market maker requotes
+    static void broadcastMatchResult(
+        engine_manager::Manager& engine_manager, manager::ClientManager& clients,
+        const std::string& ticker, const matching::MatchResult& result
+    );
 };
 
 } // namespace rabbitmq
@@ -2,6 +2,7 @@
 #include "networking/rabbitmq/connection_manager/RabbitMQConnectionManager.hpp"
 
 #include "logging.hpp"
+#include "utils/logger/logger.hpp"
 
 namespace nutc {
 namespace rabbitmq {
@@ -55,13 +56,10 @@ RabbitMQPublisher::broadcastMatches(
 void
 RabbitMQPublisher::broadcastObUpdates(
     const manager::ClientManager& clients,
-    const std::vector<messages::ObUpdate>& updates, const std::string& ignore_uid
+    const std::vector<messages::ObUpdate>& updates
 )
 {
     auto broadcastToClient = [&](const auto& client) {
-        if (client.uid == ignore_uid) {
-            return;
-        }
         for (const auto& update : updates) {
             // if (update.quantity <= 1e-6f) {
             // continue;
@@ -96,8 +94,42 @@ RabbitMQPublisher::broadcastAccountUpdate(
     std::string seller_buffer;
     glz::write<glz::opts{}>(buyer_update, buyer_buffer);
     glz::write<glz::opts{}>(seller_update, seller_buffer);
-    publishMessage(buyer_uid, buyer_buffer);
-    publishMessage(seller_uid, seller_buffer);
+    // SIMULATED orders have no client listening for account updates
+    if (buyer_uid != "SIMULATED")
+        publishMessage(buyer_uid, buyer_buffer);
+    if (seller_uid != "SIMULATED")
+        publishMessage(seller_uid, seller_buffer);
+}
+
+void
+RabbitMQPublisher::publishOrderAck(
+    const messages::MarketOrder& order, float filled_quantity
+)
+{
+    messages::OrderAck ack{
+        filled_quantity, order.ticker, order.side, order.price, order.quantity
+    };
+
+    std::string buffer;
+    glz::write<glz::opts{}>(ack, buffer);
+    publishMessage(order.client_uid, buffer);
+}
+
+void
+RabbitMQPublisher::publishOrderReject(
+    const messages::MarketOrder& order, messages::RejectReason reason
+)
+{
+    messages::OrderReject reject{
+        reason, order.ticker, order.side, order.price, order.quantity
+    };
+
+    std::string buffer;
+    glz::write<glz::opts{}>(reject, buffer);
+    events::Logger::get_logger().log_event(
+        events::MESSAGE_TYPE::ORDER_REJECT, buffer, order.client_uid
+    );
+    publishMessage(order.client_uid, buffer);
 }
 
 } // namespace rabbitmq
@@ -17,14 +17,22 @@ public:
         const std::vector<messages::Match>& matches
     );
 
-    // ignore uid because we shouldn't send ob update to user who placed order
+    // sent to every client, the one that placed the order included, so that each
+    // book holds the same level totals
     static void broadcastObUpdates(
         const manager::ClientManager& clients,
-        const std::vector<messages::ObUpdate>& updates, const std::string& ignore_uid
+        const std::vector<messages::ObUpdate>& updates
     );
     static void broadcastAccountUpdate(
         const manager::ClientManager& clients, const messages::Match& match
     );
+
+    // sent only to the client that placed the order
+    static void
+    publishOrderAck(const messages::MarketOrder& order, float filled_quantity);
+    static void publishOrderReject(
+        const messages::MarketOrder& order, messages::RejectReason reason
+    );
 };
 
 } // namespace rabbitmq
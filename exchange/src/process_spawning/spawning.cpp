@@ -1,9 +1,13 @@
 #include "process_spawning/spawning.hpp"
 
 #include "config.h"
+#include "networking/firebase/algo_cache.hpp"
+#include "process_spawning/supervisor.hpp"
 #include "utils/dev_mode/dev_mode.hpp"
 #include "logging.hpp"
 
+#include <algorithm>
+
 namespace nutc {
 namespace client {
 
@@ -20,9 +24,15 @@ initialize(manager::ClientManager& users, bool development_mode)
         glz::json_t::object_t firebase_users = nutc::client::get_all_users();
         users.initialize_from_firebase(firebase_users);
 
+        // Clients are told their algo id so they read the cache without asking
+        // firebase for it
+        firebase::AlgoCache cache{ALGO_CACHE_DIR};
+        std::map<std::string, std::string> algo_ids =
+            firebase::prefetch_latest_algos(firebase_users, cache);
+
         // Spawn clients
         const int num_clients =
-            nutc::client::spawn_all_clients(users, development_mode);
+            nutc::client::spawn_all_clients(users, development_mode, algo_ids);
 
         if (num_clients == 0) {
             log_c(client_spawning, "Spawned 0 clients");
@@ -40,44 +50,89 @@ get_all_users()
     return res.get<glz::json_t::object_t>();
 }
 
+// Ids starting with a dash would be parsed as flags, so the client swaps spaces back
+static std::string
+quote_argument(std::string arg)
+{
+    std::replace(arg.begin(), arg.end(), '-', ' ');
+    return arg;
+}
+
 int
-spawn_all_clients(const nutc::manager::ClientManager& users, bool development_mode)
+spawn_all_clients(
+    const nutc::manager::ClientManager& users, bool development_mode,
+    const std::map<std::string, std::string>& algo_ids
+)
 {
     int clients = 0;
+    std::vector<std::string> quoted_uids;
+    std::vector<std::string> quoted_algo_ids;
     for (const auto& client : users.get_clients(false)) {
-      const std::string uid = client.uid;
-        log_i(client_spawning, "Spawning client: {}", uid);
-        std::string quote_uid = std::string(uid);
-        std::replace(quote_uid.begin(), quote_uid.end(), '-', ' ');
-        spawn_client(quote_uid, development_mode);
+        const std::string uid = client.uid;
+        auto algo_id = algo_ids.find(uid);
+        std::string quoted_algo_id =
+            algo_id == algo_ids.end() ? "" : quote_argument(algo_id->second);
+        if (SPAWN_WITH_FORK_SERVER) {
+            quoted_uids.push_back(quote_argument(uid));
+            quoted_algo_ids.push_back(quoted_algo_id);
+        }
+        else {
+            log_i(client_spawning, "Spawning client: {}", uid);
+            spawn_client(quote_argument(uid), development_mode, quoted_algo_id);
+        }
         clients++;
     };
+
+    if (!quoted_uids.empty()) {
+        log_i(client_spawning, "Spawning fork server for {} clients", clients);
+        spawn_fork_server(quoted_uids, development_mode, quoted_algo_ids);
+    }
     return clients;
 }
 
 void
-spawn_client(const std::string& uid, bool development_mode)
+spawn_fork_server(
+    const std::vector<std::string>& uids, bool development_mode,
+    const std::vector<std::string>& algo_ids
+)
 {
-    pid_t pid = fork();
-    if (pid == 0) {
-        std::vector<std::string> args = {"NUTC-client", "--uid", uid};
-        if (development_mode) {
-            args.push_back("--dev");
-        }
-
-        std::vector<char*> c_args;
-        for (auto& arg : args)
-            c_args.push_back(arg.data());
-        c_args.push_back(nullptr);
-
-        execvp(c_args[0], c_args.data());
-
-        log_e(client_spawning, "Failed to execute NUTC-client");
+    std::vector<std::string> args = {"NUTC-client"};
+    if (development_mode) {
+        args.push_back("--dev");
+    }
+    args.push_back("--fork-server");
+    args.insert(args.end(), uids.begin(), uids.end());
+    if (!development_mode) {
+        args.push_back("--algo-ids");
+        args.insert(args.end(), algo_ids.begin(), algo_ids.end());
+    }
+    // The fork server reaps, reports and restarts its own children, since they are
+    // not children of the exchange
+    args.push_back("--max-restarts");
+    args.push_back(std::to_string(CLIENT_MAX_RESTARTS));
 
+    // Restarting the fork server would start a second copy of every client that
+    // survived, so it is not restarted itself
+    if (!Supervisor::get_instance().spawn("fork server", args, false)) {
         exit(1);
     }
-    else if (pid < 0) {
-        log_e(client_spawning, "Failed to fork");
+}
+
+void
+spawn_client(
+    const std::string& uid, bool development_mode, const std::string& algo_id
+)
+{
+    std::vector<std::string> args = {"NUTC-client", "--uid", uid};
+    if (development_mode) {
+        args.push_back("--dev");
+    }
+    if (!algo_id.empty()) {
+        args.push_back("--algo-id");
+        args.push_back(algo_id);
+    }
+
+    if (!Supervisor::get_instance().spawn(uid, args, true)) {
         exit(1);
     }
 }
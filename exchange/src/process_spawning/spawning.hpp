@@ -8,6 +8,10 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace nutc {
 
 /** @brief Contains all functions related to spawning client processes */
@@ -17,8 +21,21 @@ namespace client {
  * @brief Spawns a client process with the given uid
  * Forks and execve's a client process with the given uid
  * Spawns in the binary "NUTC-client", expecting it to be in the $PATH
+ * @param algo_id The id of the client's cached algo, or empty if it isn't cached
+ */
+void spawn_client(
+    const std::string& uid, bool development_mode, const std::string& algo_id = ""
+);
+
+/**
+ * @brief Spawns a single NUTC-client fork server that runs a client for every uid
+ * The fork server downloads all algos in parallel and forks one child per uid
+ * @param algo_ids The id of each uid's cached algo, or empty if it isn't cached
  */
-void spawn_client(const std::string& uid, bool development_mode);
+void spawn_fork_server(
+    const std::vector<std::string>& uids, bool development_mode,
+    const std::vector<std::string>& algo_ids
+);
 
 /**
  * @brief Fetches all users from firebase
@@ -28,9 +45,14 @@ glz::json_t::object_t get_all_users();
 /**
  * @brief Spawns all clients in the given ClientManager
  * @param users The ClientManager to spawn clients for
+ * @param algo_ids The id of each client's cached algo, by uid, so clients can read
+ * it from the cache without looking it up in firebase
  * @returns the number of clients spawned
  */
-int spawn_all_clients(const nutc::manager::ClientManager& users, bool development_mode);
+int spawn_all_clients(
+    const nutc::manager::ClientManager& users, bool development_mode,
+    const std::map<std::string, std::string>& algo_ids = {}
+);
 
 int initialize(manager::ClientManager& users, bool development_mode);
 
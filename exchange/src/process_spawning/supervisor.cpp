@@ -0,0 +1,188 @@
+#include "process_spawning/supervisor.hpp"
+
+#include "config.h"
+#include "logging.hpp"
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+
+namespace nutc {
+namespace client {
+
+Supervisor::Supervisor(ResourceLimits limits, int max_restarts) :
+    limits(std::move(limits)), max_restarts(max_restarts),
+    reaper([this] { reap_children(); })
+{}
+
+Supervisor::~Supervisor()
+{
+    running = false;
+    if (reaper.joinable())
+        reaper.join();
+}
+
+Supervisor&
+Supervisor::get_instance()
+{
+    static Supervisor instance{
+        ResourceLimits{
+            CLIENT_CPU_LIMIT_SECS, rlim_t{CLIENT_MEMORY_LIMIT_MB} * 1024 * 1024,
+            CLIENT_NICENESS, cpus_excluding_first(EXCHANGE_RESERVED_CPUS)
+        },
+        CLIENT_MAX_RESTARTS
+    };
+    return instance;
+}
+
+std::vector<int>
+Supervisor::cpus_excluding_first(int reserved)
+{
+    int num_cpus = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    int first = num_cpus > reserved ? reserved : 0;
+
+    std::vector<int> cpus;
+    for (int cpu = first; cpu < num_cpus; cpu++)
+        cpus.push_back(cpu);
+    return cpus;
+}
+
+pid_t
+Supervisor::launch(const std::vector<std::string>& args) const
+{
+    // Everything the child needs is prepared before forking; only async-signal-safe
+    // calls are made between fork and exec since the reaper thread is running
+    std::vector<std::string> args_copy = args;
+    std::vector<char*> c_args;
+    for (auto& arg : args_copy)
+        c_args.push_back(arg.data());
+    c_args.push_back(nullptr);
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : limits.cpus)
+        CPU_SET(cpu, &cpu_set);
+
+    pid_t pid = fork();
+    if (pid != 0)
+        return pid;
+
+    if (limits.cpu_seconds > 0) {
+        rlimit cpu_limit{limits.cpu_seconds, limits.cpu_seconds + 1};
+        setrlimit(RLIMIT_CPU, &cpu_limit);
+    }
+    if (limits.memory_bytes > 0) {
+        rlimit memory_limit{limits.memory_bytes, limits.memory_bytes};
+        setrlimit(RLIMIT_DATA, &memory_limit);
+    }
+    if (limits.niceness > 0)
+        setpriority(PRIO_PROCESS, 0, limits.niceness);
+    if (!limits.cpus.empty())
+        sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+
+    execvp(c_args[0], c_args.data());
+    _exit(127);
+}
+
+bool
+Supervisor::spawn(
+    const std::string& name, const std::vector<std::string>& args,
+    bool restart_on_failure
+)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pid_t pid = launch(args);
+    if (pid < 0) {
+        log_e(client_spawning, "Failed to fork {}", name);
+        return false;
+    }
+
+    children[pid] = Child{name, args, restart_on_failure, 0};
+    return true;
+}
+
+void
+Supervisor::reap_children()
+{
+    while (running) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, WNOHANG);
+        if (pid <= 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = children.find(pid);
+        if (it == children.end())
+            continue;
+
+        Child child = std::move(it->second);
+        children.erase(it);
+
+        bool signaled = WIFSIGNALED(status);
+        int code = signaled ? WTERMSIG(status) : WEXITSTATUS(status);
+        exits.push_back(ExitReport{child.name, pid, signaled, code});
+        if (exits.size() > MAX_EXIT_REPORTS)
+            exits.pop_front();
+
+        if (signaled) {
+            log_w(
+                client_spawning, "Client {} (pid {}) was killed by signal {}",
+                child.name, pid, code
+            );
+        }
+        else if (code != 0) {
+            log_w(
+                client_spawning, "Client {} (pid {}) exited with code {}", child.name,
+                pid, code
+            );
+        }
+        else {
+            log_i(client_spawning, "Client {} (pid {}) exited", child.name, pid);
+        }
+
+        bool failed = signaled || code != 0;
+        if (!failed || !child.restart_on_failure || child.restarts >= max_restarts)
+            continue;
+
+        child.restarts++;
+        pid_t new_pid = launch(child.args);
+        if (new_pid < 0) {
+            log_e(client_spawning, "Failed to restart client {}", child.name);
+            continue;
+        }
+        log_i(
+            client_spawning, "Restarted client {} as pid {} (restart {} of {})",
+            child.name, new_pid, child.restarts, max_restarts
+        );
+        children[new_pid] = std::move(child);
+    }
+}
+
+size_t
+Supervisor::num_running() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return children.size();
+}
+
+std::vector<ExitReport>
+Supervisor::get_exits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return {exits.begin(), exits.end()};
+}
+
+void
+Supervisor::signal_all(int signal) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [pid, _] : children)
+        kill(pid, signal);
+}
+
+} // namespace client
+} // namespace nutc
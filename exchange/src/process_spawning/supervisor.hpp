@@ -0,0 +1,108 @@
+#pragma once
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nutc {
+namespace client {
+
+struct ResourceLimits {
+    // Total CPU time before the kernel kills the process; 0 is unlimited
+    rlim_t cpu_seconds = 0;
+    // Maximum heap size; 0 is unlimited
+    rlim_t memory_bytes = 0;
+    // Added to the niceness of children so they yield to the exchange
+    int niceness = 0;
+    // CPUs children may run on; empty allows any
+    std::vector<int> cpus;
+};
+
+struct ExitReport {
+    std::string name;
+    pid_t pid;
+    // If true, code is the signal that killed the process
+    bool signaled;
+    int code;
+};
+
+/**
+ * @class Supervisor
+ * @brief Spawns client processes under resource limits and reaps them
+ *
+ * A background thread reaps exited children, logs how they exited and restarts
+ * those that failed, up to a limit. Limits and CPU affinity are applied in the child
+ * before exec, so they are inherited by anything the client forks (e.g. the fork
+ * server's per-user processes)
+ */
+class Supervisor {
+public:
+    Supervisor(ResourceLimits limits, int max_restarts);
+    ~Supervisor();
+
+    Supervisor(const Supervisor&) = delete;
+    Supervisor& operator=(const Supervisor&) = delete;
+    Supervisor(Supervisor&&) = delete;
+    Supervisor& operator=(Supervisor&&) = delete;
+
+    static Supervisor& get_instance();
+
+    /**
+     * @brief Forks and execs args[0], searching $PATH
+     * @param name Used when reporting the process
+     * @param restart_on_failure Whether to relaunch the process if it crashes
+     * @return false if the process could not be forked
+     */
+    bool spawn(
+        const std::string& name, const std::vector<std::string>& args,
+        bool restart_on_failure
+    );
+
+    size_t num_running() const;
+
+    // The most recent exits, oldest first
+    std::vector<ExitReport> get_exits() const;
+
+    // Sends a signal to every running child
+    void signal_all(int signal) const;
+
+    /**
+     * @brief All CPUs on this machine except the first `reserved`
+     * Returns every CPU if there aren't enough to reserve any
+     */
+    static std::vector<int> cpus_excluding_first(int reserved);
+
+private:
+    struct Child {
+        std::string name;
+        std::vector<std::string> args;
+        bool restart_on_failure;
+        int restarts;
+    };
+
+    static constexpr size_t MAX_EXIT_REPORTS = 1024;
+
+    ResourceLimits limits;
+    int max_restarts;
+
+    mutable std::mutex mutex;
+    std::map<pid_t, Child> children;
+    std::deque<ExitReport> exits;
+
+    std::atomic<bool> running{true};
+    std::thread reaper;
+
+    pid_t launch(const std::vector<std::string>& args) const;
+    void reap_children();
+};
+
+} // namespace client
+} // namespace nutc
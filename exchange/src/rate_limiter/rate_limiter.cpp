@@ -0,0 +1,30 @@
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+
+namespace nutc {
+namespace rate_limiter {
+
+TokenBucket::TokenBucket(double burst, double refill_per_sec) :
+    burst(burst), refill_per_sec(refill_per_sec), tokens(burst),
+    last_refill(clock::now())
+{}
+
+bool
+TokenBucket::try_consume(clock::time_point now)
+{
+    if (now > last_refill) {
+        std::chrono::duration<double> elapsed = now - last_refill;
+        tokens = std::min(burst, tokens + elapsed.count() * refill_per_sec);
+        last_refill = now;
+    }
+
+    if (tokens < 1.0)
+        return false;
+
+    tokens -= 1.0;
+    return true;
+}
+
+} // namespace rate_limiter
+} // namespace nutc
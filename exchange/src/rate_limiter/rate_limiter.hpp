@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+
+namespace nutc {
+/**
+ * @brief Limits how often each client may submit orders to the exchange
+ */
+namespace rate_limiter {
+
+/**
+ * @class TokenBucket
+ * @brief Constant-space token bucket
+ *
+ * Holds up to `burst` tokens and regains `refill_per_sec` tokens every second.
+ * Each accepted call spends one token, so a client may send `burst` orders at once
+ * and `refill_per_sec` orders per second on average after that
+ */
+class TokenBucket {
+public:
+    using clock = std::chrono::steady_clock;
+
+    TokenBucket(double burst, double refill_per_sec);
+
+    /**
+     * @brief Spends a token if one is available
+     * @return false if the caller should be rate limited
+     */
+    bool try_consume(clock::time_point now = clock::now());
+
+private:
+    double burst;
+    double refill_per_sec;
+    double tokens;
+    clock::time_point last_refill;
+};
+
+} // namespace rate_limiter
+} // namespace nutc
@@ -6,11 +6,29 @@ void
 initialize_client_manager(manager::ClientManager& users, int num_users)
 {
     for (int i = 0; i < num_users; i++) {
-        std::string uid = "algo_" + std::to_string(i);
+        std::string uid = CLIENT_UID_PREFIX + std::to_string(i);
         users.add_client(uid);
     }
 }
 
+void
+initialize_load_test_clients(
+    manager::ClientManager& users, int num_users,
+    const std::vector<std::string>& tickers
+)
+{
+    for (int i = 0; i < num_users; i++) {
+        std::string uid = CLIENT_UID_PREFIX + std::to_string(i);
+        users.add_client(uid, LOAD_TEST_CAPITAL);
+        users.set_order_rate_limit(
+            uid, LOAD_TEST_ORDER_RATE_LIMIT_BURST, LOAD_TEST_ORDER_RATE_LIMIT_PER_SEC
+        );
+        for (const auto& ticker : tickers) {
+            users.modify_holdings(uid, ticker, LOAD_TEST_HOLDINGS);
+        }
+    }
+}
+
 bool
 file_exists(const std::string& filename) noexcept
 {
@@ -48,7 +66,8 @@ create_algo_files(int num_users) noexcept
     }
 
     for (int i = 0; i < num_users; i++) {
-        std::string file_name = dir_name + "/algo_" + std::to_string(i) + ".py";
+        std::string file_name =
+            dir_name + "/" + CLIENT_UID_PREFIX + std::to_string(i) + ".py";
 
         if (file_exists(file_name)) {
             continue;
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 namespace nutc {
 namespace dev_mode {
@@ -16,5 +17,15 @@ bool file_exists(const std::string& path) noexcept;
 std::string read_file(const std::string& path);
 void create_algo_files(int num_users) noexcept;
 void initialize_client_manager(manager::ClientManager& users, int num_users);
+
+/**
+ * @brief Registers the clients driven by an external load generator
+ * They are named like dev mode clients, and each gets enough capital and holdings
+ * that orders are never rejected
+ */
+void initialize_load_test_clients(
+    manager::ClientManager& users, int num_users,
+    const std::vector<std::string>& tickers
+);
 } // namespace dev_mode
 } // namespace nutc
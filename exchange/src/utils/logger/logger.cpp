@@ -41,7 +41,7 @@ Logger::log_event(
     output_file_ << "\"message\": " << json_message;                // add message
 
     if (uid.has_value()) {
-        output_file_ << ", \"uid\": " << uid.value(); // add uid if exists
+        output_file_ << ", \"uid\": \"" << uid.value() << "\""; // add uid if exists
     }
 
     output_file_ << " }\n"; // close the brace and end the line
@@ -14,7 +14,8 @@ namespace events {
 enum class MESSAGE_TYPE { // needs to be changed to something better, but I will leave
                           // this here for now
     MARKET_ORDER,
-    MATCH
+    MATCH,
+    ORDER_REJECT
 };
 
 class Logger {
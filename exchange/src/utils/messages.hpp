@@ -4,6 +4,8 @@
 #include <glaze/glaze.hpp>
 
 #include <iostream>
+#include <optional>
+#include <vector>
 
 namespace nutc {
 
@@ -15,6 +17,28 @@ namespace messages {
 
 enum class SIDE { BUY, SELL };
 
+enum class OrderType {
+    LIMIT,
+    // Takes whatever the book offers, at any price; its price is ignored
+    MARKET,
+    // A limit order that is rejected instead of trading on arrival, so it only adds
+    // liquidity
+    POST_ONLY
+};
+
+/**
+ * @brief How long an order's unfilled quantity stays in the book
+ * Market orders never rest, whatever their time in force
+ */
+enum class TimeInForce {
+    // Good till cancelled: rests until it is filled
+    GTC,
+    // Immediate or cancel: fills what it can on arrival, and the rest is cancelled
+    IOC,
+    // Fill or kill: fills completely on arrival, or not at all
+    FOK
+};
+
 /**
  * @brief Sent by the exchange to initiate client shutdowns
  */
@@ -52,6 +76,9 @@ struct Match {
     SIDE side;
     float price;
     float quantity;
+    // The order_index of the orders that traded; not sent to clients
+    long long buy_order_index = -1;
+    long long sell_order_index = -1;
 };
 
 inline constexpr bool
@@ -71,6 +98,8 @@ struct MarketOrder {
     std::string ticker;
     float quantity;
     float price;
+    OrderType type = OrderType::LIMIT;
+    TimeInForce time_in_force = TimeInForce::GTC;
 
     // Used to sort orders by time created
     long long order_index;
@@ -86,14 +115,23 @@ struct MarketOrder {
 
     MarketOrder(
         const std::string& client_uid, SIDE side, const std::string& ticker,
-        float quantity, float price
+        float quantity, float price, OrderType type = OrderType::LIMIT,
+        TimeInForce time_in_force = TimeInForce::GTC
     ) :
         client_uid(client_uid),
-        side(side), ticker(ticker), quantity(quantity), price(price)
+        side(side), ticker(ticker), quantity(quantity), price(price), type(type),
+        time_in_force(time_in_force)
     {
         order_index = get_and_increment_global_index();
     }
 
+    // Whether any unfilled quantity is left in the book
+    bool
+    can_rest() const
+    {
+        return type != OrderType::MARKET && time_in_force == TimeInForce::GTC;
+    }
+
     // toString
     std::string
     to_string() const
@@ -151,6 +189,8 @@ struct MarketOrder {
         this->ticker = other.ticker;
         this->quantity = other.quantity;
         this->price = other.price;
+        this->type = other.type;
+        this->time_in_force = other.time_in_force;
     }
 
     MarketOrder&
@@ -166,6 +206,8 @@ struct MarketOrder {
         this->ticker = other.ticker;
         this->quantity = other.quantity;
         this->price = other.price;
+        this->type = other.type;
+        this->time_in_force = other.time_in_force;
 
         return *this;
     }
@@ -193,6 +235,104 @@ struct AccountUpdate {
     float quantity;
 };
 
+enum class RejectReason {
+    RATE_LIMITED,
+    UNKNOWN_TICKER,
+    INVALID_ORDER,
+    INSUFFICIENT_CAPITAL,
+    INSUFFICIENT_HOLDINGS,
+    // A post only order that would have traded on arrival
+    WOULD_CROSS,
+    // The order's client_uid is not a registered client
+    UNKNOWN_CLIENT
+};
+
+inline constexpr size_t NUM_REJECT_REASONS = 7;
+
+inline constexpr const char*
+reject_reason_to_string(RejectReason reason)
+{
+    switch (reason) {
+        case RejectReason::RATE_LIMITED:
+            return "RATE_LIMITED";
+        case RejectReason::UNKNOWN_TICKER:
+            return "UNKNOWN_TICKER";
+        case RejectReason::INVALID_ORDER:
+            return "INVALID_ORDER";
+        case RejectReason::INSUFFICIENT_CAPITAL:
+            return "INSUFFICIENT_CAPITAL";
+        case RejectReason::INSUFFICIENT_HOLDINGS:
+            return "INSUFFICIENT_HOLDINGS";
+        case RejectReason::WOULD_CROSS:
+            return "WOULD_CROSS";
+        case RejectReason::UNKNOWN_CLIENT:
+            return "UNKNOWN_CLIENT";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * @brief Sent by clients to place several orders with one message
+ * The exchange handles them one after another, in order, exactly as if they had been
+ * sent separately
+ */
+struct MarketOrderBatch {
+    std::vector<MarketOrder> orders;
+};
+
+/**
+ * @brief Sent by exchange to a client once its order has been accepted and matched
+ * Any unfilled quantity now rests in the orderbook, unless the order can't rest (see
+ * MarketOrder::can_rest), in which case it was cancelled
+ */
+struct OrderAck {
+    float filled_quantity;
+    std::string ticker;
+    SIDE side;
+    float price;
+    float quantity;
+};
+
+/**
+ * @brief Sent by exchange to a client whose order was not accepted
+ * Echoes the rejected order so the client can tell which one failed
+ */
+struct OrderReject {
+    RejectReason reason;
+    std::string ticker;
+    SIDE side;
+    float price;
+    float quantity;
+};
+
+/**
+ * @brief Sent by the backtester once a run is over
+ */
+struct BacktestResult {
+    int steps;
+    float starting_capital;
+    float capital;
+    // Capital plus holdings valued at the last traded price
+    float portfolio_value;
+    float pnl;
+    int orders_placed;
+    int orders_rejected;
+    int fills;
+};
+
+/**
+ * @brief Sent by the backtester to the strategy under test after every step
+ * The strategy answers each one with a MarketOrderBatch of the orders it placed
+ * while handling it. The last update carries the result and expects no answer
+ */
+struct BacktestUpdate {
+    std::vector<ObUpdate> ob_updates;
+    std::vector<Match> matches;
+    // Only for the strategy's own fills
+    std::vector<AccountUpdate> account_updates;
+    std::optional<BacktestResult> result;
+};
+
 } // namespace messages
 } // namespace nutc
 
@@ -246,10 +386,18 @@ struct glz::meta<nutc::messages::MarketOrder> {
     using T = nutc::messages::MarketOrder;
     static constexpr auto value = object(
         "client_uid", &T::client_uid, "side", &T::side, "ticker", &T::ticker,
-        "quantity", &T::quantity, "price", &T::price
+        "quantity", &T::quantity, "price", &T::price, "type", &T::type,
+        "time_in_force", &T::time_in_force
     );
 };
 
+/// \cond
+template <>
+struct glz::meta<nutc::messages::MarketOrderBatch> {
+    using T = nutc::messages::MarketOrderBatch;
+    static constexpr auto value = object("orders", &T::orders);
+};
+
 /// \cond
 template <>
 struct glz::meta<nutc::messages::InitMessage> {
@@ -257,3 +405,45 @@ struct glz::meta<nutc::messages::InitMessage> {
     static constexpr auto value =
         object("client_uid", &T::client_uid, "ready", &T::ready);
 };
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::OrderReject> {
+    using T = nutc::messages::OrderReject;
+    static constexpr auto value = object(
+        "reason", &T::reason, "ticker", &T::ticker, "side", &T::side, "price",
+        &T::price, "quantity", &T::quantity
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::OrderAck> {
+    using T = nutc::messages::OrderAck;
+    static constexpr auto value = object(
+        "filled_quantity", &T::filled_quantity, "ticker", &T::ticker, "side", &T::side,
+        "price", &T::price, "quantity", &T::quantity
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::BacktestResult> {
+    using T = nutc::messages::BacktestResult;
+    static constexpr auto value = object(
+        "steps", &T::steps, "starting_capital", &T::starting_capital, "capital",
+        &T::capital, "portfolio_value", &T::portfolio_value, "pnl", &T::pnl,
+        "orders_placed", &T::orders_placed, "orders_rejected", &T::orders_rejected,
+        "fills", &T::fills
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::BacktestUpdate> {
+    using T = nutc::messages::BacktestUpdate;
+    static constexpr auto value = object(
+        "ob_updates", &T::ob_updates, "matches", &T::matches, "account_updates",
+        &T::account_updates, "result", &T::result
+    );
+};
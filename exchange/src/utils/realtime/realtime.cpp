@@ -0,0 +1,68 @@
+#include "realtime.hpp"
+
+#include "logging.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace nutc {
+namespace realtime {
+
+bool
+pin_current_thread(int cpu)
+{
+    if (cpu < 0 || cpu >= sysconf(_SC_NPROCESSORS_ONLN)) {
+        log_w(main, "Cannot pin to cpu {}, it does not exist", cpu);
+        return false;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (err != 0) {
+        log_w(main, "Failed to pin thread to cpu {}: {}", cpu, std::strerror(err));
+        return false;
+    }
+    return true;
+}
+
+bool
+enable_fifo_scheduling(int priority)
+{
+    sched_param param{};
+    param.sched_priority = priority;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        log_w(main, "Failed to enable SCHED_FIFO: {}", std::strerror(err));
+        return false;
+    }
+
+    // Page faults are the next largest source of jitter once we're never preempted
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        log_w(main, "Failed to lock memory: {}", std::strerror(errno));
+    return true;
+}
+
+void
+enable_socket_busy_poll(int fd, int microseconds)
+{
+#ifdef SO_BUSY_POLL
+    if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &microseconds, sizeof(microseconds))
+        != 0) {
+        log_w(main, "Failed to enable socket busy polling: {}", std::strerror(errno));
+    }
+#else
+    (void)fd;
+    (void)microseconds;
+#endif
+}
+
+} // namespace realtime
+} // namespace nutc
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace nutc {
+
+/** @brief Tuning for running the exchange loop with low, consistent latency */
+namespace realtime {
+
+/**
+ * @brief Restricts the calling thread to a single cpu
+ * @returns false if the cpu doesn't exist or the call failed
+ */
+bool pin_current_thread(int cpu);
+
+/**
+ * @brief Runs the calling thread under SCHED_FIFO and locks the process's memory
+ * Requires CAP_SYS_NICE (and CAP_IPC_LOCK for the memory lock)
+ * @returns false if the scheduling policy couldn't be changed
+ */
+bool enable_fifo_scheduling(int priority);
+
+/**
+ * @brief Asks the kernel to busy poll the device queue when reading from fd
+ * Best effort; a no-op on kernels without SO_BUSY_POLL
+ */
+void enable_socket_busy_poll(int fd, int microseconds);
+
+} // namespace realtime
+} // namespace nutc
@@ -0,0 +1,77 @@
+#include "networking/firebase/algo_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+class AlgoCaching : public ::testing::Test {
+protected:
+    void
+    SetUp() override
+    {
+        root = fs::temp_directory_path()
+               / ("nutc_algo_cache_" + std::to_string(::testing::UnitTest::GetInstance()
+                                                          ->random_seed()));
+        fs::remove_all(root);
+        fs::create_directories(root / "server");
+    }
+
+    void
+    TearDown() override
+    {
+        fs::remove_all(root);
+    }
+
+    // Stands in for firebase storage: files served over file:// urls
+    std::string
+    serve_file(const std::string& name, const std::string& contents)
+    {
+        fs::path path = root / "server" / name;
+        std::ofstream(path) << contents;
+        return "file://" + path.string();
+    }
+
+    fs::path root;
+};
+
+TEST_F(AlgoCaching, PutThenGet)
+{
+    nutc::firebase::AlgoCache cache{root / "cache"};
+    EXPECT_FALSE(cache.contains("algo-1"));
+    EXPECT_FALSE(cache.get("algo-1").has_value());
+
+    EXPECT_TRUE(cache.put("algo-1", "print('hi')"));
+    EXPECT_TRUE(cache.contains("algo-1"));
+    EXPECT_EQ(cache.get("algo-1"), "print('hi')");
+
+    // Survives a restart
+    nutc::firebase::AlgoCache reopened{root / "cache"};
+    EXPECT_EQ(reopened.get("algo-1"), "print('hi')");
+}
+
+TEST_F(AlgoCaching, RejectsPathsOutsideCache)
+{
+    nutc::firebase::AlgoCache cache{root / "cache"};
+    EXPECT_FALSE(cache.contains("../server/a"));
+    EXPECT_FALSE(cache.get("../server/a").has_value());
+    EXPECT_FALSE(cache.get("").has_value());
+}
+
+TEST_F(AlgoCaching, BatchDownload)
+{
+    std::vector<std::string> urls;
+    for (int i = 0; i < 20; i++)
+        urls.push_back(serve_file(std::to_string(i) + ".py", "algo " + std::to_string(i)));
+
+    auto results = nutc::firebase::batch_download(urls, 4);
+    ASSERT_EQ(results.size(), 20);
+    for (int i = 0; i < 20; i++) {
+        ASSERT_TRUE(results[i].has_value());
+        EXPECT_EQ(results[i].value(), "algo " + std::to_string(i));
+    }
+
+    EXPECT_TRUE(nutc::firebase::batch_download({}, 4).empty());
+}
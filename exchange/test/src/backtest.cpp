@@ -0,0 +1,94 @@
+#include "backtest/backtest.hpp"
+#include "utils/messages.hpp"
+
+#include <gtest/gtest.h>
+
+using nutc::messages::SIDE::BUY;
+using nutc::messages::SIDE::SELL;
+
+class Backtest : public ::testing::Test {
+protected:
+    std::vector<nutc::backtest::TickerConfig> tickers{{"ETHUSD", 100}};
+    nutc::backtest::Backtest backtest{"ABC", tickers, 10000};
+};
+
+TEST_F(Backtest, StartSeedsLadder)
+{
+    auto update = backtest.start();
+    EXPECT_EQ(update.ob_updates.size(), 2 * LIQUIDITY_LEVELS);
+    EXPECT_TRUE(update.matches.empty());
+    EXPECT_FALSE(update.result.has_value());
+}
+
+TEST_F(Backtest, StrategyOrdersMatchAgainstLadder)
+{
+    backtest.start();
+
+    // Forged uids are replaced with the strategy's
+    MarketOrder buy{"DEF", BUY, "ETHUSD", 1, 1000};
+    auto update = backtest.step({buy}, {});
+
+    ASSERT_EQ(update.matches.size(), 1);
+    EXPECT_EQ(update.matches[0].buyer_uid, "ABC");
+    EXPECT_EQ(update.matches[0].price, 100 + LIQUIDITY_TICK_SIZE);
+    ASSERT_EQ(update.account_updates.size(), 1);
+    EXPECT_EQ(update.account_updates[0].side, BUY);
+    EXPECT_FLOAT_EQ(
+        update.account_updates[0].capital_remaining, 10000 - 100 - LIQUIDITY_TICK_SIZE
+    );
+
+    auto result = backtest.result();
+    EXPECT_EQ(result.steps, 1);
+    EXPECT_EQ(result.orders_placed, 1);
+    EXPECT_EQ(result.orders_rejected, 0);
+    EXPECT_EQ(result.fills, 1);
+    // Marked at the price just paid
+    EXPECT_FLOAT_EQ(result.pnl, 0);
+}
+
+TEST_F(Backtest, RejectsInvalidOrders)
+{
+    backtest.start();
+
+    MarketOrder too_expensive{"ABC", BUY, "ETHUSD", 1000, 1000};
+    MarketOrder unknown_ticker{"ABC", BUY, "BTCUSD", 1, 1};
+    MarketOrder no_holdings{"ABC", SELL, "ETHUSD", 1, 1};
+    auto update = backtest.step({too_expensive, unknown_ticker, no_holdings}, {});
+
+    EXPECT_TRUE(update.matches.empty());
+    EXPECT_EQ(backtest.result().orders_rejected, 3);
+}
+
+TEST_F(Backtest, BackgroundFlowMovesMarkPrice)
+{
+    backtest.start();
+    backtest.step({MarketOrder{"ABC", BUY, "ETHUSD", 1, 1000}}, {});
+
+    // The background trader sells into the strategy's resting bid
+    backtest.step({MarketOrder{"ABC", BUY, "ETHUSD", 1, 100}}, {});
+    auto update = backtest.step({}, {MarketOrder{"", SELL, "ETHUSD", 1, 100}});
+    ASSERT_EQ(update.matches.size(), 1);
+    EXPECT_EQ(update.matches[0].seller_uid, nutc::backtest::BACKGROUND_UID);
+
+    auto result = backtest.result();
+    EXPECT_EQ(result.fills, 2);
+    EXPECT_FLOAT_EQ(result.portfolio_value, result.capital + 2 * 100);
+}
+
+TEST(NoiseTrader, IsDeterministicForASeed)
+{
+    std::vector<nutc::backtest::TickerConfig> tickers{{"ETHUSD", 100}};
+    nutc::backtest::NoiseTrader first(tickers, 5, 2, 0.1f, 42);
+    nutc::backtest::NoiseTrader second(tickers, 5, 2, 0.1f, 42);
+
+    for (int step = 0; step < 10; step++) {
+        auto a = first.next_step();
+        auto b = second.next_step();
+        ASSERT_EQ(a.size(), 5);
+        for (size_t i = 0; i < a.size(); i++) {
+            EXPECT_EQ(a[i].price, b[i].price);
+            EXPECT_EQ(a[i].side, b[i].side);
+            EXPECT_GT(a[i].quantity, 0);
+        }
+    }
+}
@@ -133,10 +133,9 @@ TEST_F(BasicMatching, PartialFill)
 
     auto [matches2, ob_updates2] = engine.match_order(order2, manager);
     EXPECT_EQ(matches2.size(), 1);
-    EXPECT_EQ(ob_updates2.size(), 2);
+    EXPECT_EQ(ob_updates2.size(), 1);
     EXPECT_EQ_MATCH(matches2.at(0), "ETHUSD", "ABC", "DEF", SELL, 1, 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(1), "ETHUSD", BUY, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 1, 1);
 }
 
 TEST_F(BasicMatching, MultipleFill)
@@ -152,15 +151,14 @@ TEST_F(BasicMatching, MultipleFill)
     auto [matches2, ob_updates2] = engine.match_order(order2, manager);
     EXPECT_EQ(matches2.size(), 0);
     EXPECT_EQ(ob_updates2.size(), 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 1, 2);
 
     auto [matches3, ob_updates3] = engine.match_order(order3, manager);
     EXPECT_EQ(matches3.size(), 2);
-    EXPECT_EQ(ob_updates3.size(), 2);
+    EXPECT_EQ(ob_updates3.size(), 1);
     EXPECT_EQ_MATCH(matches3.at(0), "ETHUSD", "ABC", "DEF", SELL, 1, 1);
     EXPECT_EQ_MATCH(matches3.at(1), "ETHUSD", "ABC", "DEF", SELL, 1, 1);
     EXPECT_EQ_OB_UPDATE(ob_updates3.at(0), "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates3.at(1), "ETHUSD", BUY, 1, 0);
 }
 
 TEST_F(BasicMatching, MultiplePartialFill)
@@ -176,16 +174,15 @@ TEST_F(BasicMatching, MultiplePartialFill)
     auto [matches2, ob_updates2] = engine.match_order(order2, manager);
     EXPECT_EQ(matches2.size(), 0);
     EXPECT_EQ(ob_updates2.size(), 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 1, 2);
 
     auto [matches3, ob_updates3] = engine.match_order(order3, manager);
     EXPECT_EQ(matches3.size(), 2);
-    EXPECT_EQ(ob_updates3.size(), 3);
+    EXPECT_EQ(ob_updates3.size(), 2);
     EXPECT_EQ_MATCH(matches3.at(0), "ETHUSD", "ABC", "DEF", SELL, 1, 1);
     EXPECT_EQ_MATCH(matches3.at(1), "ETHUSD", "ABC", "DEF", SELL, 1, 1);
     EXPECT_EQ_OB_UPDATE(ob_updates3.at(0), "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates3.at(1), "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates3.at(2), "ETHUSD", SELL, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates3.at(1), "ETHUSD", SELL, 1, 1);
 }
 
 TEST_F(BasicMatching, SimpleMatchReversed)
@@ -230,10 +227,9 @@ TEST_F(BasicMatching, PartialFillReversed)
     EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", SELL, 1, 2);
     auto [matches2, ob_updates2] = engine.match_order(order2, manager);
     EXPECT_EQ(matches2.size(), 1);
-    EXPECT_EQ(ob_updates2.size(), 2);
+    EXPECT_EQ(ob_updates2.size(), 1);
     EXPECT_EQ_MATCH(matches2.at(0), "ETHUSD", "DEF", "ABC", BUY, 1, 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(1), "ETHUSD", SELL, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", SELL, 1, 1);
 }
 
 TEST_F(BasicMatching, MultipleFillReversed)
@@ -249,15 +245,14 @@ TEST_F(BasicMatching, MultipleFillReversed)
     auto [matches2, ob_updates2] = engine.match_order(order2, manager);
     EXPECT_EQ(matches2.size(), 0);
     EXPECT_EQ(ob_updates2.size(), 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", SELL, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", SELL, 1, 2);
 
     auto [matches3, ob_updates3] = engine.match_order(order3, manager);
     EXPECT_EQ(matches3.size(), 2);
-    EXPECT_EQ(ob_updates3.size(), 2);
+    EXPECT_EQ(ob_updates3.size(), 1);
     EXPECT_EQ_MATCH(matches3.at(0), "ETHUSD", "DEF", "ABC", BUY, 1, 1);
     EXPECT_EQ_MATCH(matches3.at(1), "ETHUSD", "DEF", "ABC", BUY, 1, 1);
     EXPECT_EQ_OB_UPDATE(ob_updates3.at(0), "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates3.at(1), "ETHUSD", SELL, 1, 0);
 }
 
 TEST_F(BasicMatching, MultiplePartialFillReversed)
@@ -273,14 +268,13 @@ TEST_F(BasicMatching, MultiplePartialFillReversed)
     auto [matches2, ob_updates2] = engine.match_order(order2, manager);
     EXPECT_EQ(matches2.size(), 0);
     EXPECT_EQ(ob_updates2.size(), 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", SELL, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", SELL, 1, 2);
 
     auto [matches3, ob_updates3] = engine.match_order(order3, manager);
     EXPECT_EQ(matches3.size(), 2);
-    EXPECT_EQ(ob_updates3.size(), 3);
+    EXPECT_EQ(ob_updates3.size(), 2);
     EXPECT_EQ_MATCH(matches3.at(0), "ETHUSD", "DEF", "ABC", BUY, 1, 1);
     EXPECT_EQ_MATCH(matches3.at(1), "ETHUSD", "DEF", "ABC", BUY, 1, 1);
     EXPECT_EQ_OB_UPDATE(ob_updates3.at(0), "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates3.at(1), "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(ob_updates3.at(2), "ETHUSD", BUY, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates3.at(1), "ETHUSD", BUY, 1, 1);
 }
@@ -0,0 +1,197 @@
+#include "client_manager/client_manager.hpp"
+#include "config.h"
+#include "matching/engine/engine.hpp"
+#include "matching/manager/engine_manager.hpp"
+#include "test_utils/macros.hpp"
+#include "utils/messages.hpp"
+
+#include <gtest/gtest.h>
+
+using nutc::matching::MatchingMode;
+using nutc::messages::SIDE::BUY;
+using nutc::messages::SIDE::SELL;
+
+class BatchAuction : public ::testing::Test {
+protected:
+    void
+    SetUp() override
+    {
+        manager.add_client("ABC");
+        manager.add_client("DEF");
+        manager.modify_holdings("ABC", "ETHUSD", 1000);
+        manager.modify_holdings("DEF", "ETHUSD", 1000);
+    }
+
+    ClientManager manager;
+    Engine engine{MatchingMode::BATCH_AUCTION};
+};
+
+TEST_F(BatchAuction, OrdersWaitForTheAuction)
+{
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 1};
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 1};
+
+    auto [matches1, ob_updates1] = engine.match_order(buy, manager);
+    auto [matches2, ob_updates2] = engine.match_order(sell, manager);
+    EXPECT_EQ(matches1.size(), 0);
+    EXPECT_EQ(ob_updates1.size(), 0);
+    EXPECT_EQ(matches2.size(), 0);
+    EXPECT_EQ(ob_updates2.size(), 0);
+    EXPECT_EQ(engine.num_pending(), 2);
+    EXPECT_TRUE(engine.bids.empty());
+    EXPECT_TRUE(engine.asks.empty());
+
+    auto [matches, ob_updates] = engine.clear_auction(manager);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", SELL, 1, 1);
+    EXPECT_EQ(ob_updates.size(), 0);
+    EXPECT_EQ(engine.num_pending(), 0);
+}
+
+TEST_F(BatchAuction, ClearsAtOneUniformPrice)
+{
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 2, 10};
+    MarketOrder sell1{"DEF", SELL, "ETHUSD", 1, 8};
+    MarketOrder sell2{"DEF", SELL, "ETHUSD", 1, 9};
+    engine.match_order(buy, manager);
+    engine.match_order(sell1, manager);
+    engine.match_order(sell2, manager);
+
+    // Every price from 9 to 10 trades both shares, so the auction takes the middle
+    auto [matches, ob_updates] = engine.clear_auction(manager);
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", SELL, 9.5, 1);
+    EXPECT_EQ_MATCH(matches.at(1), "ETHUSD", "ABC", "DEF", SELL, 9.5, 1);
+    EXPECT_EQ(ob_updates.size(), 0);
+    EXPECT_TRUE(engine.bids.empty());
+    EXPECT_TRUE(engine.asks.empty());
+
+    EXPECT_FLOAT_EQ(manager.get_capital("ABC"), STARTING_CAPITAL - 19);
+    EXPECT_FLOAT_EQ(manager.get_capital("DEF"), STARTING_CAPITAL + 19);
+    EXPECT_FLOAT_EQ(manager.get_holdings("ABC", "ETHUSD"), 1002);
+    EXPECT_FLOAT_EQ(manager.get_holdings("DEF", "ETHUSD"), 998);
+}
+
+TEST_F(BatchAuction, MaximizesVolume)
+{
+    MarketOrder buy1{"ABC", BUY, "ETHUSD", 1, 12};
+    MarketOrder buy2{"ABC", BUY, "ETHUSD", 3, 10};
+    MarketOrder sell1{"DEF", SELL, "ETHUSD", 2, 9};
+    MarketOrder sell2{"DEF", SELL, "ETHUSD", 2, 11};
+    engine.match_order(buy1, manager);
+    engine.match_order(buy2, manager);
+    engine.match_order(sell1, manager);
+    engine.match_order(sell2, manager);
+
+    auto [matches, ob_updates] = engine.clear_auction(manager);
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", SELL, 9.5, 1);
+    EXPECT_EQ_MATCH(matches.at(1), "ETHUSD", "ABC", "DEF", SELL, 9.5, 1);
+
+    // What was left of the bid at 10 and the whole ask at 11 now rest
+    ASSERT_EQ(ob_updates.size(), 2);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", BUY, 10, 2);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(1), "ETHUSD", SELL, 11, 2);
+    ASSERT_EQ(engine.bids.size(), 1);
+    ASSERT_EQ(engine.asks.size(), 1);
+    EXPECT_FALSE(engine.bids.top().can_match(engine.asks.top()));
+}
+
+TEST_F(BatchAuction, UncrossedOrdersRest)
+{
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 5};
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 6};
+    engine.match_order(buy, manager);
+    engine.match_order(sell, manager);
+
+    auto [matches, ob_updates] = engine.clear_auction(manager);
+    EXPECT_EQ(matches.size(), 0);
+    ASSERT_EQ(ob_updates.size(), 2);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", BUY, 5, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(1), "ETHUSD", SELL, 6, 1);
+    EXPECT_EQ(engine.bids.size(), 1);
+    EXPECT_EQ(engine.asks.size(), 1);
+
+    auto [matches2, ob_updates2] = engine.clear_auction(manager);
+    EXPECT_EQ(matches2.size(), 0);
+    EXPECT_EQ(ob_updates2.size(), 0);
+}
+
+TEST_F(BatchAuction, RestingOrdersTradeInLaterAuctions)
+{
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 2, 10};
+    engine.match_order(buy, manager);
+    engine.clear_auction(manager);
+
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    engine.match_order(sell, manager);
+    auto [matches, ob_updates] = engine.clear_auction(manager);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", SELL, 10, 1);
+    ASSERT_EQ(ob_updates.size(), 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", BUY, 10, 1);
+}
+
+TEST_F(BatchAuction, DropsOrdersThatCanNoLongerBeSettled)
+{
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 10};
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    engine.match_order(buy, manager);
+    engine.match_order(sell, manager);
+
+    // Spent elsewhere between placing the order and the auction
+    manager.modify_capital("ABC", -manager.get_capital("ABC"));
+
+    auto [matches, ob_updates] = engine.clear_auction(manager);
+    EXPECT_EQ(matches.size(), 0);
+    ASSERT_EQ(ob_updates.size(), 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", SELL, 10, 1);
+    EXPECT_TRUE(engine.bids.empty());
+    EXPECT_EQ(engine.asks.size(), 1);
+}
+
+TEST_F(BatchAuction, ManagerOnlyClearsAuctionEngines)
+{
+    nutc::engine_manager::Manager engine_manager;
+    engine_manager.add_engine("ETHUSD", MatchingMode::BATCH_AUCTION);
+    engine_manager.add_engine("BTCUSD");
+    manager.modify_holdings("DEF", "BTCUSD", 1000);
+
+    Engine& auction = engine_manager.get_engine("ETHUSD").value().get();
+    Engine& continuous = engine_manager.get_engine("BTCUSD").value().get();
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 10};
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    MarketOrder continuous_sell{"DEF", SELL, "BTCUSD", 1, 10};
+    auction.match_order(buy, manager);
+    auction.match_order(sell, manager);
+    continuous.match_order(continuous_sell, manager);
+
+    auto results = engine_manager.clear_auctions(manager);
+    ASSERT_EQ(results.size(), 1);
+    ASSERT_TRUE(results.contains("ETHUSD"));
+    EXPECT_EQ(results["ETHUSD"].matches.size(), 1);
+    EXPECT_EQ(continuous.asks.size(), 1);
+}
+
+TEST_F(BatchAuction, MarketMakerRequotesAfterAuctionFills)
+{
+    nutc::engine_manager::Manager engine_manager;
+    engine_manager.add_engine("ETHUSD", MatchingMode::BATCH_AUCTION);
+    engine_manager.add_liquidity_ladder({"ETHUSD", 100, 1, 2, 10}, true);
+
+    Engine& auction = engine_manager.get_engine("ETHUSD").value().get();
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 10, 101.5};
+    auction.match_order(buy, manager);
+
+    // Clears between the ask and the bid, so no fill is at the ladder's price
+    auto results = engine_manager.clear_auctions(manager);
+    const auto& matches = results["ETHUSD"].matches;
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "SIMULATED", BUY, 101.25, 10);
+    EXPECT_EQ(auction.level_quantity(SELL, 101), 0);
+
+    auto requotes = engine_manager.requote_after_matches("ETHUSD", matches);
+    ASSERT_EQ(requotes.size(), 1);
+    EXPECT_EQ_OB_UPDATE(requotes.at(0), "ETHUSD", SELL, 101, 10);
+    EXPECT_EQ(auction.level_quantity(SELL, 101), 10);
+}
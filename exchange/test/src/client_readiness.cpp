@@ -0,0 +1,75 @@
+#include "client_manager/readiness.hpp"
+
+#include <gtest/gtest.h>
+
+using nutc::manager::ReadinessTracker;
+using namespace std::chrono_literals;
+
+class ClientReadiness : public ::testing::Test {
+protected:
+    ReadinessTracker::clock::time_point start = ReadinessTracker::clock::now();
+};
+
+TEST_F(ClientReadiness, StartsWhenEveryoneIsReady)
+{
+    ReadinessTracker readiness{3, 1.0, 60s, start};
+    readiness.record("a", true);
+    readiness.record("b", true);
+    EXPECT_FALSE(readiness.should_start(start));
+
+    readiness.record("c", true);
+    EXPECT_TRUE(readiness.should_start(start));
+    EXPECT_EQ(readiness.num_ready(), 3);
+}
+
+TEST_F(ClientReadiness, StartsOnceEveryoneAnswered)
+{
+    ReadinessTracker readiness{2, 1.0, 60s, start};
+    readiness.record("a", true);
+    readiness.record("b", false);
+    EXPECT_TRUE(readiness.should_start(start));
+    EXPECT_EQ(readiness.num_ready(), 1);
+    EXPECT_EQ(readiness.num_answered(), 2);
+}
+
+TEST_F(ClientReadiness, StartsAtQuorum)
+{
+    ReadinessTracker readiness{10, 0.8, 60s, start};
+    for (int i = 0; i < 7; i++)
+        readiness.record(std::to_string(i), true);
+    EXPECT_FALSE(readiness.should_start(start));
+
+    readiness.record("7", true);
+    EXPECT_TRUE(readiness.should_start(start));
+}
+
+TEST_F(ClientReadiness, StartsAtDeadline)
+{
+    ReadinessTracker readiness{3, 1.0, 60s, start};
+    readiness.record("a", true);
+    EXPECT_FALSE(readiness.should_start(start + 59s));
+    EXPECT_EQ(readiness.time_left(start + 59s), 1s);
+
+    EXPECT_TRUE(readiness.should_start(start + 60s));
+    EXPECT_EQ(readiness.time_left(start + 61s), 0ms);
+}
+
+TEST_F(ClientReadiness, RepeatedInitCountsOnce)
+{
+    ReadinessTracker readiness{2, 1.0, 60s, start};
+    readiness.record("a", true);
+    readiness.record("a", true);
+    EXPECT_FALSE(readiness.should_start(start));
+
+    // A client that failed and was restarted counts as ready
+    readiness.record("b", false);
+    readiness.record("b", true);
+    EXPECT_EQ(readiness.num_ready(), 2);
+    EXPECT_EQ(readiness.num_answered(), 2);
+}
+
+TEST_F(ClientReadiness, NoClientsStartsImmediately)
+{
+    ReadinessTracker readiness{0, 1.0, 60s, start};
+    EXPECT_TRUE(readiness.should_start(start));
+}
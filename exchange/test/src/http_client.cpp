@@ -0,0 +1,221 @@
+#include "networking/http/http_client.hpp"
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nutc::http::Client;
+using nutc::http::Request;
+using nutc::http::Response;
+
+// Stands in for firebase: a keep-alive HTTP/1.1 server that echoes each request
+// line and body back
+class LocalServer {
+public:
+    LocalServer()
+    {
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd, 16);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+        acceptor = std::thread([this] { accept_connections(); });
+    }
+
+    ~LocalServer()
+    {
+        shutdown(listen_fd, SHUT_RDWR);
+        close(listen_fd);
+        acceptor.join();
+        for (int fd : connection_fds)
+            shutdown(fd, SHUT_RDWR);
+        for (auto& connection : connections)
+            connection.join();
+        for (int fd : connection_fds)
+            close(fd);
+    }
+
+    std::string
+    url(const std::string& path) const
+    {
+        return "http://127.0.0.1:" + std::to_string(port) + path;
+    }
+
+    std::atomic<int> accepted{0};
+
+private:
+    int listen_fd;
+    uint16_t port;
+    std::thread acceptor;
+    std::vector<int> connection_fds;
+    std::vector<std::thread> connections;
+
+    void
+    accept_connections()
+    {
+        while (true) {
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+            accepted++;
+            connection_fds.push_back(fd);
+            connections.emplace_back([fd] { serve(fd); });
+        }
+    }
+
+    static void
+    serve(int fd)
+    {
+        std::string buffer;
+        char chunk[4096];
+        while (true) {
+            size_t header_end = buffer.find("\r\n\r\n");
+            if (header_end == std::string::npos) {
+                ssize_t got = read(fd, chunk, sizeof(chunk));
+                if (got <= 0)
+                    break;
+                buffer.append(chunk, static_cast<size_t>(got));
+                continue;
+            }
+
+            size_t content_length = 0;
+            size_t length_pos = buffer.find("Content-Length: ");
+            if (length_pos != std::string::npos && length_pos < header_end)
+                content_length = std::stoul(buffer.substr(length_pos + 16));
+            size_t request_size = header_end + 4 + content_length;
+            if (buffer.size() < request_size) {
+                ssize_t got = read(fd, chunk, sizeof(chunk));
+                if (got <= 0)
+                    break;
+                buffer.append(chunk, static_cast<size_t>(got));
+                continue;
+            }
+
+            std::string body = buffer.substr(0, buffer.find(" HTTP/1.1")) + " "
+                               + buffer.substr(header_end + 4, content_length);
+            buffer.erase(0, request_size);
+            std::string response = "HTTP/1.1 200 OK\r\nContent-Length: "
+                                   + std::to_string(body.size()) + "\r\n\r\n" + body;
+            if (write(fd, response.data(), response.size()) < 0)
+                break;
+        }
+    }
+};
+
+TEST(HttpClient, PerformReturnsBody)
+{
+    LocalServer server;
+    Client client;
+
+    Response response = client.perform({"GET", server.url("/users.json")});
+    EXPECT_TRUE(response.ok());
+    EXPECT_EQ(response.status, 200);
+    EXPECT_EQ(response.body, "GET /users.json ");
+}
+
+TEST(HttpClient, SendsMethodAndBody)
+{
+    LocalServer server;
+    Client client;
+
+    Response put = client.perform({"PUT", server.url("/lint.json"), "\"success\""});
+    EXPECT_EQ(put.body, "PUT /lint.json \"success\"");
+
+    Response post = client.perform({"POST", server.url("/algos"), ""});
+    EXPECT_EQ(post.body, "POST /algos ");
+}
+
+TEST(HttpClient, ReusesConnections)
+{
+    LocalServer server;
+    Client client;
+
+    for (int i = 0; i < 5; i++) {
+        std::string path = "/" + std::to_string(i);
+        Response response = client.perform({"GET", server.url(path)});
+        EXPECT_EQ(response.body, "GET " + path + " ");
+    }
+    EXPECT_EQ(server.accepted, 1);
+}
+
+TEST(HttpClient, AsyncRequestsCompleteTheirFutures)
+{
+    LocalServer server;
+    Client client;
+
+    std::vector<std::future<Response>> responses;
+    for (int i = 0; i < 20; i++)
+        responses.push_back(
+            client.perform_async({"GET", server.url("/" + std::to_string(i))})
+        );
+
+    for (int i = 0; i < 20; i++) {
+        Response response = responses[i].get();
+        EXPECT_TRUE(response.ok());
+        EXPECT_EQ(response.body, "GET /" + std::to_string(i) + " ");
+    }
+
+    // The connections opened for the burst are kept for the next requests
+    int accepted = server.accepted;
+    client.perform_async({"GET", server.url("/again")}).get();
+    EXPECT_EQ(server.accepted, accepted);
+}
+
+TEST(HttpClient, StreamsBodyToCallback)
+{
+    LocalServer server;
+    Client client;
+
+    std::string received;
+    Request request{"PUT", server.url("/stream"), std::string(100000, 'x')};
+    request.on_data = [&](std::string_view data) {
+        received.append(data);
+        return true;
+    };
+    Response response = client.perform(request);
+    EXPECT_TRUE(response.ok());
+    EXPECT_TRUE(response.body.empty());
+    EXPECT_EQ(received.size(), 100000 + std::string("PUT /stream ").size());
+}
+
+TEST(HttpClient, CallbackCanAbort)
+{
+    LocalServer server;
+    Client client;
+
+    Request request{"GET", server.url("/abort")};
+    request.on_data = [](std::string_view) { return false; };
+    Response response = client.perform(request);
+    EXPECT_FALSE(response.ok());
+    EXPECT_TRUE(response.error.has_value());
+}
+
+TEST(HttpClient, ReportsConnectionFailures)
+{
+    std::string url;
+    {
+        LocalServer server;
+        url = server.url("/gone");
+    }
+    Client client;
+
+    Response response = client.perform({"GET", url});
+    EXPECT_FALSE(response.ok());
+    EXPECT_TRUE(response.error.has_value());
+
+    Response async_response = client.perform_async({"GET", url}).get();
+    EXPECT_FALSE(async_response.ok());
+}
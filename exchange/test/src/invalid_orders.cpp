@@ -57,13 +57,13 @@ TEST_F(InvalidOrders, RemoveThenAddFunds)
     auto [matches3, ob_updates3] = engine.match_order(order2, manager);
     EXPECT_EQ(matches3.size(), 0);
     EXPECT_EQ(ob_updates3.size(), 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates3[0], "ETHUSD", SELL, 1, 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates3[0], "ETHUSD", SELL, 1, 2);
 
     // Kept and matched
     auto [matches4, ob_updates4] = engine.match_order(order1, manager);
     EXPECT_EQ(matches4.size(), 1);
     EXPECT_EQ(ob_updates4.size(), 1);
-    EXPECT_EQ_OB_UPDATE(ob_updates4[0], "ETHUSD", SELL, 1, 0);
+    EXPECT_EQ_OB_UPDATE(ob_updates4[0], "ETHUSD", SELL, 1, 1);
     EXPECT_EQ_MATCH(matches4.at(0), "ETHUSD", "ABC", "DEF", BUY, 1, 1);
 }
 
@@ -119,12 +119,46 @@ TEST_F(InvalidOrders, SimpleManyInvalidOrder)
     // Should match two orders and throw out the invalid order (2)
     auto [matches4, updates4] = engine.match_order(order4, manager);
     EXPECT_EQ(matches4.size(), 2);
-    EXPECT_EQ(updates4.size(), 3);
+    EXPECT_EQ(updates4.size(), 2);
 
     EXPECT_EQ_MATCH(matches4[0], "ETHUSD", "A", "D", SELL, 1, 1);
     EXPECT_EQ_MATCH(matches4[1], "ETHUSD", "C", "D", SELL, 1, 1);
 
     EXPECT_EQ_OB_UPDATE(updates4[0], "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates4[1], "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates4[2], "ETHUSD", SELL, 1, 1);
+    EXPECT_EQ_OB_UPDATE(updates4[1], "ETHUSD", SELL, 1, 1);
+}
+
+TEST_F(InvalidOrders, RejectReasons)
+{
+    using nutc::messages::RejectReason;
+
+    MarketOrder valid{"ABC", BUY, "ETHUSD", 1, 1};
+    EXPECT_FALSE(engine.validate_order(valid, manager).has_value());
+
+    MarketOrder zero_quantity{"ABC", BUY, "ETHUSD", 0, 1};
+    EXPECT_EQ(
+        engine.validate_order(zero_quantity, manager), RejectReason::INVALID_ORDER
+    );
+
+    MarketOrder negative_price{"ABC", SELL, "ETHUSD", 1, -1};
+    EXPECT_EQ(
+        engine.validate_order(negative_price, manager), RejectReason::INVALID_ORDER
+    );
+
+    MarketOrder too_expensive{"ABC", BUY, "ETHUSD", 1, 1000000};
+    EXPECT_EQ(
+        engine.validate_order(too_expensive, manager),
+        RejectReason::INSUFFICIENT_CAPITAL
+    );
+
+    MarketOrder oversold{"ABC", SELL, "ETHUSD", 1001, 1};
+    EXPECT_EQ(
+        engine.validate_order(oversold, manager), RejectReason::INSUFFICIENT_HOLDINGS
+    );
+
+    // Rejected orders never reach the book
+    auto [matches, ob_updates] = engine.match_order(oversold, manager);
+    EXPECT_EQ(matches.size(), 0);
+    EXPECT_EQ(ob_updates.size(), 0);
+    EXPECT_EQ(engine.asks.size(), 0);
 }
@@ -0,0 +1,78 @@
+#include "load_generator/latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+using LatencyHistogram = nutc::load_generator::LatencyHistogram;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogram, EmptyHistogramReportsZero)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.max_us(), 0);
+    EXPECT_EQ(histogram.percentile_us(50), 0);
+    EXPECT_EQ(histogram.percentile_us(100), 0);
+}
+
+TEST(LatencyHistogram, PercentilesAreBucketUpperBounds)
+{
+    LatencyHistogram histogram;
+    // One sample in each of the buckets [0, 10), [10, 20), ..., [90, 100)
+    for (int i = 0; i < 10; i++)
+        histogram.record(std::chrono::microseconds(i * 10 + 5));
+
+    EXPECT_EQ(histogram.count(), 10);
+    EXPECT_EQ(histogram.percentile_us(10), 10);
+    EXPECT_EQ(histogram.percentile_us(50), 50);
+    EXPECT_EQ(histogram.percentile_us(51), 60);
+    EXPECT_EQ(histogram.percentile_us(90), 90);
+    // The last bucket is capped by the slowest sample actually seen
+    EXPECT_EQ(histogram.percentile_us(100), 95);
+    EXPECT_EQ(histogram.max_us(), 95);
+}
+
+TEST(LatencyHistogram, ZeroPercentileIsTheFastestBucket)
+{
+    LatencyHistogram histogram;
+    histogram.record(25us);
+    histogram.record(1ms);
+    EXPECT_EQ(histogram.percentile_us(0), 30);
+}
+
+TEST(LatencyHistogram, SubMicrosecondAndNegativeLatenciesLandInFirstBucket)
+{
+    LatencyHistogram histogram;
+    histogram.record(500ns);
+    histogram.record(-5us);
+    EXPECT_EQ(histogram.count(), 2);
+    EXPECT_EQ(histogram.max_us(), 0);
+    EXPECT_EQ(histogram.percentile_us(100), 0);
+}
+
+TEST(LatencyHistogram, SlowSamplesLandInLastBucket)
+{
+    LatencyHistogram histogram;
+    histogram.record(10us);
+    histogram.record(5s);
+
+    EXPECT_EQ(histogram.max_us(), 5'000'000);
+    EXPECT_EQ(histogram.percentile_us(50), 20);
+    EXPECT_EQ(histogram.percentile_us(100), 5'000'000);
+}
+
+TEST(LatencyHistogram, MergeCombinesWorkers)
+{
+    LatencyHistogram first;
+    LatencyHistogram second;
+    for (int i = 0; i < 3; i++)
+        first.record(15us);
+    second.record(95us);
+    second.record(250us);
+
+    first.merge(second);
+    EXPECT_EQ(first.count(), 5);
+    EXPECT_EQ(first.max_us(), 250);
+    EXPECT_EQ(first.percentile_us(60), 20);
+    EXPECT_EQ(first.percentile_us(80), 100);
+    EXPECT_EQ(first.percentile_us(100), 250);
+}
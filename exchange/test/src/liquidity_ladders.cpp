@@ -0,0 +1,154 @@
+#include "matching/liquidity/liquidity.hpp"
+#include "matching/manager/engine_manager.hpp"
+#include "test_utils/macros.hpp"
+#include "utils/messages.hpp"
+
+#include <gtest/gtest.h>
+
+using nutc::messages::SIDE::BUY;
+using nutc::messages::SIDE::SELL;
+
+class LiquidityLadders : public ::testing::Test {
+protected:
+    void
+    SetUp() override
+    {
+        manager.add_client("ABC");
+        manager.add_client("DEF");
+        manager.modify_holdings("ABC", "ETHUSD", 1000);
+        manager.modify_holdings("DEF", "ETHUSD", 1000);
+        engine_manager.add_engine("ETHUSD");
+    }
+
+    Engine&
+    engine()
+    {
+        return engine_manager.get_engine("ETHUSD").value().get();
+    }
+
+    ClientManager manager;
+    nutc::engine_manager::Manager engine_manager;
+    nutc::liquidity::LadderConfig config{"ETHUSD", 100, 1, 3, 10, 2};
+};
+
+TEST_F(LiquidityLadders, BuildsBothSides)
+{
+    auto orders = nutc::liquidity::build_ladder(config);
+    ASSERT_EQ(orders.size(), 6);
+
+    EXPECT_EQ(orders[0].side, BUY);
+    EXPECT_EQ(orders[0].price, 99);
+    EXPECT_EQ(orders[0].quantity, 10);
+    EXPECT_EQ(orders[1].side, SELL);
+    EXPECT_EQ(orders[1].price, 101);
+    EXPECT_EQ(orders[1].quantity, 10);
+    EXPECT_EQ(orders[4].price, 97);
+    EXPECT_EQ(orders[4].quantity, 40);
+    EXPECT_EQ(orders[5].price, 103);
+    EXPECT_EQ(orders[5].quantity, 40);
+
+    for (const auto& order : orders)
+        EXPECT_EQ(order.client_uid, "SIMULATED");
+}
+
+TEST_F(LiquidityLadders, SeedsEngine)
+{
+    auto updates = engine_manager.add_liquidity_ladder(config, false);
+    EXPECT_EQ(updates.size(), 6);
+    EXPECT_EQ(engine().bids.size(), 3);
+    EXPECT_EQ(engine().asks.size(), 3);
+    EXPECT_EQ(engine().bids.top().price, 99);
+    EXPECT_EQ(engine().asks.top().price, 101);
+}
+
+TEST_F(LiquidityLadders, UnknownTicker)
+{
+    config.ticker = "BTCUSD";
+    auto updates = engine_manager.add_liquidity_ladder(config, true);
+    EXPECT_EQ(updates.size(), 0);
+}
+
+TEST_F(LiquidityLadders, ClientsTradeAgainstLadder)
+{
+    engine_manager.add_liquidity_ladder(config, false);
+
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 15, 102};
+    auto [matches, ob_updates] = engine().match_order(buy, manager);
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ_MATCH(matches[0], "ETHUSD", "ABC", "SIMULATED", BUY, 101, 10);
+    EXPECT_EQ_MATCH(matches[1], "ETHUSD", "ABC", "SIMULATED", BUY, 102, 5);
+
+    // SIMULATED bids have no capital of their own but must still fill
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 10, 99};
+    auto [matches2, ob_updates2] = engine().match_order(sell, manager);
+    ASSERT_EQ(matches2.size(), 1);
+    EXPECT_EQ_MATCH(matches2[0], "ETHUSD", "SIMULATED", "DEF", SELL, 99, 10);
+}
+
+TEST_F(LiquidityLadders, RequotesAfterFill)
+{
+    engine_manager.add_liquidity_ladder(config, true);
+
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 4, 101};
+    auto [matches, ob_updates] = engine().match_order(buy, manager);
+    ASSERT_EQ(matches.size(), 1);
+
+    auto requotes = engine_manager.requote_after_matches("ETHUSD", matches);
+    // Reposting the 4 taken brings the level back to its full 10
+    ASSERT_EQ(requotes.size(), 1);
+    EXPECT_EQ_OB_UPDATE(requotes[0], "ETHUSD", SELL, 101, 10);
+    EXPECT_EQ(engine().asks.size(), 4);
+
+    // Nothing left to replenish
+    auto requotes2 = engine_manager.requote_after_matches("ETHUSD", {});
+    EXPECT_EQ(requotes2.size(), 0);
+}
+
+TEST_F(LiquidityLadders, NoRequoteWithoutMarketMaker)
+{
+    engine_manager.add_liquidity_ladder(config, false);
+
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 4, 101};
+    auto [matches, ob_updates] = engine().match_order(buy, manager);
+    ASSERT_EQ(matches.size(), 1);
+
+    auto requotes = engine_manager.requote_after_matches("ETHUSD", matches);
+    EXPECT_EQ(requotes.size(), 0);
+}
+
+TEST_F(LiquidityLadders, RequoteNeverCrossesBook)
+{
+    engine_manager.add_liquidity_ladder(config, true);
+
+    // Sweeps the first ask and rests the remainder at 101
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 15, 101};
+    auto [matches, ob_updates] = engine().match_order(buy, manager);
+    ASSERT_EQ(matches.size(), 1);
+
+    auto requotes = engine_manager.requote_after_matches("ETHUSD", matches);
+    EXPECT_EQ(requotes.size(), 0);
+    EXPECT_EQ(engine().bids.top().client_uid, "ABC");
+
+    // Once the resting bid is taken out, the level is reposted
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 5, 101};
+    auto [matches2, ob_updates2] = engine().match_order(sell, manager);
+    ASSERT_EQ(matches2.size(), 1);
+
+    auto requotes2 = engine_manager.requote_after_matches("ETHUSD", matches2);
+    ASSERT_EQ(requotes2.size(), 1);
+    EXPECT_EQ_OB_UPDATE(requotes2[0], "ETHUSD", SELL, 101, 10);
+}
+
+TEST_F(LiquidityLadders, SnapshotAggregatesLevels)
+{
+    engine_manager.add_liquidity_ladder(config, false);
+    engine().add_order_without_matching(MarketOrder{"ABC", BUY, "ETHUSD", 5, 99});
+
+    auto snapshot = engine_manager.snapshot();
+    ASSERT_EQ(snapshot.size(), 6);
+    // Bids then asks, each from the lowest price up
+    EXPECT_EQ_OB_UPDATE(snapshot[0], "ETHUSD", BUY, 97, 40);
+    EXPECT_EQ_OB_UPDATE(snapshot[2], "ETHUSD", BUY, 99, 15);
+    EXPECT_EQ_OB_UPDATE(snapshot[3], "ETHUSD", SELL, 101, 10);
+    EXPECT_EQ_OB_UPDATE(snapshot[5], "ETHUSD", SELL, 103, 40);
+}
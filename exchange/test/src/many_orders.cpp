@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+
 using nutc::messages::SIDE::BUY;
 using nutc::messages::SIDE::SELL;
 
@@ -41,13 +43,12 @@ TEST_F(ManyOrders, CorrectTimePriority)
     EXPECT_EQ_OB_UPDATE(updates1[0], "ETHUSD", BUY, 1, 1);
     EXPECT_EQ(matches2.size(), 0);
     EXPECT_EQ(updates2.size(), 1);
-    EXPECT_EQ_OB_UPDATE(updates2[0], "ETHUSD", BUY, 1, 1);
+    EXPECT_EQ_OB_UPDATE(updates2[0], "ETHUSD", BUY, 1, 2);
 
+    // One bid at 1 traded and another joined, so only the ask level changed
     EXPECT_EQ(matches3.size(), 1);
-    EXPECT_EQ(updates3.size(), 3);
-    EXPECT_EQ_OB_UPDATE(updates3[0], "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates3[1], "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates3[2], "ETHUSD", BUY, 1, 1);
+    EXPECT_EQ(updates3.size(), 1);
+    EXPECT_EQ_OB_UPDATE(updates3[0], "ETHUSD", SELL, 1, 0);
     // TODO: INCORRECT, SHOULD BE SELL
     EXPECT_EQ_MATCH(matches3[0], "ETHUSD", "A", "C", SELL, 1, 1);
 }
@@ -68,7 +69,7 @@ TEST_F(ManyOrders, OnlyMatchesOne)
     EXPECT_EQ(matches3.size(), 1);
     EXPECT_EQ(updates3.size(), 1);
     EXPECT_EQ_MATCH(matches3[0], "ETHUSD", "A", "B", SELL, 1, 1);
-    EXPECT_EQ_OB_UPDATE(updates3[0], "ETHUSD", BUY, 1, 0);
+    EXPECT_EQ_OB_UPDATE(updates3[0], "ETHUSD", BUY, 1, 1);
 }
 
 TEST_F(ManyOrders, SimpleManyOrder)
@@ -91,15 +92,13 @@ TEST_F(ManyOrders, SimpleManyOrder)
 
     auto [matches4, updates4] = engine.match_order(order4, manager);
     EXPECT_EQ(matches4.size(), 3);
-    EXPECT_EQ(updates4.size(), 3);
+    EXPECT_EQ(updates4.size(), 1);
 
     EXPECT_EQ_MATCH(matches4[0], "ETHUSD", "A", "D", SELL, 1, 1);
     EXPECT_EQ_MATCH(matches4[1], "ETHUSD", "B", "D", SELL, 1, 1);
     EXPECT_EQ_MATCH(matches4[2], "ETHUSD", "C", "D", SELL, 1, 1);
 
     EXPECT_EQ_OB_UPDATE(updates4[0], "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates4[1], "ETHUSD", BUY, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates4[2], "ETHUSD", BUY, 1, 0);
 }
 
 TEST_F(ManyOrders, PassiveAndAggressivePartial)
@@ -119,17 +118,39 @@ TEST_F(ManyOrders, PassiveAndAggressivePartial)
     EXPECT_EQ(matches2.size(), 0);
     EXPECT_EQ(updates2.size(), 1);
     EXPECT_EQ(matches3.size(), 2);
-    EXPECT_EQ(updates3.size(), 3);
+    EXPECT_EQ(updates3.size(), 1);
     EXPECT_EQ(matches4.size(), 1);
     EXPECT_EQ(updates4.size(), 2);
 
     EXPECT_EQ_MATCH(matches3[0], "ETHUSD", "C", "A", BUY, 1, 1);
     EXPECT_EQ_MATCH(matches3[1], "ETHUSD", "C", "B", BUY, 1, 1);
-    EXPECT_EQ_OB_UPDATE(updates3[0], "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates3[1], "ETHUSD", SELL, 1, 0);
-    EXPECT_EQ_OB_UPDATE(updates3[2], "ETHUSD", SELL, 1, 9);
+    EXPECT_EQ_OB_UPDATE(updates3[0], "ETHUSD", SELL, 1, 9);
 
     EXPECT_EQ_MATCH(matches4[0], "ETHUSD", "D", "B", BUY, 1, 9);
     EXPECT_EQ_OB_UPDATE(updates4[0], "ETHUSD", SELL, 1, 0);
     EXPECT_EQ_OB_UPDATE(updates4[1], "ETHUSD", BUY, 4, 1);
 }
+
+TEST_F(ManyOrders, UpdatesRebuildTheSnapshot)
+{
+    std::map<std::pair<SIDE, float>, float> book;
+    auto apply = [&book](const std::vector<ObUpdate>& updates) {
+        for (const auto& update : updates)
+            book[{update.side, update.price}] = update.quantity;
+    };
+
+    MarketOrder bid1{"A", BUY, "ETHUSD", 2, 1};
+    MarketOrder bid2{"B", BUY, "ETHUSD", 3, 1};
+    MarketOrder bid3{"C", BUY, "ETHUSD", 1, 2};
+    MarketOrder sell{"D", SELL, "ETHUSD", 4, 1};
+    for (auto* order : {&bid1, &bid2, &bid3, &sell})
+        apply(engine.match_order(*order, manager).ob_updates);
+
+    // The sell took the bid at 2 and 3 of the 5 resting at 1
+    EXPECT_FLOAT_EQ(engine.level_quantity(BUY, 1), 2);
+    EXPECT_FLOAT_EQ(engine.level_quantity(BUY, 2), 0);
+    for (const auto& update : engine.snapshot())
+        EXPECT_FLOAT_EQ((book[{update.side, update.price}]), update.quantity);
+    EXPECT_FLOAT_EQ((book[{BUY, 2}]), 0);
+    EXPECT_FLOAT_EQ((book[{SELL, 1}]), 0);
+}
@@ -0,0 +1,200 @@
+#include "client_manager/client_manager.hpp"
+#include "config.h"
+#include "matching/engine/engine.hpp"
+#include "test_utils/macros.hpp"
+#include "utils/messages.hpp"
+
+#include <gtest/gtest.h>
+
+using nutc::matching::MatchingMode;
+using nutc::messages::OrderType;
+using nutc::messages::RejectReason;
+using nutc::messages::TimeInForce;
+using nutc::messages::SIDE::BUY;
+using nutc::messages::SIDE::SELL;
+
+class OrderTypes : public ::testing::Test {
+protected:
+    void
+    SetUp() override
+    {
+        manager.add_client("ABC");
+        manager.add_client("DEF");
+        manager.modify_holdings("ABC", "ETHUSD", 1000);
+        manager.modify_holdings("DEF", "ETHUSD", 1000);
+    }
+
+    ClientManager manager;
+    Engine engine;
+};
+
+TEST_F(OrderTypes, IocFillsWhatItCanAndDropsTheRest)
+{
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 3, 10, OrderType::LIMIT, TimeInForce::IOC};
+    engine.match_order(sell, manager);
+
+    auto [matches, ob_updates] = engine.match_order(buy, manager);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", BUY, 10, 1);
+    ASSERT_EQ(ob_updates.size(), 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", SELL, 10, 0);
+    EXPECT_TRUE(engine.bids.empty());
+    EXPECT_TRUE(engine.asks.empty());
+}
+
+TEST_F(OrderTypes, IocThatDoesNotCrossNeverRests)
+{
+    MarketOrder resting_buy{"ABC", BUY, "ETHUSD", 1, 6};
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 5, OrderType::LIMIT, TimeInForce::IOC};
+    engine.match_order(resting_buy, manager);
+    engine.match_order(sell, manager);
+
+    auto [matches, ob_updates] = engine.match_order(buy, manager);
+    EXPECT_EQ(matches.size(), 0);
+    EXPECT_EQ(ob_updates.size(), 0);
+    ASSERT_EQ(engine.bids.size(), 1);
+    EXPECT_EQ(engine.bids.top().price, 6);
+}
+
+TEST_F(OrderTypes, FokIsKilledUnlessFullyFillable)
+{
+    MarketOrder sell1{"DEF", SELL, "ETHUSD", 1, 10};
+    MarketOrder sell2{"DEF", SELL, "ETHUSD", 1, 11};
+    engine.match_order(sell1, manager);
+    engine.match_order(sell2, manager);
+
+    MarketOrder too_big{"ABC", BUY,   "ETHUSD", 3, 11, OrderType::LIMIT,
+                        TimeInForce::FOK};
+    auto [matches, ob_updates] = engine.match_order(too_big, manager);
+    EXPECT_EQ(matches.size(), 0);
+    EXPECT_EQ(ob_updates.size(), 0);
+    EXPECT_EQ(engine.asks.size(), 2);
+    EXPECT_TRUE(engine.bids.empty());
+
+    MarketOrder fits{"ABC", BUY, "ETHUSD", 2, 11, OrderType::LIMIT, TimeInForce::FOK};
+    auto [matches2, ob_updates2] = engine.match_order(fits, manager);
+    ASSERT_EQ(matches2.size(), 2);
+    EXPECT_EQ_MATCH(matches2.at(0), "ETHUSD", "ABC", "DEF", BUY, 10, 1);
+    EXPECT_EQ_MATCH(matches2.at(1), "ETHUSD", "ABC", "DEF", BUY, 11, 1);
+    EXPECT_TRUE(engine.asks.empty());
+    EXPECT_TRUE(engine.bids.empty());
+}
+
+TEST_F(OrderTypes, FokDoesNotCountOrdersThatCanNoLongerSettle)
+{
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    engine.match_order(sell, manager);
+    manager.modify_holdings("DEF", "ETHUSD", -1000);
+
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 10, OrderType::LIMIT, TimeInForce::FOK};
+    auto [matches, ob_updates] = engine.match_order(buy, manager);
+    EXPECT_EQ(matches.size(), 0);
+    EXPECT_EQ(engine.asks.size(), 1);
+    EXPECT_TRUE(engine.bids.empty());
+}
+
+TEST_F(OrderTypes, MarketOrdersSweepTheBook)
+{
+    MarketOrder sell1{"DEF", SELL, "ETHUSD", 1, 10};
+    MarketOrder sell2{"DEF", SELL, "ETHUSD", 1, 12};
+    engine.match_order(sell1, manager);
+    engine.match_order(sell2, manager);
+
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 3, 0, OrderType::MARKET};
+    EXPECT_FALSE(engine.validate_order(buy, manager).has_value());
+    auto [matches, ob_updates] = engine.match_order(buy, manager);
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", BUY, 10, 1);
+    EXPECT_EQ_MATCH(matches.at(1), "ETHUSD", "ABC", "DEF", BUY, 12, 1);
+    ASSERT_EQ(ob_updates.size(), 2);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", SELL, 10, 0);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(1), "ETHUSD", SELL, 12, 0);
+    EXPECT_TRUE(engine.bids.empty());
+    EXPECT_FLOAT_EQ(manager.get_capital("ABC"), STARTING_CAPITAL - 22);
+}
+
+TEST_F(OrderTypes, MarketSellTakesTheBestBid)
+{
+    MarketOrder buy1{"ABC", BUY, "ETHUSD", 1, 9};
+    MarketOrder buy2{"ABC", BUY, "ETHUSD", 1, 8};
+    engine.match_order(buy1, manager);
+    engine.match_order(buy2, manager);
+
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 0, OrderType::MARKET};
+    auto [matches, ob_updates] = engine.match_order(sell, manager);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", SELL, 9, 1);
+    ASSERT_EQ(engine.bids.size(), 1);
+    EXPECT_EQ(engine.bids.top().price, 8);
+    EXPECT_TRUE(engine.asks.empty());
+}
+
+TEST_F(OrderTypes, MarketOrderWithoutLiquidityIsDropped)
+{
+    MarketOrder buy{"ABC", BUY, "ETHUSD", 1, 0, OrderType::MARKET};
+    auto [matches, ob_updates] = engine.match_order(buy, manager);
+    EXPECT_EQ(matches.size(), 0);
+    EXPECT_EQ(ob_updates.size(), 0);
+    EXPECT_TRUE(engine.bids.empty());
+}
+
+TEST_F(OrderTypes, PostOnlyOnlyAddsLiquidity)
+{
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 1, 10};
+    engine.match_order(sell, manager);
+
+    MarketOrder crossing{"ABC", BUY, "ETHUSD", 1, 10, OrderType::POST_ONLY};
+    EXPECT_EQ(engine.validate_order(crossing, manager), RejectReason::WOULD_CROSS);
+    auto [matches, ob_updates] = engine.match_order(crossing, manager);
+    EXPECT_EQ(matches.size(), 0);
+    EXPECT_EQ(ob_updates.size(), 0);
+    EXPECT_TRUE(engine.bids.empty());
+
+    MarketOrder passive{"ABC", BUY, "ETHUSD", 1, 9, OrderType::POST_ONLY};
+    auto [matches2, ob_updates2] = engine.match_order(passive, manager);
+    EXPECT_EQ(matches2.size(), 0);
+    ASSERT_EQ(ob_updates2.size(), 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates2.at(0), "ETHUSD", BUY, 9, 1);
+    EXPECT_EQ(engine.bids.size(), 1);
+}
+
+TEST_F(OrderTypes, RejectsContradictoryOrders)
+{
+    MarketOrder post_only_ioc{"ABC", BUY,   "ETHUSD", 1, 9, OrderType::POST_ONLY,
+                              TimeInForce::IOC};
+    EXPECT_EQ(
+        engine.validate_order(post_only_ioc, manager), RejectReason::INVALID_ORDER
+    );
+
+    MarketOrder priceless_limit{"ABC", BUY, "ETHUSD", 1, 0, OrderType::LIMIT};
+    EXPECT_EQ(
+        engine.validate_order(priceless_limit, manager), RejectReason::INVALID_ORDER
+    );
+
+    Engine auction{MatchingMode::BATCH_AUCTION};
+    MarketOrder fok{"ABC", BUY, "ETHUSD", 1, 9, OrderType::LIMIT, TimeInForce::FOK};
+    MarketOrder post_only{"ABC", BUY, "ETHUSD", 1, 9, OrderType::POST_ONLY};
+    EXPECT_EQ(auction.validate_order(fok, manager), RejectReason::INVALID_ORDER);
+    EXPECT_EQ(auction.validate_order(post_only, manager), RejectReason::INVALID_ORDER);
+}
+
+TEST_F(OrderTypes, AuctionsDropWhatTakersLeave)
+{
+    Engine auction{MatchingMode::BATCH_AUCTION};
+    MarketOrder sell{"DEF", SELL, "ETHUSD", 2, 10};
+    MarketOrder market_buy{"ABC", BUY, "ETHUSD", 1, 0, OrderType::MARKET};
+    MarketOrder ioc_buy{"ABC", BUY, "ETHUSD", 5, 9, OrderType::LIMIT, TimeInForce::IOC};
+    auction.match_order(sell, manager);
+    auction.match_order(market_buy, manager);
+    auction.match_order(ioc_buy, manager);
+
+    auto [matches, ob_updates] = auction.clear_auction(manager);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ_MATCH(matches.at(0), "ETHUSD", "ABC", "DEF", BUY, 10, 1);
+    ASSERT_EQ(ob_updates.size(), 1);
+    EXPECT_EQ_OB_UPDATE(ob_updates.at(0), "ETHUSD", SELL, 10, 1);
+    EXPECT_TRUE(auction.bids.empty());
+    EXPECT_EQ(auction.asks.size(), 1);
+}
@@ -0,0 +1,77 @@
+#include "client_manager/client_manager.hpp"
+#include "config.h"
+#include "rate_limiter/rate_limiter.hpp"
+#include "utils/dev_mode/dev_mode.hpp"
+
+#include <gtest/gtest.h>
+
+using TokenBucket = nutc::rate_limiter::TokenBucket;
+using namespace std::chrono_literals;
+
+class RateLimiting : public ::testing::Test {
+protected:
+    TokenBucket::clock::time_point start = TokenBucket::clock::now();
+    TokenBucket bucket{3, 2};
+};
+
+TEST_F(RateLimiting, AllowsBurst)
+{
+    EXPECT_TRUE(bucket.try_consume(start));
+    EXPECT_TRUE(bucket.try_consume(start));
+    EXPECT_TRUE(bucket.try_consume(start));
+    EXPECT_FALSE(bucket.try_consume(start));
+}
+
+TEST_F(RateLimiting, RefillsOverTime)
+{
+    for (int i = 0; i < 3; i++)
+        bucket.try_consume(start);
+    EXPECT_FALSE(bucket.try_consume(start + 400ms));
+
+    // 2 tokens per second
+    EXPECT_TRUE(bucket.try_consume(start + 600ms));
+    EXPECT_FALSE(bucket.try_consume(start + 600ms));
+    EXPECT_TRUE(bucket.try_consume(start + 1100ms));
+}
+
+TEST_F(RateLimiting, RefillCappedAtBurst)
+{
+    auto later = start + 1h;
+    EXPECT_TRUE(bucket.try_consume(later));
+    EXPECT_TRUE(bucket.try_consume(later));
+    EXPECT_TRUE(bucket.try_consume(later));
+    EXPECT_FALSE(bucket.try_consume(later));
+}
+
+TEST_F(RateLimiting, EnforcedPerClient)
+{
+    nutc::manager::ClientManager manager;
+    manager.add_client("ABC");
+    manager.add_client("DEF");
+
+    for (int i = 0; i < ORDER_RATE_LIMIT_BURST; i++)
+        EXPECT_TRUE(manager.consume_order_token("ABC"));
+    EXPECT_FALSE(manager.consume_order_token("ABC"));
+
+    EXPECT_TRUE(manager.consume_order_token("DEF"));
+}
+
+TEST_F(RateLimiting, RejectsUnknownClients)
+{
+    nutc::manager::ClientManager manager;
+    manager.add_client("ABC");
+
+    EXPECT_FALSE(manager.has_client("spoofed"));
+    EXPECT_FALSE(manager.consume_order_token("spoofed"));
+    EXPECT_TRUE(manager.consume_order_token("ABC"));
+}
+
+TEST_F(RateLimiting, LoadTestClientsHaveTheirOwnLimit)
+{
+    nutc::manager::ClientManager manager;
+    nutc::dev_mode::initialize_load_test_clients(manager, 1, {"ETHUSD"});
+    std::string uid = std::string(CLIENT_UID_PREFIX) + "0";
+
+    for (int i = 0; i < ORDER_RATE_LIMIT_BURST * 10; i++)
+        ASSERT_TRUE(manager.consume_order_token(uid));
+}
@@ -0,0 +1,105 @@
+#include "process_spawning/supervisor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+using nutc::client::ExitReport;
+using nutc::client::ResourceLimits;
+using nutc::client::Supervisor;
+using namespace std::chrono_literals;
+
+namespace {
+// Waits for the reaper to record `count` exits and for no children to be running
+std::vector<ExitReport>
+wait_for_exits(const Supervisor& supervisor, size_t count)
+{
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (supervisor.get_exits().size() >= count && supervisor.num_running() == 0)
+            break;
+        std::this_thread::sleep_for(10ms);
+    }
+    return supervisor.get_exits();
+}
+} // namespace
+
+TEST(Supervisor, RestartsFailedClientsUpToTheLimit)
+{
+    Supervisor supervisor{ResourceLimits{}, 2};
+    ASSERT_TRUE(supervisor.spawn("failing", {"/bin/false"}, true));
+
+    auto exits = wait_for_exits(supervisor, 3);
+    // Gives the reaper time to make a restart it shouldn't
+    std::this_thread::sleep_for(300ms);
+    exits = supervisor.get_exits();
+
+    ASSERT_EQ(exits.size(), 3);
+    EXPECT_EQ(supervisor.num_running(), 0);
+    for (const ExitReport& exit : exits) {
+        EXPECT_EQ(exit.name, "failing");
+        EXPECT_FALSE(exit.signaled);
+        EXPECT_EQ(exit.code, 1);
+    }
+    EXPECT_NE(exits[0].pid, exits[1].pid);
+    EXPECT_NE(exits[1].pid, exits[2].pid);
+}
+
+TEST(Supervisor, DoesNotRestartCleanExits)
+{
+    Supervisor supervisor{ResourceLimits{}, 2};
+    ASSERT_TRUE(supervisor.spawn("clean", {"/bin/true"}, true));
+
+    wait_for_exits(supervisor, 1);
+    std::this_thread::sleep_for(300ms);
+    auto exits = supervisor.get_exits();
+
+    ASSERT_EQ(exits.size(), 1);
+    EXPECT_FALSE(exits[0].signaled);
+    EXPECT_EQ(exits[0].code, 0);
+}
+
+TEST(Supervisor, DoesNotRestartWhenNotAsked)
+{
+    Supervisor supervisor{ResourceLimits{}, 2};
+    ASSERT_TRUE(supervisor.spawn("failing", {"/bin/false"}, false));
+
+    wait_for_exits(supervisor, 1);
+    std::this_thread::sleep_for(300ms);
+    EXPECT_EQ(supervisor.get_exits().size(), 1);
+}
+
+TEST(Supervisor, AppliesResourceLimitsInTheChild)
+{
+    ResourceLimits limits;
+    limits.cpu_seconds = 7;
+    limits.memory_bytes = rlim_t{64} * 1024 * 1024;
+    // ulimit reports the data limit in KB
+    Supervisor supervisor{limits, 0};
+    ASSERT_TRUE(supervisor.spawn(
+        "limited",
+        {"sh", "-c", "test $(ulimit -t) = 7 && test $(ulimit -d) = 65536"},
+        false
+    ));
+
+    auto exits = wait_for_exits(supervisor, 1);
+    ASSERT_EQ(exits.size(), 1);
+    EXPECT_FALSE(exits[0].signaled);
+    EXPECT_EQ(exits[0].code, 0);
+}
+
+TEST(Supervisor, SignalsRunningChildren)
+{
+    Supervisor supervisor{ResourceLimits{}, 2};
+    ASSERT_TRUE(supervisor.spawn("sleeper", {"sleep", "60"}, false));
+    EXPECT_EQ(supervisor.num_running(), 1);
+
+    supervisor.signal_all(SIGTERM);
+
+    auto exits = wait_for_exits(supervisor, 1);
+    ASSERT_EQ(exits.size(), 1);
+    EXPECT_TRUE(exits[0].signaled);
+    EXPECT_EQ(exits[0].code, SIGTERM);
+}
@@ -4,12 +4,14 @@ from conan import ConanFile
 class Recipe(ConanFile):
     settings = "os", "compiler", "build_type", "arch"
     generators = "CMakeToolchain", "CMakeDeps", "VirtualRunEnv"
+    # HTTP/2 lets firebase requests share one connection
+    default_options = {"libcurl/*:with_nghttp2": True}
 
     def layout(self):
         self.folders.generators = "conan"
 
     def requirements(self):
-        self.requires("zlib/1.3", override=True)
+        self.requires("zlib/1.3")         # zip extraction
         self.requires("fmt/[^10.1.0]")    # string parsing
         self.requires("quill/3.3.1")   # logging
         self.requires("libcurl/8.2.1")
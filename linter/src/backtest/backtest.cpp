@@ -0,0 +1,285 @@
+#include "backtest.hpp"
+
+#include "mock_api/mock_api.hpp"
+#include "pywrapper/runtime.hpp"
+
+#include <fcntl.h>
+#include <pybind11/pybind11.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace nutc {
+namespace backtest {
+
+namespace {
+// Owns the backtester's process and pipes
+struct Backtester {
+    pid_t pid = -1;
+    FILE* to_backtester = nullptr;
+    FILE* from_backtester = nullptr;
+
+    Backtester() = default;
+    Backtester(const Backtester&) = delete;
+    Backtester& operator=(const Backtester&) = delete;
+
+    ~Backtester()
+    {
+        if (to_backtester != nullptr)
+            fclose(to_backtester);
+        if (from_backtester != nullptr)
+            fclose(from_backtester);
+        if (pid > 0) {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+};
+
+// The mock API has to be put back before the captured orders go out of scope
+struct RestoreMockApi {
+    ~RestoreMockApi() { (void)pywrapper::create_api_module(mock_api::getMarketFunc()); }
+};
+} // namespace
+
+static bool
+start_backtester(const BacktestOptions& options, Backtester& backtester)
+{
+    int to_child[2];
+    int from_child[2];
+    if (pipe2(to_child, O_CLOEXEC) != 0)
+        return false;
+    if (pipe2(from_child, O_CLOEXEC) != 0) {
+        close(to_child[0]);
+        close(to_child[1]);
+        return false;
+    }
+
+    std::string steps = std::to_string(options.steps);
+    std::vector<const char*> args{
+        options.binary.c_str(), "--steps", steps.c_str(), nullptr
+    };
+
+    // A backtester that exits early makes send_orders fail instead of raising SIGPIPE
+    std::signal(SIGPIPE, SIG_IGN);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Don't outlive a worker that was killed for taking too long
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        std::signal(SIGPIPE, SIG_DFL);
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        execvp(args[0], const_cast<char* const*>(args.data()));
+        _exit(127);
+    }
+
+    close(to_child[0]);
+    close(from_child[1]);
+    if (pid < 0) {
+        close(to_child[1]);
+        close(from_child[0]);
+        return false;
+    }
+
+    backtester.pid = pid;
+    backtester.to_backtester = fdopen(to_child[1], "w");
+    backtester.from_backtester = fdopen(from_child[0], "r");
+    return backtester.to_backtester != nullptr && backtester.from_backtester != nullptr;
+}
+
+static std::optional<messages::BacktestUpdate>
+receive_update(FILE* from_backtester)
+{
+    char* line = nullptr;
+    size_t capacity = 0;
+    ssize_t length = getline(&line, &capacity, from_backtester);
+    std::string buffer;
+    if (length > 0)
+        buffer.assign(line, static_cast<size_t>(length));
+    free(line); // NOLINT(cppcoreguidelines-no-malloc)
+    if (buffer.empty())
+        return std::nullopt;
+
+    messages::BacktestUpdate update;
+    auto err = glz::read_json(update, buffer);
+    if (err) {
+        log_e(backtest, "Malformed update from backtester: {}", buffer);
+        return std::nullopt;
+    }
+    return update;
+}
+
+static bool
+send_orders(FILE* to_backtester, const std::vector<messages::MarketOrder>& orders)
+{
+    std::string buffer;
+    glz::write<glz::opts{}>(messages::MarketOrderBatch{orders}, buffer);
+    buffer += '\n';
+    return fwrite(buffer.data(), 1, buffer.size(), to_backtester) == buffer.size()
+           && fflush(to_backtester) == 0;
+}
+
+static LatencySummary
+summarize(std::vector<int64_t> latencies_ns)
+{
+    if (latencies_ns.empty())
+        return {0, 0, 0, 0};
+
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    auto percentile_us = [&](size_t percentile) {
+        // Nearest rank
+        size_t rank = (percentile * latencies_ns.size() + 99) / 100;
+        return latencies_ns[std::max<size_t>(rank, 1) - 1] / 1000;
+    };
+    return {
+        latencies_ns.size(), percentile_us(50), percentile_us(99),
+        latencies_ns.back() / 1000
+    };
+}
+
+std::string
+BacktestReport::to_string() const
+{
+    return fmt::format(
+        "Backtest over {} steps: PnL {:.2f} (portfolio value {:.2f}), {} orders placed "
+        "({} rejected), {} fills. Callback latency over {} calls: p50 {}us, p99 {}us, "
+        "max {}us",
+        result.steps,
+        result.pnl,
+        result.portfolio_value,
+        result.orders_placed,
+        result.orders_rejected,
+        result.fills,
+        callback_latency.samples,
+        callback_latency.p50_us,
+        callback_latency.p99_us,
+        callback_latency.max_us
+    );
+}
+
+std::optional<std::string>
+run_backtest(const BacktestOptions& options, BacktestReport& report)
+{
+    log_i(backtest, "Backtesting strategy for {} steps", options.steps);
+
+    // Orders the strategy places while handling an update, sent back after it
+    std::vector<messages::MarketOrder> placed_orders;
+    auto place_order = [&placed_orders](
+                           const std::string& side,
+                           const std::string& ticker,
+                           float quantity,
+                           float price,
+                           const std::string& order_type,
+                           const std::string& time_in_force
+                       ) {
+        std::optional<messages::OrderType> type =
+            messages::order_type_from_string(order_type);
+        std::optional<messages::TimeInForce> tif =
+            messages::time_in_force_from_string(time_in_force);
+        if ((side != "BUY" && side != "SELL") || !type.has_value()
+            || !tif.has_value())
+            return false;
+        messages::SIDE order_side =
+            side == "BUY" ? messages::SIDE::BUY : messages::SIDE::SELL;
+        placed_orders.push_back(
+            {"", order_side, ticker, quantity, price, type.value(), tif.value()}
+        );
+        return true;
+    };
+
+    RestoreMockApi restore_mock_api;
+    if (!pywrapper::create_api_module(place_order))
+        return "Unexpected error: failed to create API module for the backtest";
+
+    Backtester backtester;
+    if (!start_backtester(options, backtester))
+        return "Unexpected error: failed to start the backtester";
+
+    std::vector<int64_t> latencies_ns;
+    auto timed = [&latencies_ns](auto&& callback) {
+        auto start = std::chrono::steady_clock::now();
+        callback();
+        latencies_ns.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start
+            )
+                .count()
+        );
+    };
+
+    try {
+        py::object strategy = py::module_::import("__main__").attr("strategy");
+        py::object on_orderbook_update = strategy.attr("on_orderbook_update");
+        py::object on_trade_update = strategy.attr("on_trade_update");
+        py::object on_account_update = strategy.attr("on_account_update");
+        py::str buy("BUY");
+        py::str sell("SELL");
+        auto side = [&](messages::SIDE side) {
+            return side == messages::SIDE::BUY ? buy : sell;
+        };
+
+        while (true) {
+            std::optional<messages::BacktestUpdate> update =
+                receive_update(backtester.from_backtester);
+            if (!update.has_value())
+                return "Unexpected error: the backtester exited early";
+
+            for (const auto& ob_update : update->ob_updates) {
+                timed([&] {
+                    on_orderbook_update(
+                        ob_update.security,
+                        side(ob_update.side),
+                        ob_update.price,
+                        ob_update.quantity
+                    );
+                });
+            }
+            for (const auto& match : update->matches) {
+                timed([&] {
+                    on_trade_update(
+                        match.ticker, side(match.side), match.price, match.quantity
+                    );
+                });
+            }
+            for (const auto& account_update : update->account_updates) {
+                timed([&] {
+                    on_account_update(
+                        account_update.ticker,
+                        side(account_update.side),
+                        account_update.price,
+                        account_update.quantity,
+                        account_update.capital_remaining
+                    );
+                });
+            }
+
+            if (update->result.has_value()) {
+                report.result = update->result.value();
+                break;
+            }
+            if (!send_orders(backtester.to_backtester, placed_orders))
+                return "Unexpected error: the backtester exited early";
+            placed_orders.clear();
+        }
+    } catch (const std::exception& e) {
+        return fmt::format(
+            "Strategy raised an exception during the backtest: {}", e.what()
+        );
+    }
+
+    report.callback_latency = summarize(std::move(latencies_ns));
+    return std::nullopt;
+}
+
+} // namespace backtest
+} // namespace nutc
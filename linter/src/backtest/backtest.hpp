@@ -0,0 +1,47 @@
+#pragma once
+
+#include "backtest/messages.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace nutc {
+
+/**
+ * @brief Runs the loaded strategy through NUTC24-backtest, the exchange's offline
+ * matching engine, and profiles its callbacks
+ */
+namespace backtest {
+
+struct BacktestOptions {
+    // Path to, or name on the $PATH of, NUTC24-backtest
+    std::string binary;
+    int steps;
+};
+
+struct LatencySummary {
+    uint64_t samples;
+    int64_t p50_us;
+    int64_t p99_us;
+    int64_t max_us;
+};
+
+struct BacktestReport {
+    messages::BacktestResult result;
+    LatencySummary callback_latency;
+
+    [[nodiscard]] std::string to_string() const;
+};
+
+/**
+ * @brief Backtests the strategy already initialized in __main__
+ * Orders placed through nutc_api go to the backtester while it runs; the mock API is
+ * restored afterwards
+ * @return The reason the backtest failed, or nullopt if report was filled in
+ */
+[[nodiscard]] std::optional<std::string>
+run_backtest(const BacktestOptions& options, BacktestReport& report);
+
+} // namespace backtest
+} // namespace nutc
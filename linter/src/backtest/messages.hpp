@@ -0,0 +1,229 @@
+#pragma once
+
+#include <glaze/glaze.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief The subset of the exchange's messages spoken by NUTC24-backtest
+ * Must be kept in sync with the exchange's utils/messages.hpp
+ */
+namespace messages {
+
+enum class SIDE { BUY, SELL };
+
+enum class OrderType { LIMIT, MARKET, POST_ONLY };
+
+enum class TimeInForce { GTC, IOC, FOK };
+
+// Parses the names the Python API takes, e.g. "POST_ONLY"
+inline constexpr std::optional<OrderType>
+order_type_from_string(std::string_view name)
+{
+    if (name == "LIMIT")
+        return OrderType::LIMIT;
+    if (name == "MARKET")
+        return OrderType::MARKET;
+    if (name == "POST_ONLY")
+        return OrderType::POST_ONLY;
+    return std::nullopt;
+}
+
+inline constexpr std::optional<TimeInForce>
+time_in_force_from_string(std::string_view name)
+{
+    if (name == "GTC")
+        return TimeInForce::GTC;
+    if (name == "IOC")
+        return TimeInForce::IOC;
+    if (name == "FOK")
+        return TimeInForce::FOK;
+    return std::nullopt;
+}
+
+struct ObUpdate {
+    std::string security;
+    SIDE side;
+    float price;
+    float quantity;
+};
+
+struct Match {
+    std::string ticker;
+    std::string buyer_uid;
+    std::string seller_uid;
+    SIDE side;
+    float price;
+    float quantity;
+};
+
+struct AccountUpdate {
+    float capital_remaining;
+    std::string ticker;
+    SIDE side;
+    float price;
+    float quantity;
+};
+
+struct MarketOrder {
+    std::string client_uid;
+    SIDE side;
+    std::string ticker;
+    float quantity;
+    float price;
+    OrderType type = OrderType::LIMIT;
+    TimeInForce time_in_force = TimeInForce::GTC;
+};
+
+struct MarketOrderBatch {
+    std::vector<MarketOrder> orders;
+};
+
+struct BacktestResult {
+    int steps;
+    float starting_capital;
+    float capital;
+    float portfolio_value;
+    float pnl;
+    int orders_placed;
+    int orders_rejected;
+    int fills;
+};
+
+struct BacktestUpdate {
+    std::vector<ObUpdate> ob_updates;
+    std::vector<Match> matches;
+    std::vector<AccountUpdate> account_updates;
+    std::optional<BacktestResult> result;
+};
+
+} // namespace messages
+} // namespace nutc
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::ObUpdate> {
+    using T = nutc::messages::ObUpdate;
+    static constexpr auto value = object(
+        "security",
+        &T::security,
+        "side",
+        &T::side,
+        "price",
+        &T::price,
+        "quantity",
+        &T::quantity
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::Match> {
+    using T = nutc::messages::Match;
+    static constexpr auto value = object(
+        "ticker",
+        &T::ticker,
+        "buyer_uid",
+        &T::buyer_uid,
+        "seller_uid",
+        &T::seller_uid,
+        "side",
+        &T::side,
+        "price",
+        &T::price,
+        "quantity",
+        &T::quantity
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::AccountUpdate> {
+    using T = nutc::messages::AccountUpdate;
+    static constexpr auto value = object(
+        "capital_remaining",
+        &T::capital_remaining,
+        "ticker",
+        &T::ticker,
+        "side",
+        &T::side,
+        "price",
+        &T::price,
+        "quantity",
+        &T::quantity
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::MarketOrder> {
+    using T = nutc::messages::MarketOrder;
+    static constexpr auto value = object(
+        "client_uid",
+        &T::client_uid,
+        "side",
+        &T::side,
+        "ticker",
+        &T::ticker,
+        "quantity",
+        &T::quantity,
+        "price",
+        &T::price,
+        "type",
+        &T::type,
+        "time_in_force",
+        &T::time_in_force
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::MarketOrderBatch> {
+    using T = nutc::messages::MarketOrderBatch;
+    static constexpr auto value = object("orders", &T::orders);
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::BacktestResult> {
+    using T = nutc::messages::BacktestResult;
+    static constexpr auto value = object(
+        "steps",
+        &T::steps,
+        "starting_capital",
+        &T::starting_capital,
+        "capital",
+        &T::capital,
+        "portfolio_value",
+        &T::portfolio_value,
+        "pnl",
+        &T::pnl,
+        "orders_placed",
+        &T::orders_placed,
+        "orders_rejected",
+        &T::orders_rejected,
+        "fills",
+        &T::fills
+    );
+};
+
+/// \cond
+template <>
+struct glz::meta<nutc::messages::BacktestUpdate> {
+    using T = nutc::messages::BacktestUpdate;
+    static constexpr auto value = object(
+        "ob_updates",
+        &T::ob_updates,
+        "matches",
+        &T::matches,
+        "account_updates",
+        &T::account_updates,
+        "result",
+        &T::result
+    );
+};
@@ -1,4 +1,9 @@
 #include "fetching.hpp"
+
+#include "http/http_client.hpp"
+#include "write_batcher.hpp"
+
+#include <fstream>
 #include <unordered_map>
 
 namespace nutc {
@@ -16,52 +21,23 @@ print_algo_info(const glz::json_t& algo, const std::string& algo_id)
 void
 set_lint_result(const std::string& uid, const std::string& algo_id, bool succeeded)
 {
-    std::string success = "\"success\"";
-    std::string failure = "\"failure\"";
-    glz::json_t res = firebase_request(
-        "PUT",
-        fmt::format(
-            "{}/users/{}/algos/{}/lintResults.json",
-            std::string(FIREBASE_URL),
-            uid,
-            algo_id
-        ),
-        succeeded ? success : failure
+    WriteBatcher::instance().set(
+        uid,
+        fmt::format("algos/{}/lintResults", algo_id),
+        succeeded ? "success" : "failure"
     );
 }
 
-std::string
-replaceDisallowedValues(const std::string& input)
-{
-    std::regex newlinePattern("\\n");
-    std::string input2 = std::regex_replace(input, newlinePattern, "\\n");
-    std::regex disallowedPattern("[.$#\\[\\]]");
-
-    return std::regex_replace(input2, disallowedPattern, "");
-}
-
 void
 set_lint_success(
     const std::string& uid, const std::string& algo_id, const std::string& success
 )
 {
-    std::string json_success = "\"" + replaceDisallowedValues(success) + "\"";
-    log_e(main, "Seeing lint success: {}", json_success);
-    glz::json_t res = firebase_request(
-        "PUT",
-        fmt::format(
-            "{}/users/{}/algos/{}/lintSuccessMessage.json",
-            std::string(FIREBASE_URL),
-            uid,
-            algo_id
-        ),
-        json_success
-    );
-    glz::json_t res2 = firebase_request(
-        "PUT",
-        fmt::format("{}/users/{}/latestAlgoId.json", std::string(FIREBASE_URL), uid),
-        "\"" + algo_id + "\""
+    log_e(main, "Seeing lint success: {}", success);
+    WriteBatcher::instance().set(
+        uid, fmt::format("algos/{}/lintSuccessMessage", algo_id), success
     );
+    WriteBatcher::instance().set(uid, "latestAlgoId", algo_id);
 }
 
 void
@@ -69,17 +45,9 @@ set_lint_failure(
     const std::string& uid, const std::string& algo_id, const std::string& failure
 )
 {
-    std::string json_failure = "\"" + replaceDisallowedValues(failure) + "\"";
-    log_e(main, "Seeing lint failure: {}", json_failure);
-    glz::json_t res = firebase_request(
-        "PUT",
-        fmt::format(
-            "{}/users/{}/algos/{}/lintFailureMessage.json",
-            std::string(FIREBASE_URL),
-            uid,
-            algo_id
-        ),
-        json_failure
+    log_e(main, "Seeing lint failure: {}", failure);
+    WriteBatcher::instance().set(
+        uid, fmt::format("algos/{}/lintFailureMessage", algo_id), failure
     );
 }
 
@@ -90,40 +58,55 @@ get_user_info(const std::string& uid)
     return firebase_request("GET", url);
 }
 
-static size_t
-write_callback(void* contents, size_t size, size_t nmemb, void* userp)
-{
-    auto* str = reinterpret_cast<std::string*>(userp);
-    auto* data = static_cast<char*>(contents);
-
-    str->append(data, size * nmemb);
-    return size * nmemb;
-}
-
 std::string
 storage_request(const std::string& firebase_url)
 {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if (curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, firebase_url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-
-        res = curl_easy_perform(curl);
-
-        if (res != CURLE_OK) {
-            std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res)
-                      << std::endl;
-        }
-
-        curl_easy_cleanup(curl);
+    http::Response response = http::Client::instance().perform({"GET", firebase_url});
+    if (response.error.has_value()) {
+        log_e(
+            firebase,
+            "Request to {} failed: {}",
+            firebase_url,
+            response.error.value()
+        );
     }
+    return response.body;
+}
 
-    return readBuffer;
+std::optional<std::string>
+storage_download(
+    const std::string& url,
+    const std::filesystem::path& path,
+    size_t max_bytes,
+    std::chrono::seconds timeout
+)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return fmt::format("could not create {}", path.string());
+
+    size_t written = 0;
+    http::Request request{"GET", url};
+    request.timeout_secs = static_cast<long>(timeout.count());
+    request.on_data = [&](std::string_view data) {
+        written += data.size();
+        if (written > max_bytes)
+            return false;
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(file);
+    };
+    http::Response response = http::Client::instance().perform(std::move(request));
+    file.close();
+
+    if (written > max_bytes)
+        return fmt::format("file is larger than {} MB", max_bytes / (1024 * 1024));
+    if (response.error.has_value())
+        return response.error.value();
+    if (!response.ok())
+        return fmt::format("storage responded with status {}", response.status);
+    if (!file)
+        return fmt::format("could not write {}", path.string());
+    return std::nullopt;
 }
 
 std::optional<std::string>
@@ -148,8 +131,12 @@ get_algo(const std::string& uid, const std::string& algo_id)
     return algo_file;
 }
 
-std::optional<std::unordered_map<std::string, std::string>>
-get_algo_files(const std::string& uid, const std::string& algo_id)
+std::optional<std::unordered_map<std::string, std::filesystem::path>>
+get_algo_files(
+    const std::string& uid,
+    const std::string& algo_id,
+    const std::filesystem::path& directory
+)
 {
     glz::json_t user_info = get_user_info(uid);
 
@@ -164,7 +151,16 @@ get_algo_files(const std::string& uid, const std::string& algo_id)
     }
     glz::json_t algo_info = user_info["algos"][algo_id];
 
-    std::unordered_map<std::string, std::string> algo_files_map;
+    std::error_code err;
+    std::filesystem::create_directories(directory, err);
+    if (err) {
+        log_e(firebase, "Failed to create {}: {}", directory.string(), err.message());
+        return std::nullopt;
+    }
+
+    std::unordered_map<std::string, std::filesystem::path> algo_files_map;
+    auto deadline = std::chrono::steady_clock::now()
+                    + std::chrono::seconds(LINT_DOWNLOAD_TIMEOUT_SECS);
     size_t file_idx = 0;
     while (algo_info.contains(std::to_string(file_idx))) {
         glz::json_t file = algo_info[std::to_string(file_idx)];
@@ -173,9 +169,31 @@ get_algo_files(const std::string& uid, const std::string& algo_id)
 
         std::string file_name = file["fileName"].get<std::string>();
         std::string download_url = file["downloadURL"].get<std::string>();
-        std::string file_contents = storage_request(download_url);
+        // Saved by index, since the uploaded name could be any path
+        std::filesystem::path file_path = directory / std::to_string(file_idx);
+        auto remaining = std::chrono::ceil<std::chrono::seconds>(
+            deadline - std::chrono::steady_clock::now()
+        );
+        if (remaining.count() <= 0) {
+            log_e(
+                firebase,
+                "Downloads took longer than {} seconds",
+                LINT_DOWNLOAD_TIMEOUT_SECS
+            );
+            return std::nullopt;
+        }
+        std::optional<std::string> error = storage_download(
+            download_url,
+            file_path,
+            size_t{LINT_MAX_DOWNLOAD_MB} * 1024 * 1024,
+            remaining
+        );
+        if (error.has_value()) {
+            log_e(firebase, "Failed to download {}: {}", file_name, error.value());
+            return std::nullopt;
+        }
 
-        algo_files_map.insert(std::make_pair(file_name, file_contents));
+        algo_files_map.insert(std::make_pair(file_name, file_path));
     }
 
     return algo_files_map;
@@ -186,39 +204,15 @@ firebase_request(
     const std::string& method, const std::string& url, const std::string& data
 )
 {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if (curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-
-        if (method == "POST") {
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-        }
-        else if (method == "PUT") {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-        }
-        else if (method == "DELETE") {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-        }
-
-        res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            log_e(firebase, "curl_easy_perform() failed: {}", curl_easy_strerror(res));
-        }
-
-        curl_easy_cleanup(curl);
+    http::Response response = http::Client::instance().perform({method, url, data});
+    if (response.error.has_value()) {
+        log_e(firebase, "Request to {} failed: {}", url, response.error.value());
     }
 
     glz::json_t json{};
-    auto error = glz::read_json(json, readBuffer);
+    auto error = glz::read_json(json, response.body);
     if (error) {
-        std::string descriptive_error = glz::format_error(error, readBuffer);
+        std::string descriptive_error = glz::format_error(error, response.body);
         log_e(firebase, "glz::read_json() failed: {}", descriptive_error);
     }
     return json;
@@ -6,11 +6,13 @@
 #include <curl/curl.h>
 #include <glaze/glaze.hpp>
 
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <map>
 #include <optional>
-#include <regex>
 #include <string>
+#include <unordered_map>
 
 namespace nutc {
 namespace client {
@@ -22,8 +24,21 @@ glz::json_t firebase_request(
 
 std::string storage_request(const std::string& url);
 
+/**
+ * @brief Streams a file from storage to disk, aborting once it passes max_bytes or
+ * takes longer than timeout
+ * @returns Why the download failed, or nullopt if path now holds the file
+ */
+std::optional<std::string> storage_download(
+    const std::string& url,
+    const std::filesystem::path& path,
+    size_t max_bytes,
+    std::chrono::seconds timeout
+);
+
 glz::json_t get_user_info(const std::string& uid);
 
+// The set_lint_* writes are queued on the WriteBatcher and sent in the background
 void
 set_lint_result(const std::string& uid, const std::string& algo_id, bool succeeded);
 void set_lint_failure(
@@ -35,7 +50,15 @@ void set_lint_success(
 
 std::optional<std::string> get_algo(const std::string& uid, const std::string& algo_id);
 
-std::optional<std::unordered_map<std::string, std::string>> get_algo_files(const std::string& uid, const std::string& algo_id);
+/**
+ * @brief Downloads every file of the algorithm into directory
+ * @returns Where each file, by its uploaded name, was saved
+ */
+std::optional<std::unordered_map<std::string, std::filesystem::path>> get_algo_files(
+    const std::string& uid,
+    const std::string& algo_id,
+    const std::filesystem::path& directory
+);
 
 } // namespace client
 } // namespace nutc
@@ -0,0 +1,116 @@
+#include "write_batcher.hpp"
+
+#include "config.h"
+#include "http/http_client.hpp"
+#include "logging.hpp"
+
+#include <glaze/glaze.hpp>
+
+#include <future>
+#include <vector>
+
+namespace nutc {
+namespace client {
+
+WriteBatcher::WriteBatcher(std::chrono::milliseconds delay, std::string base_url) :
+    delay(delay), base_url(std::move(base_url)), writer([this] { run(); })
+{}
+
+WriteBatcher::~WriteBatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+}
+
+WriteBatcher&
+WriteBatcher::instance()
+{
+    static WriteBatcher batcher{
+        std::chrono::milliseconds(LINT_RESULT_WRITE_DELAY_MS), FIREBASE_URL
+    };
+    return batcher;
+}
+
+void
+WriteBatcher::set(const std::string& uid, const std::string& path, std::string value)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending[uid][path] = std::move(value);
+        queued++;
+    }
+    changed.notify_all();
+}
+
+void
+WriteBatcher::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t target = queued;
+    if (!pending.empty()) {
+        flush_requested = true;
+        changed.notify_all();
+    }
+    changed.wait(lock, [&] { return sent >= target; });
+}
+
+void
+WriteBatcher::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [&] { return stopping || !pending.empty(); });
+        if (pending.empty())
+            return;
+
+        // Gives the rest of a lint's writes the chance to join the same request
+        changed.wait_for(lock, delay, [&] { return stopping || flush_requested; });
+        Updates updates = std::move(pending);
+        pending.clear();
+        flush_requested = false;
+        uint64_t batch_end = queued;
+
+        lock.unlock();
+        write(updates);
+        lock.lock();
+
+        sent = batch_end;
+        changed.notify_all();
+    }
+}
+
+// Each user's writes are one PATCH of {"<path>": "<value>", ...}, which firebase
+// applies atomically
+void
+WriteBatcher::write(const Updates& updates) const
+{
+    std::vector<std::pair<std::string, std::future<http::Response>>> requests;
+    for (const auto& [uid, paths] : updates) {
+        std::string body = glz::write_json(paths);
+        std::string url = fmt::format("{}/users/{}.json", base_url, uid);
+        requests.emplace_back(
+            uid,
+            http::Client::instance().perform_async({"PATCH", url, std::move(body)})
+        );
+    }
+
+    for (auto& [uid, request] : requests) {
+        http::Response response = request.get();
+        if (!response.ok()) {
+            log_e(
+                firebase,
+                "Failed to write lint results for {}: {} (status {})",
+                uid,
+                response.error.value_or("bad status"),
+                response.status
+            );
+        }
+    }
+}
+
+} // namespace client
+} // namespace nutc
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace nutc {
+namespace client {
+
+/**
+ * @brief Write-behind buffer for the lint results written to firebase
+ *
+ * Writes are held for a short delay and then sent from a background thread, with
+ * all of a user's pending writes combined into one multi-path PATCH that firebase
+ * applies atomically. Callers never wait on firebase. Writes queued further apart
+ * than the delay can go out in separate PATCHes, sent one batch after another, so a
+ * lint's result may briefly be visible without its message
+ */
+class WriteBatcher {
+public:
+    // Writes go to <base_url>/users/<uid>.json
+    WriteBatcher(std::chrono::milliseconds delay, std::string base_url);
+
+    // Writes whatever is still pending
+    ~WriteBatcher();
+
+    WriteBatcher(const WriteBatcher&) = delete;
+    WriteBatcher& operator=(const WriteBatcher&) = delete;
+
+    // The batcher of this process, destroyed (and so flushed) at exit
+    static WriteBatcher& instance();
+
+    /**
+     * @brief Queues a write of the string value to users/<uid>/<path>
+     *
+     * A later write to the same path replaces the earlier one if it hasn't been sent
+     */
+    void set(const std::string& uid, const std::string& path, std::string value);
+
+    // Blocks until every write queued before the call has been sent
+    void flush();
+
+private:
+    // uid -> path under the user -> value
+    using Updates = std::map<std::string, std::map<std::string, std::string>>;
+
+    const std::chrono::milliseconds delay;
+    const std::string base_url;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    Updates pending;
+    // Numbers every set, so flush knows when its writes have been sent
+    uint64_t queued = 0;
+    uint64_t sent = 0;
+    bool flush_requested = false;
+    bool stopping = false;
+
+    std::thread writer;
+
+    void run();
+    void write(const Updates& updates) const;
+};
+
+} // namespace client
+} // namespace nutc
@@ -0,0 +1,241 @@
+#include "http_client.hpp"
+
+#include <unistd.h>
+
+#include <new>
+#include <unordered_map>
+
+namespace nutc {
+namespace http {
+
+bool
+Response::ok() const
+{
+    return !error.has_value() && (status == 0 || (status >= 200 && status < 300));
+}
+
+HandlePool::HandlePool(size_t max_idle) : max_idle(max_idle)
+{
+    // Reference counted by curl, so every pool can init and clean up its own
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    share = curl_share_init();
+    if (share == nullptr)
+        return;
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock_share);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock_share);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+    // Connections themselves aren't shared, which curl doesn't support across threads
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+HandlePool::~HandlePool()
+{
+    for (CURL* handle : idle)
+        curl_easy_cleanup(handle);
+    if (share != nullptr)
+        curl_share_cleanup(share);
+    curl_global_cleanup();
+}
+
+void
+HandlePool::lock_share(CURL*, curl_lock_data data, curl_lock_access, void* pool)
+{
+    static_cast<HandlePool*>(pool)->share_mutexes[data].lock();
+}
+
+void
+HandlePool::unlock_share(CURL*, curl_lock_data data, void* pool)
+{
+    static_cast<HandlePool*>(pool)->share_mutexes[data].unlock();
+}
+
+CURL*
+HandlePool::acquire()
+{
+    CURL* handle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Most recently used first, since its connections are the likeliest to be open
+        if (!idle.empty()) {
+            handle = idle.back();
+            idle.pop_back();
+        }
+    }
+    if (handle == nullptr)
+        handle = curl_easy_init();
+    if (handle == nullptr)
+        throw std::bad_alloc();
+
+    if (share != nullptr)
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    return handle;
+}
+
+void
+HandlePool::release(CURL* handle)
+{
+    // Clears the options but keeps the connections open
+    curl_easy_reset(handle);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (idle.size() < max_idle) {
+            idle.push_back(handle);
+            return;
+        }
+    }
+    curl_easy_cleanup(handle);
+}
+
+Client::Client(size_t max_idle_handles) : pool(max_idle_handles) {}
+
+Client::~Client()
+{
+    {
+        std::lock_guard<std::mutex> lock(async_mutex);
+        if (multi == nullptr)
+            return;
+        stopping = true;
+        curl_multi_wakeup(multi);
+    }
+    // Transfers that were already requested still complete
+    transfer_thread.join();
+    curl_multi_cleanup(multi);
+}
+
+Client&
+Client::instance()
+{
+    static std::mutex mutex;
+    static Client* client = nullptr;
+    static pid_t owner = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (client == nullptr || owner != getpid()) {
+        // Never destroyed: a client inherited through fork can't be safely torn down,
+        // and the process's own one is needed until exit
+        client = new Client();
+        owner = getpid();
+    }
+    return *client;
+}
+
+size_t
+Client::write_callback(char* data, size_t size, size_t nmemb, void* userp)
+{
+    auto* transfer = static_cast<Transfer*>(userp);
+    size_t bytes = size * nmemb;
+    if (!transfer->request.on_data) {
+        transfer->response.body.append(data, bytes);
+        return bytes;
+    }
+    // Returning less than was given aborts the transfer
+    return transfer->request.on_data(std::string_view(data, bytes)) ? bytes : 0;
+}
+
+void
+Client::prepare(CURL* handle, Transfer& transfer)
+{
+    const Request& request = transfer.request;
+    curl_easy_setopt(handle, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &transfer);
+    curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT, request.timeout_secs);
+    // Signals can't be used for timeouts once there is more than one thread
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    // Prefer waiting to multiplex over an open connection to opening another
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+
+    if (request.method == "GET")
+        return;
+    if (request.method != "POST")
+        curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+    if (request.method == "POST" || !request.body.empty()) {
+        auto size = static_cast<curl_off_t>(request.body.size());
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDS, request.body.data());
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE_LARGE, size);
+    }
+}
+
+void
+Client::finish(CURL* handle, Transfer& transfer, CURLcode result)
+{
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &transfer.response.status);
+    if (result != CURLE_OK)
+        transfer.response.error = curl_easy_strerror(result);
+}
+
+Response
+Client::perform(Request request)
+{
+    Transfer transfer{std::move(request), {}, {}};
+    CURL* handle = pool.acquire();
+    prepare(handle, transfer);
+    finish(handle, transfer, curl_easy_perform(handle));
+    pool.release(handle);
+    return std::move(transfer.response);
+}
+
+std::future<Response>
+Client::perform_async(Request request)
+{
+    auto transfer = std::make_unique<Transfer>(Transfer{std::move(request), {}, {}});
+    std::future<Response> response = transfer->promise.get_future();
+
+    std::lock_guard<std::mutex> lock(async_mutex);
+    if (multi == nullptr) {
+        multi = curl_multi_init();
+        if (multi == nullptr)
+            throw std::bad_alloc();
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        transfer_thread = std::thread([this] { run_transfers(); });
+    }
+    pending.push_back(std::move(transfer));
+    curl_multi_wakeup(multi);
+    return response;
+}
+
+void
+Client::run_transfers()
+{
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> active;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(async_mutex);
+            if (stopping && pending.empty() && active.empty())
+                return;
+            for (auto& transfer : pending) {
+                CURL* handle = pool.acquire();
+                prepare(handle, *transfer);
+                curl_multi_add_handle(multi, handle);
+                active.emplace(handle, std::move(transfer));
+            }
+            pending.clear();
+        }
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            CURL* handle = msg->easy_handle;
+            CURLcode result = msg->data.result;
+            auto transfer = std::move(active.extract(handle).mapped());
+            curl_multi_remove_handle(multi, handle);
+            finish(handle, *transfer, result);
+            pool.release(handle);
+            transfer->promise.set_value(std::move(transfer->response));
+        }
+
+        // Woken early by perform_async and the destructor
+        curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+    }
+}
+
+} // namespace http
+} // namespace nutc
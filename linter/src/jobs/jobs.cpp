@@ -0,0 +1,89 @@
+#include "jobs.hpp"
+
+#include <fmt/format.h>
+
+namespace nutc {
+namespace jobs {
+
+const char*
+to_string(JobState state)
+{
+    switch (state) {
+        case JobState::queued:
+            return "queued";
+        case JobState::linting:
+            return "linting";
+        case JobState::done:
+            return "done";
+        case JobState::error:
+            return "error";
+    }
+    return "unknown";
+}
+
+std::string
+JobTable::create(const std::string& uid, const std::string& algo_id, int task)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Random rather than sequential so one user can't look up another's jobs
+    std::string id;
+    do {
+        id = fmt::format("{:016x}", id_generator());
+    } while (jobs.contains(id));
+
+    jobs.emplace(id, Job{uid, algo_id, task});
+    return id;
+}
+
+void
+JobTable::erase(const std::string& id)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    jobs.erase(id);
+}
+
+void
+JobTable::set_linting(const std::string& id)
+{
+    update(id, JobState::linting);
+}
+
+void
+JobTable::finish(const std::string& id, std::string message, bool succeeded)
+{
+    update(id, succeeded ? JobState::done : JobState::error, std::move(message));
+}
+
+void
+JobTable::update(const std::string& id, JobState state, std::string message)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto job = jobs.find(id);
+    if (job == jobs.end())
+        return;
+
+    job->second.state = state;
+    job->second.message = std::move(message);
+
+    if (job->second.finished()) {
+        finished_ids.push_back(id);
+        while (finished_ids.size() > max_finished) {
+            jobs.erase(finished_ids.front());
+            finished_ids.pop_front();
+        }
+    }
+}
+
+std::optional<Job>
+JobTable::get(const std::string& id) const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto job = jobs.find(id);
+    if (job == jobs.end())
+        return std::nullopt;
+    return job->second;
+}
+
+} // namespace jobs
+} // namespace nutc
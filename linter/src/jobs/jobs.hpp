@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace nutc {
+
+/** @brief Tracks submissions from the moment they are accepted until they are linted */
+namespace jobs {
+
+enum class JobState { queued, linting, done, error };
+
+const char* to_string(JobState state);
+
+struct Job {
+    std::string uid;
+    std::string algo_id;
+    int task;
+    JobState state = JobState::queued;
+    // Lint output once the job is done, or why it failed
+    std::string message{};
+
+    [[nodiscard]] bool
+    finished() const
+    {
+        return state == JobState::done || state == JobState::error;
+    }
+};
+
+/**
+ * @brief In-memory table of lint jobs, safe to use from the HTTP and pool threads
+ *
+ * Only the most recent max_finished finished jobs are kept; older ones are
+ * forgotten and their ids stop resolving
+ */
+class JobTable {
+public:
+    explicit JobTable(size_t max_finished) : max_finished(max_finished) {}
+
+    // Returns the id of the new, queued job
+    std::string create(const std::string& uid, const std::string& algo_id, int task);
+
+    // Forgets a job that was never queued
+    void erase(const std::string& id);
+
+    void set_linting(const std::string& id);
+    void finish(const std::string& id, std::string message, bool succeeded);
+
+    std::optional<Job> get(const std::string& id) const;
+
+private:
+    const size_t max_finished;
+    mutable std::mutex mtx;
+    std::unordered_map<std::string, Job> jobs;
+    // Oldest first
+    std::deque<std::string> finished_ids;
+    std::mt19937_64 id_generator{std::random_device{}()};
+
+    void update(const std::string& id, JobState state, std::string message = "");
+};
+
+} // namespace jobs
+} // namespace nutc
@@ -0,0 +1,131 @@
+#include "lint_cache.hpp"
+
+#include "config.h"
+#include "logging.hpp"
+#include "sha256.hpp"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace nutc {
+namespace lint_cache {
+
+LintCache::LintCache(
+    std::filesystem::path directory, size_t memory_entries, std::string linter_version
+) :
+    directory(std::move(directory)), memory_entries(memory_entries),
+    linter_version(std::move(linter_version))
+{
+    std::error_code err;
+    std::filesystem::create_directories(this->directory, err);
+    if (err) {
+        log_w(
+            main,
+            "Failed to create lint cache directory {}: {}",
+            this->directory.string(),
+            err.message()
+        );
+    }
+}
+
+std::string
+LintCache::key(const std::string& kind, const std::string& source) const
+{
+    Sha256 hash;
+    hash.update(linter_version);
+    hash.update("\n");
+    hash.update(source);
+    return fmt::format("{}-{}", kind, hash.hex_digest());
+}
+
+std::optional<LintResult>
+LintCache::get(const std::string& kind, const std::string& source)
+{
+    std::string cache_key = key(kind, source);
+
+    auto entry = index.find(cache_key);
+    if (entry != index.end()) {
+        entries.splice(entries.begin(), entries, entry->second);
+        return entry->second->result;
+    }
+
+    std::optional<LintResult> result = read_from_disk(cache_key);
+    if (result.has_value())
+        remember(cache_key, result.value());
+    return result;
+}
+
+void
+LintCache::put(
+    const std::string& kind, const std::string& source, const LintResult& result
+)
+{
+    std::string cache_key = key(kind, source);
+    remember(cache_key, result);
+    write_to_disk(cache_key, result);
+}
+
+void
+LintCache::remember(const std::string& key, const LintResult& result)
+{
+    auto entry = index.find(key);
+    if (entry != index.end()) {
+        entry->second->result = result;
+        entries.splice(entries.begin(), entries, entry->second);
+        return;
+    }
+
+    entries.push_front({key, result});
+    index[key] = entries.begin();
+    if (entries.size() > memory_entries) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+// Files hold a 1 or 0 for whether the lint succeeded, a newline, then the message
+std::optional<LintResult>
+LintCache::read_from_disk(const std::string& key) const
+{
+    std::ifstream file(directory / key, std::ios::binary);
+    if (!file.is_open())
+        return std::nullopt;
+
+    std::string succeeded;
+    if (!std::getline(file, succeeded) || (succeeded != "0" && succeeded != "1"))
+        return std::nullopt;
+
+    std::string message(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()
+    );
+    return LintResult{succeeded == "1", std::move(message)};
+}
+
+void
+LintCache::write_to_disk(const std::string& key, const LintResult& result) const
+{
+    // Written under a unique name then renamed, so other workers never read half a
+    // file
+    std::filesystem::path temp_path =
+        directory / fmt::format("{}.{}.tmp", key, getpid());
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file << (result.succeeded ? "1" : "0") << '\n' << result.message;
+        if (!file.flush()) {
+            log_w(main, "Failed to write lint cache entry {}", key);
+            return;
+        }
+    }
+
+    std::error_code err;
+    std::filesystem::rename(temp_path, directory / key, err);
+    if (err) {
+        log_w(main, "Failed to save lint cache entry {}: {}", key, err.message());
+        std::filesystem::remove(temp_path, err);
+    }
+}
+
+} // namespace lint_cache
+} // namespace nutc
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace nutc {
+
+/**
+ * @brief Remembers lint results by the content of the algorithm that was linted
+ *
+ * Users often re-upload identical code, and those uploads skip straight to the
+ * cached result. Recent results are kept in memory, and all of them on disk, where
+ * every worker process can see them
+ */
+namespace lint_cache {
+
+struct LintResult {
+    bool succeeded;
+    // The lint failure, or the success message
+    std::string message;
+};
+
+class LintCache {
+public:
+    // linter_version identifies the build, since a new linter may lint differently
+    LintCache(
+        std::filesystem::path directory,
+        size_t memory_entries,
+        std::string linter_version
+    );
+
+    // kind separates results that depend on more than the code, e.g. the track
+    std::optional<LintResult> get(const std::string& kind, const std::string& source);
+    void
+    put(const std::string& kind, const std::string& source, const LintResult& result);
+
+private:
+    struct Entry {
+        std::string key;
+        LintResult result;
+    };
+
+    const std::filesystem::path directory;
+    const size_t memory_entries;
+    const std::string linter_version;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+    std::string key(const std::string& kind, const std::string& source) const;
+
+    void remember(const std::string& key, const LintResult& result);
+    std::optional<LintResult> read_from_disk(const std::string& key) const;
+    void write_to_disk(const std::string& key, const LintResult& result) const;
+};
+
+} // namespace lint_cache
+} // namespace nutc
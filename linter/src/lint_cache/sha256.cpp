@@ -0,0 +1,136 @@
+#include "sha256.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// FIPS 180-4. Only used for cache keys, so it favors brevity over speed
+namespace nutc {
+namespace lint_cache {
+
+namespace {
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2
+};
+
+constexpr uint32_t
+rotr(uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+void
+compress(std::array<uint32_t, 8>& state, const unsigned char* block)
+{
+    std::array<uint32_t, 64> schedule{};
+    for (size_t i = 0; i < 16; i++) {
+        const unsigned char* word = block + 4 * i;
+        schedule[i] = (uint32_t{word[0]} << 24) | (uint32_t{word[1]} << 16)
+                      | (uint32_t{word[2]} << 8) | uint32_t{word[3]};
+    }
+    for (size_t i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(schedule[i - 15], 7) ^ rotr(schedule[i - 15], 18)
+                      ^ (schedule[i - 15] >> 3);
+        uint32_t s1 = rotr(schedule[i - 2], 17) ^ rotr(schedule[i - 2], 19)
+                      ^ (schedule[i - 2] >> 10);
+        schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+    }
+
+    auto [a, b, c, d, e, f, g, h] = state;
+    for (size_t i = 0; i < 64; i++) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t choice = (e & f) ^ (~e & g);
+        uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + schedule[i];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    std::array<uint32_t, 8> rounds = {a, b, c, d, e, f, g, h};
+    for (size_t i = 0; i < 8; i++)
+        state[i] += rounds[i];
+}
+} // namespace
+
+Sha256::Sha256() :
+    state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+{}
+
+void
+Sha256::update(std::string_view data)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    size_t size = data.size();
+    length += size;
+
+    // Top up a block left partial by the last update first
+    size_t buffered = (length - size) % 64;
+    if (buffered != 0) {
+        size_t taken = std::min(size, 64 - buffered);
+        std::copy_n(bytes, taken, buffer.begin() + static_cast<ptrdiff_t>(buffered));
+        bytes += taken;
+        size -= taken;
+        if (buffered + taken < 64)
+            return;
+        compress(state, buffer.data());
+    }
+
+    for (; size >= 64; bytes += 64, size -= 64)
+        compress(state, bytes);
+    std::copy_n(bytes, size, buffer.begin());
+}
+
+std::string
+Sha256::hex_digest() const
+{
+    // Buffered bytes, the 0x80 terminator and the bit length, in one or two blocks
+    std::array<uint32_t, 8> final_state = state;
+    std::array<unsigned char, 128> tail{};
+    size_t remaining = length % 64;
+    std::copy_n(buffer.begin(), remaining, tail.begin());
+    tail[remaining] = 0x80;
+    size_t tail_size = remaining + 9 > 64 ? 128 : 64;
+    uint64_t bit_length = length * 8;
+    for (size_t i = 0; i < 8; i++)
+        tail[tail_size - 1 - i] = static_cast<unsigned char>(bit_length >> (8 * i));
+    for (size_t offset = 0; offset < tail_size; offset += 64)
+        compress(final_state, tail.data() + offset);
+
+    std::string digest;
+    digest.reserve(64);
+    for (uint32_t word : final_state)
+        digest += fmt::format("{:08x}", word);
+    return digest;
+}
+
+std::string
+sha256_hex(std::string_view data)
+{
+    Sha256 hash;
+    hash.update(data);
+    return hash.hex_digest();
+}
+
+} // namespace lint_cache
+} // namespace nutc
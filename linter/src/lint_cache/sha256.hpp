@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace nutc {
+namespace lint_cache {
+
+// Incremental SHA-256, for data too large to hold in memory at once
+class Sha256 {
+public:
+    Sha256();
+
+    void update(std::string_view data);
+    // Lowercase hex digest of everything passed to update so far
+    std::string hex_digest() const;
+
+private:
+    std::array<uint32_t, 8> state;
+    // Bytes of the current block not yet compressed
+    std::array<unsigned char, 64> buffer{};
+    uint64_t length = 0;
+};
+
+// Lowercase hex SHA-256 digest of data
+std::string sha256_hex(std::string_view data);
+
+} // namespace lint_cache
+} // namespace nutc
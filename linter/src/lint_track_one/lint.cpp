@@ -3,12 +3,141 @@
 
 // Track one linter for FinRL competition
 namespace nutc::lint_track_one {
+    struct Archive {
+        std::filesystem::path path;
+        std::vector<zip::Entry> entries;
+    };
+
+    // Holds one submission's downloads and extracted files for as long as it lints
+    class ScratchDirectory {
+    public:
+        // Named by worker, since a worker lints one submission at a time and one
+        // that was killed mid-lint is replaced by a process with a new pid
+        ScratchDirectory() :
+            path(std::filesystem::path(LINT_SCRATCH_DIR) / std::to_string(getpid()))
+        {
+            std::error_code err;
+            std::filesystem::remove_all(path, err);
+        }
+
+        ~ScratchDirectory()
+        {
+            std::error_code err;
+            std::filesystem::remove_all(path, err);
+        }
+
+        ScratchDirectory(const ScratchDirectory&) = delete;
+        ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+        const std::filesystem::path path;
+    };
+
+    static std::optional<std::string>
+    read_script(const std::filesystem::path& path, std::string& code)
+    {
+        std::error_code err;
+        uintmax_t size = std::filesystem::file_size(path, err);
+        if (err || size > uintmax_t{LINT_MAX_SCRIPT_KB} * 1024) {
+            return fmt::format("test.py must be under {} KB", LINT_MAX_SCRIPT_KB);
+        }
+        std::ifstream file(path, std::ios::binary);
+        code.assign(std::istreambuf_iterator<char>(file), {});
+        return std::nullopt;
+    }
+
+    // What the lint depends on besides the code: each archive's SHA-256, read in
+    // chunks since archives may be as large as a download allows
+    static std::optional<std::string>
+    cache_source(const std::string& code, const std::vector<Archive>& archives)
+    {
+        std::string source = code;
+        std::vector<char> chunk(1 << 20);
+        for (const Archive& archive : archives) {
+            std::ifstream file(archive.path, std::ios::binary);
+            lint_cache::Sha256 hash;
+            while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()))
+                   || file.gcount() > 0) {
+                hash.update({chunk.data(), static_cast<size_t>(file.gcount())});
+            }
+            if (file.bad() || !file.eof())
+                return std::nullopt;
+            source += fmt::format("\n{}", hash.hex_digest());
+        }
+        return source;
+    }
+
+    static_assert(
+        LINT_ZIP_MAX_UNCOMPRESSED_MB * 2 <= LINT_MEMORY_LIMIT_MB,
+        "the code must be able to load what it unpacks"
+    );
+
+    // Archives are extracted in the sandbox, so it gets time for that on top of the
+    // usual limits
+    static sandbox::Limits
+    sandbox_limits()
+    {
+        sandbox::Limits limits = sandbox::default_limits();
+        limits.wall_time += std::chrono::seconds(LINT_EXTRACT_LIMIT_SECS);
+        limits.cpu_seconds += LINT_EXTRACT_LIMIT_SECS;
+        return limits;
+    }
+
+    static lint_cache::LintResult
+    lint_code(
+        const std::string& code,
+        const std::vector<Archive>& archives,
+        const std::filesystem::path& directory
+    )
+    {
+        // Extracted in the sandbox so that it counts against the lint's limits
+        for (const Archive& archive : archives) {
+            std::optional<std::string> err =
+                zip::extract_all(archive.path, archive.entries, directory);
+            if (err.has_value()) {
+                return {false, err.value()};
+            }
+        }
+
+        // The code can open and import what it shipped with by relative path
+        std::error_code dir_err;
+        std::filesystem::create_directories(directory, dir_err);
+        std::filesystem::current_path(directory, dir_err);
+        if (dir_err) {
+            return {false, "Unexpected error: failed to enter the submission's files"};
+        }
+        pybind11::module_::import("sys").attr("path").attr("insert")(0, ".");
+
+        std::optional<std::string> err =
+            nutc::pywrapper_track_one::import_py_code(code);
+        if (err.has_value()) {
+            return {false, err.value()};
+        }
+        return {true, "Lint succeeded!"};
+    }
+
+    static std::string
+    fail(const std::string& uid, const std::string& algo_id, const std::string& error)
+    {
+        log_e(linting, "{}", error);
+        nutc::client::set_lint_result(uid, algo_id, false);
+        nutc::client::set_lint_failure(uid, algo_id, error);
+        return error;
+    }
+
     std::string
-    lint(const std::string& uid, const std::string& algo_id)
+    lint(
+        const std::string& uid,
+        const std::string& algo_id,
+        lint_cache::LintCache& cache
+    )
     {
-        const auto maybe_algo_files = nutc::client::get_algo_files(uid, algo_id);
+        // Files go straight to disk; model checkpoints can be far larger than the
+        // worker should hold in memory
+        ScratchDirectory scratch{};
+        const auto maybe_algo_files =
+            nutc::client::get_algo_files(uid, algo_id, scratch.path / "files");
         if (!maybe_algo_files.has_value()) {
-            return "Could not find algorithm";
+            return "Could not find or download algorithm";
         }
 
         auto algo_files = maybe_algo_files.value();
@@ -28,17 +157,49 @@ namespace nutc::lint_track_one {
             return "Missing required file(s).";
         }
 
-        if (algo_files.contains("requirements.txt")) {
-            auto txt = algo_files["requirements.txt"];
+        // Only the central directories are read here, so a malformed or oversized
+        // archive is turned away before any of it is extracted
+        std::vector<Archive> archives;
+        for (auto const& [file_name, path] : algo_files) {
+            if (!file_name.ends_with(".zip")) {
+                continue;
+            }
+            Archive archive{path, {}};
+            std::optional<std::string> err =
+                zip::read_entries(path, zip::default_limits(), archive.entries);
+            if (err.has_value()) {
+                return fail(
+                    uid, algo_id, fmt::format("{}: {}", file_name, err.value())
+                );
+            }
+            archives.push_back(std::move(archive));
+        }
+
+        std::string code;
+        std::optional<std::string> err = read_script(algo_files["test.py"], code);
+        if (err.has_value()) {
+            return fail(uid, algo_id, err.value());
         }
 
-        std::optional<std::string> err = nutc::pywrapper_track_one::import_py_code(algo_files["test.py"]);
+        std::optional<std::string> source = cache_source(code, archives);
+        std::optional<lint_cache::LintResult> result;
+        if (source.has_value())
+            result = cache.get("1", source.value());
+        if (result.has_value()) {
+            log_i(linting, "Reusing lint result for identical code");
+        } else {
+            sandbox::SandboxResult sandboxed = sandbox::run(
+                sandbox_limits(),
+                [&] { return lint_code(code, archives, scratch.path / "extracted"); }
+            );
+            result = sandboxed.result;
+            if (sandboxed.completed && source.has_value())
+                cache.put("1", source.value(), result.value());
+            result->message += "\n" + sandboxed.usage.to_string();
+        }
 
-        if (err.has_value()) {
-            log_e(linting, "{}", err.value());
-            nutc::client::set_lint_result(uid, algo_id, false);
-            nutc::client::set_lint_failure(uid, algo_id, err.value());
-            return err.value();
+        if (!result->succeeded) {
+            return fail(uid, algo_id, result->message);
         }
 //
 //        err = nutc::pywrapper_track_one::run_initialization();
@@ -59,6 +220,6 @@ namespace nutc::lint_track_one {
 //
 //        nutc::client::set_lint_result(uid, algo_id, true);
 
-        return "Lint succeeded!";
+        return result->message;
     }
 } // namespace nutc::lint_track_one
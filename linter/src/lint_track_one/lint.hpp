@@ -1,17 +1,30 @@
 #pragma once
 
 #include "firebase/fetching.hpp"
+#include "lint_cache/lint_cache.hpp"
+#include "lint_cache/sha256.hpp"
 #include "mock_api/mock_api.hpp"
+#include "sandbox/sandbox.hpp"
 #include "pywrapper/runtime_track_one.hpp"
+#include "zip/zip.hpp"
 
 #include <pybind11/pybind11.h>
 
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
 #include <string>
+#include <vector>
 
 namespace nutc {
     namespace lint_track_one {
 
-        [[nodiscard]] std::string lint(const std::string& uid, const std::string& algo_id);
+        [[nodiscard]] std::string lint(
+            const std::string& uid,
+            const std::string& algo_id,
+            lint_cache::LintCache& cache
+        );
 
     } // namespace lint_track_one
 } // namespace nutc
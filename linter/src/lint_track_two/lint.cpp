@@ -3,8 +3,65 @@
 // Track two for NUTC Contest
 namespace nutc {
 namespace lint_track_two {
+static lint_cache::LintResult
+run_backtest(const backtest::BacktestOptions& options)
+{
+    backtest::BacktestReport report{};
+    std::optional<std::string> err = backtest::run_backtest(options, report);
+    if (err.has_value()) {
+        return {false, err.value()};
+    }
+
+    std::string summary = report.to_string();
+    int64_t max_p99_us = int64_t{BACKTEST_MAX_CALLBACK_P99_MS} * 1000;
+    if (report.callback_latency.p99_us > max_p99_us) {
+        return {
+            false,
+            fmt::format(
+                "Callbacks are too slow: p99 latency must be under {}ms. {}",
+                BACKTEST_MAX_CALLBACK_P99_MS,
+                summary
+            )
+        };
+    }
+    return {true, "Lint succeeded!\n" + summary};
+}
+
+static lint_cache::LintResult
+lint_code(
+    const std::string& code,
+    const std::optional<backtest::BacktestOptions>& backtest
+)
+{
+    std::optional<std::string> err = nutc::pywrapper::import_py_code(code);
+    if (err.has_value()) {
+        return {false, err.value()};
+    }
+
+    err = nutc::pywrapper::run_initialization();
+    if (err.has_value()) {
+        return {false, err.value()};
+    }
+
+    err = nutc::pywrapper::trigger_callbacks();
+    if (err.has_value()) {
+        return {false, err.value()};
+    }
+
+    if (backtest.has_value()) {
+        return run_backtest(backtest.value());
+    }
+
+    return {true, "Lint succeeded!"};
+}
+
 std::string
-lint(const std::string& uid, const std::string& algo_id)
+lint(
+    const std::string& uid,
+    const std::string& algo_id,
+    lint_cache::LintCache& cache,
+    const std::optional<backtest::BacktestOptions>& backtest
+)
 {
     std::optional<std::string> algoCode = nutc::client::get_algo(uid, algo_id);
     if (!algoCode.has_value()) {
@@ -18,33 +75,36 @@ lint(const std::string& uid, const std::string& algo_id)
         return "Unexpected error: failed to create API module";
     }
 
-    std::optional<std::string> err = nutc::pywrapper::import_py_code(algoCode.value());
-    if (err.has_value()) {
-        log_e(linting, "{}", err.value());
-        nutc::client::set_lint_result(uid, algo_id, false);
-        nutc::client::set_lint_failure(uid, algo_id, err.value());
-        return err.value();
+    // Identical code always lints the same way, so a resubmission costs only a hash.
+    // Backtests judge callback latency, which varies from run to run, so their
+    // verdicts are never cached
+    std::optional<lint_cache::LintResult> result;
+    if (!backtest.has_value())
+        result = cache.get("2", algoCode.value());
+    if (result.has_value()) {
+        log_i(linting, "Reusing lint result for identical code");
     }
-
-    err = nutc::pywrapper::run_initialization();
-    if (err.has_value()) {
-        log_e(linting, "{}", err.value());
-        nutc::client::set_lint_result(uid, algo_id, false);
-        nutc::client::set_lint_failure(uid, algo_id, err.value());
-        return err.value();
+    else {
+        // Run in a child so that runaway code can't take the worker down with it
+        sandbox::SandboxResult sandboxed = sandbox::run(sandbox::default_limits(), [&] {
+            return lint_code(algoCode.value(), backtest);
+        });
+        result = sandboxed.result;
+        if (sandboxed.completed && !backtest.has_value())
+            cache.put("2", algoCode.value(), result.value());
+        result->message += "\n" + sandboxed.usage.to_string();
     }
 
-    err = nutc::pywrapper::trigger_callbacks();
-    if (err.has_value()) {
-        log_e(linting, "{}", err.value());
+    if (!result->succeeded) {
+        log_e(linting, "{}", result->message);
         nutc::client::set_lint_result(uid, algo_id, false);
-        nutc::client::set_lint_failure(uid, algo_id, err.value());
-        return err.value();
+        nutc::client::set_lint_failure(uid, algo_id, result->message);
+        return result->message;
     }
 
     nutc::client::set_lint_result(uid, algo_id, true);
 
-    return "Lint succeeded!";
+    return result->message;
 }
 } // namespace lint_track_two
 } // namespace nutc
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "backtest/backtest.hpp"
 #include "firebase/fetching.hpp"
+#include "lint_cache/lint_cache.hpp"
 #include "mock_api/mock_api.hpp"
 #include "pywrapper/runtime.hpp"
+#include "sandbox/sandbox.hpp"
 
 #include <pybind11/pybind11.h>
 
@@ -11,7 +14,16 @@
 namespace nutc {
 namespace lint_track_two {
 
-[[nodiscard]] std::string lint(const std::string& uid, const std::string& algo_id);
+/**
+ * @param backtest If set, strategies that lint cleanly are also backtested, and fail
+ * if their callbacks are too slow
+ */
+[[nodiscard]] std::string lint(
+    const std::string& uid,
+    const std::string& algo_id,
+    lint_cache::LintCache& cache,
+    const std::optional<backtest::BacktestOptions>& backtest
+);
 
 } // namespace lint_track_two
 } // namespace nutc
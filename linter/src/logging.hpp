@@ -2,6 +2,7 @@
 
 #include "config.h"
 
+#include <fmt/format.h>
 #include <quill/Quill.h>
 
 #include <string>
@@ -36,8 +37,26 @@ get_logger(const std::string& name)
     return logger;
 }
 
+using Forwarder =
+    void (*)(quill::LogLevel level, const char* category, const std::string& message);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+inline Forwarder forwarder = nullptr;
+
 } // namespace detail
 
+/**
+ * Hand every later log record to forwarder instead of quill.
+ *
+ * For forked children: quill's backend thread does not survive the fork, so records
+ * logged through quill there are never written.
+ */
+inline void
+forward_logs(detail::Forwarder forwarder)
+{
+    detail::forwarder = forwarder;
+}
+
 /**
  * Set our thread name.
  */
@@ -48,15 +67,18 @@ set_thread_name(const std::string& name)
 }
 
 /**
- * Set up logging.
+ * Set up logging to the console and to the rotating log_file.
  */
-void init(quill::LogLevel log_level = DEFAULT_LOG_LEVEL);
+void init(
+    quill::LogLevel log_level = DEFAULT_LOG_LEVEL,
+    const std::string& log_file = LOG_FILE
+);
 
 /**
- * Set up logging.
+ * Set up logging to the console and to the rotating log_file.
  */
 inline void
-init(uint8_t verbosity = 0)
+init(uint8_t verbosity = 0, const std::string& log_file = LOG_FILE)
 {
     auto log_level = static_cast<uint8_t>(DEFAULT_LOG_LEVEL);
 
@@ -65,7 +87,7 @@ init(uint8_t verbosity = 0)
     else // protect from underflow
         log_level = 0;
 
-    init(static_cast<quill::LogLevel>(log_level));
+    init(static_cast<quill::LogLevel>(log_level), log_file);
 }
 
 /******************************************************************************
@@ -99,6 +121,7 @@ CREATE_LOG_CATEGORY(web);
 CREATE_LOG_CATEGORY(libcurl);
 CREATE_LOG_CATEGORY(rabbitmq);
 CREATE_LOG_CATEGORY(firebase);
+CREATE_LOG_CATEGORY(backtest);
 
 #undef CREATE_LOG_CATEGORY
 // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
@@ -110,27 +133,40 @@ CREATE_LOG_CATEGORY(firebase);
 #define log_bt(category, ...)                                                          \
     LOG_BACKTRACE(nutc::logging::get_##category##_logger(), __VA_ARGS__)
 
+// Records below the log level are dropped before formatting, as quill does
+#define NUTC_LOG(category, level, quill_macro, ...)                                    \
+    do {                                                                               \
+        if (nutc::logging::detail::forwarder == nullptr) {                             \
+            quill_macro(nutc::logging::get_##category##_logger(), __VA_ARGS__);        \
+        }                                                                              \
+        else if (level >= nutc::logging::detail::application_log_level) {              \
+            nutc::logging::detail::forwarder(                                          \
+                level, #category, fmt::format(__VA_ARGS__)                             \
+            );                                                                         \
+        }                                                                              \
+    } while (0)
+
 #define log_t3(category, ...)                                                          \
-    LOG_TRACE_L3(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::TraceL3, LOG_TRACE_L3, __VA_ARGS__)
 
 #define log_t2(category, ...)                                                          \
-    LOG_TRACE_L2(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::TraceL2, LOG_TRACE_L2, __VA_ARGS__)
 
 #define log_t1(category, ...)                                                          \
-    LOG_TRACE_L1(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::TraceL1, LOG_TRACE_L1, __VA_ARGS__)
 
 #define log_d(category, ...)                                                           \
-    LOG_DEBUG(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::Debug, LOG_DEBUG, __VA_ARGS__)
 
 #define log_i(category, ...)                                                           \
-    LOG_INFO(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::Info, LOG_INFO, __VA_ARGS__)
 
 #define log_w(category, ...)                                                           \
-    LOG_WARNING(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::Warning, LOG_WARNING, __VA_ARGS__)
 
 #define log_e(category, ...)                                                           \
-    LOG_ERROR(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::Error, LOG_ERROR, __VA_ARGS__)
 
 #define log_c(category, ...)                                                           \
-    LOG_CRITICAL(nutc::logging::get_##category##_logger(), __VA_ARGS__)
+    NUTC_LOG(category, quill::LogLevel::Critical, LOG_CRITICAL, __VA_ARGS__)
 // NOLINTEND
@@ -1,20 +1,34 @@
 #define CROW_MAIN
 #include "common.hpp"
 #include "git.h"
+#include "jobs/jobs.hpp"
 #include "lint_track_one/lint.hpp"
 #include "lint_track_two/lint.hpp"
 #include "thread_safe_queue/tsq.hpp"
+#include "worker_pool/worker_pool.hpp"
 
 #include <argparse/argparse.hpp>
 #include <crow/app.h>
 
 #include <algorithm>
+#include <chrono>
+#include <csignal>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <thread>
-#include <tuple>
+#include <vector>
 
-static std::tuple<uint8_t>
+struct LinterArguments {
+    uint8_t verbosity;
+    size_t num_workers;
+    // Set when this process is one of the server's lint workers
+    std::optional<size_t> worker_index;
+    // Set if track two submissions should also be backtested
+    std::optional<nutc::backtest::BacktestOptions> backtest;
+};
+
+static LinterArguments
 process_arguments(int argc, const char** argv)
 {
     argparse::ArgumentParser program(
@@ -31,6 +45,33 @@ process_arguments(int argc, const char** argv)
         .implicit_value(true)
         .nargs(0);
 
+    program.add_argument("-w", "--workers")
+        .help("number of algorithms to lint in parallel")
+        .default_value(static_cast<size_t>(LINT_WORKER_COUNT))
+        .scan<'u', size_t>();
+
+    program.add_argument("--worker")
+        .help("run as the server's lint worker with this index (internal)")
+        .scan<'u', size_t>();
+
+    program.add_argument("-B", "--backtest")
+        .help(
+            "also backtest track two algorithms through NUTC24-backtest (development "
+            "only: the Docker image does not ship it)"
+        )
+        .default_value(false)
+        .implicit_value(true)
+        .nargs(0);
+
+    program.add_argument("--backtest-steps")
+        .help("number of market steps each backtest runs for")
+        .default_value(BACKTEST_STEPS)
+        .scan<'i', int>();
+
+    program.add_argument("--backtester")
+        .help("path to the NUTC24-backtest binary")
+        .default_value(std::string(BACKTEST_BINARY));
+
     uint8_t verbosity = 0;
     program.add_argument("-v", "--verbose")
         .help("increase output verbosity")
@@ -48,7 +89,19 @@ process_arguments(int argc, const char** argv)
         exit(1); // NOLINT(concurrency-*)
     }
 
-    return std::make_tuple(verbosity);
+    LinterArguments args{
+        verbosity,
+        std::max<size_t>(program.get<size_t>("--workers"), 1),
+        program.present<size_t>("--worker"),
+        std::nullopt
+    };
+    if (program.get<bool>("--backtest")) {
+        args.backtest = nutc::backtest::BacktestOptions{
+            program.get<std::string>("--backtester"),
+            std::max(program.get<int>("--backtest-steps"), 1)
+        };
+    }
+    return args;
 }
 
 static void
@@ -65,20 +118,107 @@ log_build_info()
         log_w(main, "Built from dirty commit!");
 }
 
+// Lint results are cached per build. Builds with uncommitted changes all share their
+// commit's results, so clear LINT_CACHE_DIR after changing the linter locally
+static std::string
+linter_version()
+{
+    std::string version = git_CommitSHA1();
+    if (git_AnyUncommittedChanges())
+        version += "-dirty";
+    return version;
+}
+
+static std::string
+lint_submission(
+    nutc::lint_cache::LintCache& cache,
+    const std::optional<nutc::backtest::BacktestOptions>& backtest,
+    const nutc::worker_pool::Submission& submission
+)
+{
+    pybind11::exec("locals().clear()");
+
+    const auto& [uid, algo_id, task] = submission;
+    log_i(main, "Linting algo_id: {} for user: {} on task {}", algo_id, uid, task);
+    if (task == 1) {
+        log_i(main, "linting for track one");
+        return nutc::lint_track_one::lint(uid, algo_id, cache);
+    }
+    log_i(main, "linting for track two");
+    return nutc::lint_track_two::lint(uid, algo_id, cache, backtest);
+}
+
+static void
+handle_lint_result(
+    nutc::jobs::JobTable& jobs,
+    const nutc::worker_pool::LintJob& job,
+    const nutc::worker_pool::LintOutcome& outcome
+)
+{
+    const auto& [uid, algo_id, task] = job.submission;
+    if (!outcome.completed) {
+        nutc::client::set_lint_result(uid, algo_id, false);
+        nutc::client::set_lint_failure(uid, algo_id, outcome.message);
+    }
+    nutc::client::set_lint_success(uid, algo_id, outcome.message + "\n");
+    jobs.finish(job.id, outcome.message, outcome.completed);
+}
+
+static crow::json::wvalue
+job_to_json(const std::string& id, const nutc::jobs::Job& job)
+{
+    crow::json::wvalue json;
+    json["job_id"] = id;
+    json["uid"] = job.uid;
+    json["algo_id"] = job.algo_id;
+    json["task"] = job.task;
+    json["state"] = nutc::jobs::to_string(job.state);
+    json["message"] = job.message;
+    return json;
+}
+
 int
 main(int argc, const char** argv)
 {
     // Parse args
-    auto [verbosity] = process_arguments(argc, argv);
+    auto [verbosity, num_workers, worker_index, backtest] =
+        process_arguments(argc, argv);
+
+    // A worker that died mid-lint fails the write to it instead of killing the
+    // server. Workers and their lints inherit this
+    std::signal(SIGPIPE, SIG_IGN);
 
     // Start logging and print build info
-    nutc::logging::init(verbosity);
+    std::string log_file = worker_index.has_value()
+                               ? fmt::format(WORKER_LOG_FILE, worker_index.value())
+                               : LOG_FILE;
+    nutc::logging::init(verbosity, log_file);
+
+    if (worker_index.has_value()) {
+        pybind11::initialize_interpreter();
+        nutc::lint_cache::LintCache cache(
+            LINT_CACHE_DIR,
+            LINT_CACHE_MEMORY_ENTRIES,
+            linter_version()
+        );
+        int code = nutc::worker_pool::serve_worker(
+            [&](const nutc::worker_pool::Submission& submission) {
+                return lint_submission(cache, backtest, submission);
+            }
+        );
+        pybind11::finalize_interpreter();
+        return code;
+    }
+
     log_build_info();
-    log_i(main, "Starting NUTC Linter");
+    log_i(main, "Starting NUTC Linter with {} workers", num_workers);
 
-    nutc::tsq::ThreadSafeQueue<std::tuple<std::string, std::string, int>> queue;
+    nutc::tsq::ThreadSafeQueue<nutc::worker_pool::LintJob> queue(
+        LINT_QUEUE_CAPACITY
+    );
+    nutc::jobs::JobTable jobs(LINT_FINISHED_JOBS_KEPT);
 
-    std::thread server_thread([&queue]() {
+    std::thread server_thread([&queue, &jobs]() {
         crow::SimpleApp app;
         CROW_ROUTE(app, "/")
         ([&](const crow::request& req) {
@@ -112,40 +252,61 @@ main(int argc, const char** argv)
 
             std::string uid = req.url_params.get("uid");
             std::string algo_id = req.url_params.get("algo_id");
-            queue.push(std::make_tuple(uid, algo_id, task));
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            return crow::response();
+            // Created first so a worker that finishes immediately has a job to update
+            std::string job_id = jobs.create(uid, algo_id, task);
+            nutc::worker_pool::LintJob job{job_id, std::make_tuple(uid, algo_id, task)};
+            if (!queue.try_push(std::move(job))) {
+                log_w(main, "Lint queue is full, rejecting algo_id {}", algo_id);
+                jobs.erase(job_id);
+                return crow::response(429);
+            }
+
+            crow::json::wvalue body;
+            body["job_id"] = job_id;
+            return crow::response(std::move(body));
         });
+
+        CROW_ROUTE(app, "/status/<string>")
+        ([&](const std::string& job_id) {
+            std::optional<nutc::jobs::Job> job = jobs.get(job_id);
+            if (!job.has_value())
+                return crow::response(404);
+            return crow::response(job_to_json(job_id, job.value()));
+        });
+
         app.port(8080).run();
     });
 
-    pybind11::initialize_interpreter();
-
-    while (true) {
-        std::optional<std::tuple<std::string, std::string, int>> submission = queue.pop();
-        if (!submission) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            continue;
-        }
-        pybind11::exec("locals().clear()");
-
-        std::string uid = std::get<0>(submission.value());
-        std::string algo_id = std::get<1>(submission.value());
-        int task = std::get<2>(submission.value());
-        log_i(main, "Linting algo_id: {} for user: {} on task {}", algo_id, uid, task);
-        std::string response;
-        if (task == 1) {
-            log_i(main, "linting for track one");
-            response = nutc::lint_track_one::lint(uid, algo_id);
-        } else {
-            log_i(main, "linting for track two");
-            response = nutc::lint_track_two::lint(uid, algo_id);
-        }
-
-        nutc::client::set_lint_success(uid, algo_id, response + "\n");
+    // Workers inherit the verbosity; each one lints in its own interpreter. The pool
+    // appends each worker's index after --worker
+    std::vector<std::string> worker_args{"NUTC-linter"};
+    for (uint8_t i = 0; i < verbosity; i++)
+        worker_args.emplace_back("-v");
+    if (backtest.has_value()) {
+        worker_args.insert(
+            worker_args.end(),
+            {"--backtest",
+             "--backtest-steps",
+             std::to_string(backtest->steps),
+             "--backtester",
+             backtest->binary}
+        );
     }
-    pybind11::finalize_interpreter();
+    worker_args.emplace_back("--worker");
+
+    // Blocks for the lifetime of the server
+    nutc::worker_pool::WorkerPool pool(
+        num_workers,
+        std::chrono::seconds(LINT_TIMEOUT_SECS),
+        queue,
+        std::move(worker_args),
+        [&jobs](const nutc::worker_pool::LintJob& job) { jobs.set_linting(job.id); },
+        [&jobs](
+            const nutc::worker_pool::LintJob& job,
+            const nutc::worker_pool::LintOutcome& outcome
+        ) { handle_lint_result(jobs, job, outcome); }
+    );
 
     server_thread.join();
 
@@ -2,18 +2,29 @@
 
 namespace nutc {
 namespace mock_api {
-std::function<bool(const std::string&, const std::string&, float, float)>
+std::function<bool(
+    const std::string&,
+    const std::string&,
+    float,
+    float,
+    const std::string&,
+    const std::string&
+)>
 
 getMarketFunc()
 {
     return [](const std::string& side,
               const std::string& ticker,
               float quantity,
-              float price) {
+              float price,
+              const std::string& order_type,
+              const std::string& time_in_force) {
         log_i(
             mock_api,
-            "Mock API: Placing order side {} ticker {} quantity {} price "
+            "Mock API: Placing {} {} order side {} ticker {} quantity {} price "
             "{}",
+            order_type,
+            time_in_force,
             side,
             ticker,
             quantity,
@@ -2,13 +2,21 @@
 
 #include "logging.hpp"
 
+#include <functional>
 #include <iostream>
 #include <string>
 
 namespace nutc {
 namespace mock_api {
 
-std::function<bool(const std::string&, const std::string&, float, float)>
+std::function<bool(
+    const std::string&,
+    const std::string&,
+    float,
+    float,
+    const std::string&,
+    const std::string&
+)>
 getMarketFunc();
 }
 } // namespace nutc
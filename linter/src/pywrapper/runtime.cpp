@@ -6,10 +6,7 @@ namespace nutc {
 namespace pywrapper {
 
 bool
-create_api_module(
-    std::function<bool(const std::string&, const std::string&, float, float)>
-        publish_market_order
-)
+create_api_module(PlaceOrderFunction publish_market_order)
 {
     try {
         py::module m = py::module::create_extension_module(
@@ -38,8 +35,12 @@ import_py_code(const std::string& code)
         return fmt::format("Failed to import code: {}", e.what());
     }
     py::exec(R"(
-        def place_market_order(side, ticker, quantity, price):
-            nutc_api.publish_market_order(side, ticker, quantity, price))");
+        def place_market_order(
+            side, ticker, quantity, price, order_type="LIMIT", time_in_force="GTC"
+        ):
+            return nutc_api.publish_market_order(
+                side, ticker, quantity, price, order_type, time_in_force
+            ))");
 
     return std::nullopt;
 }
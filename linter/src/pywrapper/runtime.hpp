@@ -10,10 +10,20 @@
 
 namespace nutc {
 namespace pywrapper {
-[[nodiscard]] bool create_api_module(
-    std::function<bool(const std::string&, const std::string&, float, float)>
-        publish_market_order
-);
+/**
+ * @brief Takes side, ticker, quantity, price, order type and time in force, as
+ * given to place_market_order
+ */
+using PlaceOrderFunction = std::function<bool(
+    const std::string&,
+    const std::string&,
+    float,
+    float,
+    const std::string&,
+    const std::string&
+)>;
+
+[[nodiscard]] bool create_api_module(PlaceOrderFunction publish_market_order);
 [[nodiscard]] std::optional<std::string> import_py_code(const std::string& code);
 
 [[nodiscard]] std::optional<std::string> run_initialization();
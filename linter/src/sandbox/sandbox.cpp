@@ -0,0 +1,291 @@
+#include "sandbox.hpp"
+
+#include "config.h"
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pybind11/embed.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <optional>
+
+namespace nutc {
+namespace sandbox {
+
+using steady_clock = std::chrono::steady_clock;
+
+Limits
+default_limits()
+{
+    return {
+        std::chrono::seconds(LINT_WALL_LIMIT_SECS),
+        LINT_CPU_LIMIT_SECS,
+        size_t{LINT_MEMORY_LIMIT_MB} * 1024 * 1024
+    };
+}
+
+std::string
+ResourceUsage::to_string() const
+{
+    return fmt::format(
+        "Used {:.2f}s of CPU over {:.2f}s, peaking at {:.1f} MB of memory",
+        cpu_seconds,
+        wall_seconds,
+        static_cast<double>(peak_rss_kb) / 1024
+    );
+}
+
+static void
+apply_limits(const Limits& limits)
+{
+    if (limits.cpu_seconds > 0) {
+        // SIGXCPU at the soft limit, SIGKILL a second later if it is ignored
+        rlimit cpu{limits.cpu_seconds, limits.cpu_seconds + 1};
+        setrlimit(RLIMIT_CPU, &cpu);
+    }
+    if (limits.memory_bytes > 0) {
+        rlimit memory{limits.memory_bytes, limits.memory_bytes};
+        setrlimit(RLIMIT_AS, &memory);
+    }
+}
+
+static void
+write_all(int fd, const std::string& data)
+{
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t bytes = write(fd, data.data() + written, data.size() - written);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            return;
+        written += static_cast<size_t>(bytes);
+    }
+}
+
+// The child sends frames down the pipe: a tag, the payload size and a newline, then
+// the payload. Log records are tagged with their level's digit, and the result 'R'
+static constexpr char RESULT_TAG = 'R';
+
+// The pipe to the parent, in the child
+static int child_fd = -1;
+
+static void
+write_frame(int fd, char tag, const std::string& payload)
+{
+    write_all(fd, fmt::format("{}{}\n{}", tag, payload.size(), payload));
+}
+
+static void
+forward_log(quill::LogLevel level, const char* category, const std::string& message)
+{
+    write_frame(
+        child_fd,
+        static_cast<char>('0' + static_cast<int>(level)),
+        fmt::format("{}: {}", category, message)
+    );
+}
+
+// The result payload is a 1 or 0 for whether the lint succeeded, then the message
+[[noreturn]] static void
+run_child(const Limits& limits, const LintFunction& lint, int fd)
+{
+    child_fd = fd;
+    logging::forward_logs(forward_log);
+    apply_limits(limits);
+
+    lint_cache::LintResult result;
+    try {
+        result = lint();
+    } catch (const std::exception& e) {
+        result = {false, fmt::format("Unexpected error while linting: {}", e.what())};
+    }
+
+    // The algorithm may have changed it, and a parent that gave up on the lint
+    // should fail the write rather than kill the child with SIGPIPE
+    std::signal(SIGPIPE, SIG_IGN);
+    write_frame(fd, RESULT_TAG, (result.succeeded ? "1" : "0") + result.message);
+    close(fd);
+    // Skips interpreter teardown; the parent still owns the real one
+    _exit(0);
+}
+
+static void
+replay_log(char tag, const std::string& record)
+{
+    auto level = static_cast<quill::LogLevel>(tag - '0');
+    if (level <= quill::LogLevel::Debug)
+        log_d(linting, "Sandbox: {}", record);
+    else if (level == quill::LogLevel::Info)
+        log_i(linting, "Sandbox: {}", record);
+    else if (level == quill::LogLevel::Warning)
+        log_w(linting, "Sandbox: {}", record);
+    else
+        log_e(linting, "Sandbox: {}", record);
+}
+
+// Removes the frames at the front of buffer, replaying logs and keeping the result
+static void
+take_frames(std::string& buffer, std::string& result)
+{
+    size_t offset = 0;
+    while (true) {
+        size_t newline = buffer.find('\n', offset);
+        if (newline == std::string::npos)
+            break;
+
+        size_t size = 0;
+        const char* size_end = buffer.data() + newline;
+        bool valid = newline - offset >= 2;
+        if (valid) {
+            auto [end, err] =
+                std::from_chars(buffer.data() + offset + 1, size_end, size);
+            valid = err == std::errc{} && end == size_end;
+        }
+        if (!valid) {
+            // Not something the child sent, so nothing after it can be trusted
+            buffer.clear();
+            return;
+        }
+        if (buffer.size() - (newline + 1) < size)
+            break;
+
+        char tag = buffer[offset];
+        std::string payload = buffer.substr(newline + 1, size);
+        if (tag == RESULT_TAG)
+            result = std::move(payload);
+        else
+            replay_log(tag, payload);
+        offset = newline + 1 + size;
+    }
+    buffer.erase(0, offset);
+}
+
+// Reads until EOF, giving up at the deadline, and returns the child's result payload
+// or an empty string if it sent none
+static std::optional<std::string>
+read_output(int fd, steady_clock::time_point deadline)
+{
+    std::string buffer;
+    std::string result;
+    char chunk[4096];
+    while (true) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - steady_clock::now()
+        );
+        pollfd readable{fd, POLLIN, 0};
+        if (remaining.count() <= 0
+            || poll(&readable, 1, static_cast<int>(remaining.count())) <= 0) {
+            return std::nullopt;
+        }
+
+        ssize_t bytes = read(fd, chunk, sizeof(chunk));
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            return result;
+        buffer.append(chunk, static_cast<size_t>(bytes));
+        take_frames(buffer, result);
+    }
+}
+
+static std::string
+describe_failure(const Limits& limits, int status, bool timed_out)
+{
+    if (timed_out) {
+        return fmt::format(
+            "Linting took longer than the {} second limit", limits.wall_time.count()
+        );
+    }
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU) {
+        return fmt::format(
+            "Linting used more than the {} second CPU time limit", limits.cpu_seconds
+        );
+    }
+    if (WIFSIGNALED(status)) {
+        return fmt::format(
+            "Your algorithm crashed the linter (signal {}). If the memory limit of {} "
+            "MB was hit, try using less memory",
+            WTERMSIG(status),
+            limits.memory_bytes / (1024 * 1024)
+        );
+    }
+    return fmt::format(
+        "Your algorithm exited the linter early with code {}", WEXITSTATUS(status)
+    );
+}
+
+SandboxResult
+run(const Limits& limits, const LintFunction& lint)
+{
+    SandboxResult sandbox_result{{false, ""}, {0, 0, 0}, false};
+
+    int result_pipe[2];
+    if (pipe2(result_pipe, O_CLOEXEC) != 0) {
+        sandbox_result.result.message = "Unexpected error: failed to start linting";
+        return sandbox_result;
+    }
+
+    auto start = steady_clock::now();
+    // The interpreter's locks have to be in a sane state in the child
+    PyOS_BeforeFork();
+    pid_t pid = fork();
+    if (pid == 0) {
+        PyOS_AfterFork_Child();
+        close(result_pipe[0]);
+        run_child(limits, lint, result_pipe[1]);
+    }
+    PyOS_AfterFork_Parent();
+    close(result_pipe[1]);
+
+    if (pid < 0) {
+        close(result_pipe[0]);
+        sandbox_result.result.message = "Unexpected error: failed to start linting";
+        return sandbox_result;
+    }
+
+    std::optional<std::string> output =
+        read_output(result_pipe[0], start + limits.wall_time);
+    close(result_pipe[0]);
+
+    bool timed_out = !output.has_value();
+    if (timed_out)
+        kill(pid, SIGKILL);
+
+    int status = 0;
+    rusage usage{};
+    while (wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {}
+
+    auto to_seconds = [](timeval time) {
+        return std::chrono::duration<double>(
+                   std::chrono::seconds(time.tv_sec)
+                   + std::chrono::microseconds(time.tv_usec)
+        )
+            .count();
+    };
+    sandbox_result.usage = {
+        to_seconds(usage.ru_utime) + to_seconds(usage.ru_stime),
+        std::chrono::duration<double>(steady_clock::now() - start).count(),
+        usage.ru_maxrss
+    };
+
+    bool exited_cleanly = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (timed_out || !exited_cleanly || output->empty()) {
+        sandbox_result.result.message = describe_failure(limits, status, timed_out);
+        log_w(linting, "{}", sandbox_result.result.message);
+        return sandbox_result;
+    }
+
+    sandbox_result.result = {output->front() == '1', output->substr(1)};
+    sandbox_result.completed = true;
+    return sandbox_result;
+}
+
+} // namespace sandbox
+} // namespace nutc
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "lint_cache/lint_cache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace nutc {
+
+/**
+ * @brief Runs untrusted algorithm code in a forked child under resource limits
+ *
+ * The child inherits the interpreter as it was at the fork, so anything the code
+ * does to it is thrown away afterwards. Its log records are sent back to the parent
+ * and logged there
+ */
+namespace sandbox {
+
+struct Limits {
+    std::chrono::seconds wall_time;
+    // 0 is unlimited
+    size_t cpu_seconds;
+    size_t memory_bytes;
+};
+
+// The LINT_*_LIMIT_* values from the config
+Limits default_limits();
+
+struct ResourceUsage {
+    double cpu_seconds;
+    double wall_seconds;
+    long peak_rss_kb;
+
+    [[nodiscard]] std::string to_string() const;
+};
+
+using LintFunction = std::function<lint_cache::LintResult()>;
+
+struct SandboxResult {
+    lint_cache::LintResult result;
+    ResourceUsage usage;
+    // True if the child exited cleanly with the lint's verdict. Otherwise result says
+    // how this run failed, e.g. a time limit hit on a busy machine, which may not
+    // happen again
+    bool completed;
+};
+
+/**
+ * @brief Runs lint in a child process and waits for it, up to the wall time limit
+ * @returns What lint returned, or a failed result describing which limit the child
+ * hit or how it died
+ */
+SandboxResult run(const Limits& limits, const LintFunction& lint);
+
+} // namespace sandbox
+} // namespace nutc
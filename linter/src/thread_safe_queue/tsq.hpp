@@ -1,23 +1,142 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <mutex>
 #include <optional>
-#include <queue>
-#include <string>
+#include <vector>
 
 namespace nutc {
 namespace tsq {
 
+/**
+ * @brief Bounded multi-producer multi-consumer queue
+ *
+ * Consumers block until there is something to pop instead of polling. Producers
+ * either block while the queue is full or use try_push and push back on the caller
+ */
 template <typename T>
 class ThreadSafeQueue {
 private:
-    std::queue<T> queue;
-    std::mutex mtx;
+    std::deque<T> queue;
+    const size_t capacity;
+    mutable std::mutex mtx;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+
+    T
+    pop_front()
+    {
+        T value = std::move(queue.front());
+        queue.pop_front();
+        return value;
+    }
 
 public:
-    void push(const T& value);
+    explicit ThreadSafeQueue(size_t capacity) : capacity(capacity) {}
+
+    // Blocks while the queue is full
+    void
+    push(T value)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            not_full.wait(lock, [this] { return queue.size() < capacity; });
+            queue.push_back(std::move(value));
+        }
+        not_empty.notify_one();
+    }
+
+    // Returns false without taking the value if the queue is full
+    [[nodiscard]] bool
+    try_push(T&& value)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (queue.size() >= capacity)
+                return false;
+            queue.push_back(std::move(value));
+        }
+        not_empty.notify_one();
+        return true;
+    }
+
+    // Blocks until there is a value to pop
+    T
+    pop()
+    {
+        T value = [this] {
+            std::unique_lock<std::mutex> lock(mtx);
+            not_empty.wait(lock, [this] { return !queue.empty(); });
+            return pop_front();
+        }();
+        not_full.notify_one();
+        return value;
+    }
+
+    std::optional<T>
+    try_pop()
+    {
+        std::optional<T> value;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (queue.empty())
+                return std::nullopt;
+            value.emplace(pop_front());
+        }
+        not_full.notify_one();
+        return value;
+    }
 
-    std::optional<T> pop();
+    // Gives up if nothing was pushed within the timeout
+    template <typename Rep, typename Period>
+    std::optional<T>
+    pop_for(std::chrono::duration<Rep, Period> timeout)
+    {
+        std::optional<T> value;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            if (!not_empty.wait_for(lock, timeout, [this] { return !queue.empty(); }))
+                return std::nullopt;
+            value.emplace(pop_front());
+        }
+        not_full.notify_one();
+        return value;
+    }
+
+    /**
+     * @brief Blocks until there is at least one value, then pops up to max_values
+     * under a single lock
+     */
+    std::vector<T>
+    drain(size_t max_values)
+    {
+        std::vector<T> values;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            not_empty.wait(lock, [this] { return !queue.empty(); });
+            while (!queue.empty() && values.size() < max_values)
+                values.push_back(pop_front());
+        }
+        not_full.notify_all();
+        return values;
+    }
+
+    size_t
+    size() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return queue.size();
+    }
+
+    size_t
+    max_size() const
+    {
+        return capacity;
+    }
 };
+
 } // namespace tsq
 } // namespace nutc
@@ -0,0 +1,281 @@
+#include "worker_pool.hpp"
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+
+namespace nutc {
+namespace worker_pool {
+
+// Where a worker finds its pipes to the server
+static constexpr int WORKER_JOB_FD = 3;
+static constexpr int WORKER_RESULT_FD = 4;
+
+using steady_clock = std::chrono::steady_clock;
+
+static bool
+write_all(int fd, const char* data, size_t size)
+{
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Reads exactly size bytes, giving up at the deadline (if any)
+static bool
+read_all(
+    int fd,
+    char* data,
+    size_t size,
+    std::optional<steady_clock::time_point> deadline
+)
+{
+    while (size > 0) {
+        if (deadline.has_value()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline.value() - steady_clock::now()
+            );
+            pollfd readable{fd, POLLIN, 0};
+            if (remaining.count() <= 0
+                || poll(&readable, 1, static_cast<int>(remaining.count())) <= 0) {
+                return false;
+            }
+        }
+
+        ssize_t bytes = read(fd, data, size);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            return false;
+        data += bytes;
+        size -= static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+// Messages are a 4 byte length followed by the contents
+static bool
+write_message(int fd, const std::string& message)
+{
+    auto size = static_cast<uint32_t>(message.size());
+    return write_all(fd, reinterpret_cast<const char*>(&size), sizeof(size))
+           && write_all(fd, message.data(), message.size());
+}
+
+static std::optional<std::string>
+read_message(int fd, std::optional<steady_clock::time_point> deadline = std::nullopt)
+{
+    uint32_t size = 0;
+    if (!read_all(fd, reinterpret_cast<char*>(&size), sizeof(size), deadline))
+        return std::nullopt;
+
+    std::string message(size, '\0');
+    if (!read_all(fd, message.data(), size, deadline))
+        return std::nullopt;
+    return message;
+}
+
+static std::string
+encode_submission(const Submission& submission)
+{
+    const auto& [uid, algo_id, task] = submission;
+    return fmt::format("{}\n{}\n{}", uid, algo_id, task);
+}
+
+static std::optional<Submission>
+decode_submission(const std::string& message)
+{
+    std::istringstream stream(message);
+    std::string uid;
+    std::string algo_id;
+    std::string task;
+    if (!std::getline(stream, uid) || !std::getline(stream, algo_id)
+        || !std::getline(stream, task)) {
+        return std::nullopt;
+    }
+    try {
+        return Submission{uid, algo_id, std::stoi(task)};
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+int
+serve_worker(const LintFunction& lint)
+{
+    // Nothing a lint starts should hold the server's pipes open
+    fcntl(WORKER_JOB_FD, F_SETFD, FD_CLOEXEC);
+    fcntl(WORKER_RESULT_FD, F_SETFD, FD_CLOEXEC);
+
+    while (true) {
+        std::optional<std::string> message = read_message(WORKER_JOB_FD);
+        if (!message.has_value()) {
+            // The server closed the pipe
+            return 0;
+        }
+
+        std::optional<Submission> submission = decode_submission(message.value());
+        if (!submission.has_value()) {
+            log_e(main, "Worker received a malformed submission");
+            return 1;
+        }
+
+        if (!write_message(WORKER_RESULT_FD, lint(submission.value()))) {
+            return 1;
+        }
+    }
+}
+
+WorkerPool::WorkerPool(
+    size_t num_workers,
+    std::chrono::seconds timeout,
+    tsq::ThreadSafeQueue<LintJob>& queue,
+    std::vector<std::string> worker_args,
+    StartHandler on_start,
+    ResultHandler on_result
+) :
+    timeout(timeout), queue(queue), worker_args(std::move(worker_args)),
+    on_start(std::move(on_start)), on_result(std::move(on_result))
+{
+    for (size_t i = 0; i < num_workers; i++)
+        threads.emplace_back([this, i] { supervise(i); });
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto& thread : threads)
+        thread.join();
+}
+
+bool
+WorkerPool::start_worker(Worker& worker, size_t index) const
+{
+    int job_pipe[2];
+    int result_pipe[2];
+    if (pipe2(job_pipe, O_CLOEXEC) != 0)
+        return false;
+    if (pipe2(result_pipe, O_CLOEXEC) != 0) {
+        close(job_pipe[0]);
+        close(job_pipe[1]);
+        return false;
+    }
+
+    // Built before forking; the child may only make async-signal-safe calls
+    std::vector<std::string> args = worker_args;
+    args.push_back(std::to_string(index));
+    std::vector<char*> c_args;
+    for (auto& arg : args)
+        c_args.push_back(arg.data());
+    c_args.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // dup2 clears close-on-exec, so only these two ends survive the exec. Both are
+        // first copied above the targets, since dup2 onto the same fd does nothing and
+        // one end may already sit where the other goes
+        int job_fd = fcntl(job_pipe[0], F_DUPFD_CLOEXEC, WORKER_RESULT_FD + 1);
+        int result_fd = fcntl(result_pipe[1], F_DUPFD_CLOEXEC, WORKER_RESULT_FD + 1);
+        dup2(job_fd, WORKER_JOB_FD);
+        dup2(result_fd, WORKER_RESULT_FD);
+        execv("/proc/self/exe", c_args.data());
+        _exit(127);
+    }
+
+    close(job_pipe[0]);
+    close(result_pipe[1]);
+    if (pid < 0) {
+        close(job_pipe[1]);
+        close(result_pipe[0]);
+        return false;
+    }
+
+    worker = Worker{pid, job_pipe[1], result_pipe[0]};
+    return true;
+}
+
+void
+WorkerPool::stop_worker(Worker& worker)
+{
+    if (worker.pid > 0) {
+        kill(worker.pid, SIGKILL);
+        waitpid(worker.pid, nullptr, 0);
+    }
+    close(worker.job_fd);
+    close(worker.result_fd);
+    worker = Worker{};
+}
+
+LintOutcome
+WorkerPool::run_lint(Worker& worker, const Submission& submission) const
+{
+    if (!write_message(worker.job_fd, encode_submission(submission))) {
+        stop_worker(worker);
+        return {"Linter crashed before running your algorithm", false};
+    }
+
+    std::optional<std::string> result =
+        read_message(worker.result_fd, steady_clock::now() + timeout);
+    if (result.has_value()) {
+        return {result.value(), true};
+    }
+
+    // Either timed out or died; the worker is replaced before the next lint
+    stop_worker(worker);
+    return {
+        fmt::format(
+            "Linting did not finish within {} seconds, or your algorithm crashed the "
+            "linter",
+            timeout.count()
+        ),
+        false
+    };
+}
+
+void
+WorkerPool::supervise(size_t index)
+{
+    // No Python state is shared with the rest of the server, so a worker is only
+    // ever replaced, never repaired
+    Worker worker;
+    while (true) {
+        LintJob job = queue.pop();
+        on_start(job);
+
+        if (worker.pid < 0 && !start_worker(worker, index)) {
+            log_e(main, "Failed to start lint worker {}", index);
+            on_result(job, {"Unexpected error: failed to start linter", false});
+            continue;
+        }
+
+        LintOutcome outcome = run_lint(worker, job.submission);
+        if (!outcome.completed) {
+            log_w(
+                main,
+                "Lint worker {} failed on algo {}: {}",
+                index,
+                std::get<1>(job.submission),
+                outcome.message
+            );
+        }
+        on_result(job, outcome);
+    }
+}
+
+} // namespace worker_pool
+} // namespace nutc
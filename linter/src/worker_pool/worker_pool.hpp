@@ -0,0 +1,100 @@
+#pragma once
+
+#include "thread_safe_queue/tsq.hpp"
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief Lints submissions in parallel, each worker in its own sandboxed process
+ *
+ * Every worker is a copy of the linter exec'd in worker mode, with its own
+ * interpreter. A thread in the server feeds it one submission at a time over a pipe
+ * and kills it if the lint runs past the timeout, so a misbehaving algorithm can
+ * neither crash the server nor hold up other submissions
+ */
+namespace worker_pool {
+
+// uid, algo_id, task
+using Submission = std::tuple<std::string, std::string, int>;
+
+// A submission queued for the pool, tagged with the job it belongs to
+struct LintJob {
+    std::string id;
+    Submission submission;
+};
+
+using LintFunction = std::function<std::string(const Submission&)>;
+
+struct LintOutcome {
+    std::string message;
+    // False if the worker timed out or died before producing a result
+    bool completed;
+};
+
+using StartHandler = std::function<void(const LintJob&)>;
+using ResultHandler = std::function<void(const LintJob&, const LintOutcome&)>;
+
+/**
+ * @brief Runs in a worker process: lints submissions from the server until it exits
+ * @returns The process exit code
+ */
+int serve_worker(const LintFunction& lint);
+
+class WorkerPool {
+public:
+    /**
+     * @param worker_args argv for starting a worker, to which the pool appends the
+     * worker's index; argv[0] is ignored and the running executable is used
+     * @param on_start Called from pool threads as a worker picks up each job
+     * @param on_result Called from pool threads as each lint finishes
+     */
+    WorkerPool(
+        size_t num_workers,
+        std::chrono::seconds timeout,
+        tsq::ThreadSafeQueue<LintJob>& queue,
+        std::vector<std::string> worker_args,
+        StartHandler on_start,
+        ResultHandler on_result
+    );
+
+    // Runs until the process exits
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+private:
+    struct Worker {
+        pid_t pid = -1;
+        // Submissions are written to job_fd, results read from result_fd
+        int job_fd = -1;
+        int result_fd = -1;
+    };
+
+    std::chrono::seconds timeout;
+    tsq::ThreadSafeQueue<LintJob>& queue;
+    std::vector<std::string> worker_args;
+    StartHandler on_start;
+    ResultHandler on_result;
+    std::vector<std::thread> threads;
+
+    [[nodiscard]] bool start_worker(Worker& worker, size_t index) const;
+    static void stop_worker(Worker& worker);
+    LintOutcome run_lint(Worker& worker, const Submission& submission) const;
+    void supervise(size_t index);
+};
+
+} // namespace worker_pool
+} // namespace nutc
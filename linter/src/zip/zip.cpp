@@ -0,0 +1,366 @@
+#include "zip.hpp"
+
+#include "config.h"
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string_view>
+
+namespace nutc {
+namespace zip {
+
+namespace {
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr size_t CENTRAL_HEADER_SIZE = 46;
+constexpr size_t END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+constexpr size_t MAX_COMMENT_SIZE = 0xFFFF;
+
+constexpr uint16_t METHOD_STORED = 0;
+constexpr uint16_t METHOD_DEFLATED = 8;
+constexpr uint16_t FLAG_ENCRYPTED = 0x1;
+
+// Every archive is read and written through buffers of this size
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+} // namespace
+
+Limits
+default_limits()
+{
+    return {LINT_ZIP_MAX_ENTRIES, uint64_t{LINT_ZIP_MAX_UNCOMPRESSED_MB} * 1024 * 1024};
+}
+
+bool
+Entry::is_directory() const
+{
+    return name.ends_with('/');
+}
+
+// Zip fields are little endian
+static uint16_t
+read_u16(const char* data)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t
+read_u32(const char* data)
+{
+    return uint32_t{read_u16(data)} | (uint32_t{read_u16(data + 2)} << 16);
+}
+
+static bool
+read_exactly(std::ifstream& file, char* buffer, size_t size)
+{
+    file.read(buffer, static_cast<std::streamsize>(size));
+    return file.gcount() == static_cast<std::streamsize>(size);
+}
+
+// Rejects names that would be written outside of the extraction directory
+static bool
+is_safe_name(std::string_view name)
+{
+    if (name.empty() || name.front() == '/' || name.find('\\') != name.npos
+        || name.find('\0') != name.npos) {
+        return false;
+    }
+    size_t start = 0;
+    while (start <= name.size()) {
+        size_t end = std::min(name.find('/', start), name.size());
+        if (name.substr(start, end - start) == "..")
+            return false;
+        start = end + 1;
+    }
+    return true;
+}
+
+std::optional<std::string>
+read_entries(
+    const std::filesystem::path& archive,
+    const Limits& limits,
+    std::vector<Entry>& entries
+)
+{
+    std::error_code err;
+    uint64_t archive_size = std::filesystem::file_size(archive, err);
+    if (err)
+        return fmt::format("Failed to read zip archive: {}", err.message());
+    std::ifstream file(archive, std::ios::binary);
+    if (!file)
+        return "Failed to open zip archive";
+
+    // The end of central directory record is followed only by a comment of up to
+    // 64 KB, so it is found by scanning back from the end
+    size_t tail_size = static_cast<size_t>(std::min<uint64_t>(
+        archive_size, END_OF_CENTRAL_DIRECTORY_SIZE + MAX_COMMENT_SIZE
+    ));
+    if (tail_size < END_OF_CENTRAL_DIRECTORY_SIZE)
+        return "Not a zip archive";
+    std::string tail(tail_size, '\0');
+    file.seekg(static_cast<std::streamoff>(archive_size - tail_size));
+    if (!read_exactly(file, tail.data(), tail_size))
+        return "Failed to read zip archive";
+
+    std::optional<size_t> record;
+    for (size_t pos = tail_size - END_OF_CENTRAL_DIRECTORY_SIZE + 1; pos-- > 0;) {
+        const char* candidate = tail.data() + pos;
+        if (read_u32(candidate) == END_OF_CENTRAL_DIRECTORY_SIGNATURE
+            && pos + END_OF_CENTRAL_DIRECTORY_SIZE + read_u16(candidate + 20)
+                   == tail_size) {
+            record = pos;
+            break;
+        }
+    }
+    if (!record.has_value())
+        return "Not a zip archive: no end of central directory record";
+
+    const char* eocd = tail.data() + record.value();
+    uint16_t disk = read_u16(eocd + 4);
+    uint16_t directory_disk = read_u16(eocd + 6);
+    uint16_t disk_entries = read_u16(eocd + 8);
+    uint16_t total_entries = read_u16(eocd + 10);
+    uint32_t directory_size = read_u32(eocd + 12);
+    uint32_t directory_offset = read_u32(eocd + 16);
+    uint64_t record_offset = archive_size - tail_size + record.value();
+
+    if (disk != 0 || directory_disk != 0 || disk_entries != total_entries)
+        return "Multi-part zip archives are not supported";
+    if (total_entries == 0xFFFF || directory_size == 0xFFFFFFFF
+        || directory_offset == 0xFFFFFFFF) {
+        return "ZIP64 archives are not supported";
+    }
+    if (total_entries > limits.max_entries) {
+        return fmt::format(
+            "Zip archive has {} entries, more than the limit of {}",
+            total_entries,
+            limits.max_entries
+        );
+    }
+    if (uint64_t{directory_offset} + directory_size > record_offset)
+        return "Corrupt zip archive: central directory is out of bounds";
+
+    entries.clear();
+    entries.reserve(total_entries);
+    uint64_t total_size = 0;
+    uint64_t position = directory_offset;
+    file.seekg(static_cast<std::streamoff>(position));
+    std::array<char, CENTRAL_HEADER_SIZE> header{};
+    for (uint16_t i = 0; i < total_entries; i++) {
+        if (position + CENTRAL_HEADER_SIZE > uint64_t{directory_offset} + directory_size
+            || !read_exactly(file, header.data(), CENTRAL_HEADER_SIZE)
+            || read_u32(header.data()) != CENTRAL_HEADER_SIGNATURE) {
+            return "Corrupt zip archive: bad central directory entry";
+        }
+
+        uint16_t flags = read_u16(header.data() + 8);
+        uint16_t name_length = read_u16(header.data() + 28);
+        uint16_t extra_length = read_u16(header.data() + 30);
+        uint16_t comment_length = read_u16(header.data() + 32);
+        Entry entry{
+            std::string(name_length, '\0'),
+            read_u16(header.data() + 10),
+            read_u32(header.data() + 16),
+            read_u32(header.data() + 20),
+            read_u32(header.data() + 24),
+            read_u32(header.data() + 42)
+        };
+        if (!read_exactly(file, entry.name.data(), name_length))
+            return "Corrupt zip archive: truncated central directory";
+        position +=
+            CENTRAL_HEADER_SIZE + name_length + extra_length + comment_length;
+        if (position > uint64_t{directory_offset} + directory_size)
+            return "Corrupt zip archive: truncated central directory";
+        file.seekg(extra_length + comment_length, std::ios::cur);
+
+        if (!is_safe_name(entry.name))
+            return fmt::format("Zip archive has an unsafe path: {}", entry.name);
+        if ((flags & FLAG_ENCRYPTED) != 0)
+            return fmt::format("Zip archive entry {} is encrypted", entry.name);
+        if (entry.method != METHOD_STORED && entry.method != METHOD_DEFLATED) {
+            return fmt::format(
+                "Zip archive entry {} uses unsupported compression method {}",
+                entry.name,
+                entry.method
+            );
+        }
+        if (entry.compressed_size == 0xFFFFFFFF
+            || entry.uncompressed_size == 0xFFFFFFFF) {
+            return "ZIP64 archives are not supported";
+        }
+        if (entry.local_header_offset + LOCAL_HEADER_SIZE + entry.compressed_size
+            > directory_offset) {
+            return fmt::format(
+                "Corrupt zip archive: data of {} is out of bounds", entry.name
+            );
+        }
+
+        total_size += entry.uncompressed_size;
+        if (total_size > limits.max_uncompressed_bytes) {
+            return fmt::format(
+                "Zip archive is larger than {} MB uncompressed",
+                limits.max_uncompressed_bytes / (1024 * 1024)
+            );
+        }
+        entries.push_back(std::move(entry));
+    }
+    return std::nullopt;
+}
+
+static size_t
+next_chunk(uint64_t remaining)
+{
+    return static_cast<size_t>(std::min<uint64_t>(remaining, CHUNK_SIZE));
+}
+
+// Streams the entry's data from file to out, setting crc to the checksum of it
+static std::optional<std::string>
+copy_data(std::ifstream& file, const Entry& entry, std::ofstream& out, uLong& crc)
+{
+    std::vector<char> input(CHUNK_SIZE);
+    uint64_t remaining = entry.compressed_size;
+    crc = crc32(0L, Z_NULL, 0);
+
+    if (entry.method == METHOD_STORED) {
+        if (entry.compressed_size != entry.uncompressed_size)
+            return fmt::format("Corrupt zip archive: bad size for {}", entry.name);
+        while (remaining > 0) {
+            size_t chunk = next_chunk(remaining);
+            if (!read_exactly(file, input.data(), chunk))
+                return "Corrupt zip archive: truncated data";
+            crc = crc32(crc, reinterpret_cast<const Bytef*>(input.data()), chunk);
+            out.write(input.data(), static_cast<std::streamsize>(chunk));
+            remaining -= chunk;
+        }
+        return std::nullopt;
+    }
+
+    // Raw deflate; the zip headers replace zlib's own
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+        return "Failed to start inflating zip archive";
+    std::vector<char> output(CHUNK_SIZE);
+    uint64_t written = 0;
+    int status = Z_OK;
+    // inflate can have more output pending even once all the input is consumed
+    bool output_full = false;
+    std::optional<std::string> error;
+    while (status != Z_STREAM_END && !error.has_value()) {
+        if (stream.avail_in == 0 && !output_full) {
+            if (remaining == 0) {
+                error = fmt::format(
+                    "Corrupt zip archive: truncated data for {}", entry.name
+                );
+                break;
+            }
+            size_t chunk = next_chunk(remaining);
+            if (!read_exactly(file, input.data(), chunk)) {
+                error = "Corrupt zip archive: truncated data";
+                break;
+            }
+            remaining -= chunk;
+            stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            stream.avail_in = static_cast<uInt>(chunk);
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        status = inflate(&stream, Z_NO_FLUSH);
+        if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+            error =
+                fmt::format("Corrupt zip archive: failed to inflate {}", entry.name);
+            break;
+        }
+
+        size_t produced = output.size() - stream.avail_out;
+        output_full = stream.avail_out == 0;
+        written += produced;
+        // Never trust the data to stop where the central directory says it does
+        if (written > entry.uncompressed_size) {
+            error = fmt::format(
+                "Zip archive entry {} is larger than it claims to be", entry.name
+            );
+            break;
+        }
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(output.data()), produced);
+        out.write(output.data(), static_cast<std::streamsize>(produced));
+    }
+    inflateEnd(&stream);
+
+    if (!error.has_value() && written != entry.uncompressed_size)
+        error = fmt::format("Corrupt zip archive: bad size for {}", entry.name);
+    return error;
+}
+
+std::optional<std::string>
+extract(
+    const std::filesystem::path& archive,
+    const Entry& entry,
+    const std::filesystem::path& directory
+)
+{
+    std::filesystem::path target = directory / entry.name;
+    std::error_code err;
+    if (entry.is_directory()) {
+        std::filesystem::create_directories(target, err);
+        if (err)
+            return fmt::format("Failed to extract {}: {}", entry.name, err.message());
+        return std::nullopt;
+    }
+    std::filesystem::create_directories(target.parent_path(), err);
+    if (err)
+        return fmt::format("Failed to extract {}: {}", entry.name, err.message());
+
+    std::ifstream file(archive, std::ios::binary);
+    std::array<char, LOCAL_HEADER_SIZE> header{};
+    file.seekg(static_cast<std::streamoff>(entry.local_header_offset));
+    if (!file || !read_exactly(file, header.data(), LOCAL_HEADER_SIZE)
+        || read_u32(header.data()) != LOCAL_HEADER_SIGNATURE) {
+        return fmt::format("Corrupt zip archive: bad local header for {}", entry.name);
+    }
+    // The local header's name and extra field can differ from the central directory's
+    file.seekg(
+        read_u16(header.data() + 26) + read_u16(header.data() + 28), std::ios::cur
+    );
+
+    std::ofstream out(target, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return fmt::format("Failed to extract {}: could not create file", entry.name);
+
+    uLong crc = 0;
+    std::optional<std::string> error = copy_data(file, entry, out, crc);
+    out.close();
+    if (!error.has_value() && crc != entry.crc32)
+        error = fmt::format("Corrupt zip archive: bad checksum for {}", entry.name);
+    if (!error.has_value() && !out)
+        error = fmt::format("Failed to extract {}: could not write file", entry.name);
+
+    if (error.has_value())
+        std::filesystem::remove(target, err);
+    return error;
+}
+
+std::optional<std::string>
+extract_all(
+    const std::filesystem::path& archive,
+    const std::vector<Entry>& entries,
+    const std::filesystem::path& directory
+)
+{
+    for (const Entry& entry : entries) {
+        std::optional<std::string> error = extract(archive, entry, directory);
+        if (error.has_value())
+            return error;
+    }
+    return std::nullopt;
+}
+
+} // namespace zip
+} // namespace nutc
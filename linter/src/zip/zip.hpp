@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief Reads zip archives from disk a chunk at a time
+ *
+ * Submissions can carry large model checkpoints, so an archive is never loaded into
+ * memory whole. Its central directory is checked against the limits before any file
+ * data is read, and entries are then inflated straight to disk
+ */
+namespace zip {
+
+struct Limits {
+    size_t max_entries;
+    // Sum of the sizes the central directory declares; extraction also stops at them
+    uint64_t max_uncompressed_bytes;
+};
+
+// The LINT_ZIP_* values from the config
+Limits default_limits();
+
+struct Entry {
+    // Relative, with '/' separators; checked not to leave the extraction directory
+    std::string name;
+    uint16_t method;
+    uint32_t crc32;
+    uint64_t compressed_size;
+    uint64_t uncompressed_size;
+    uint64_t local_header_offset;
+
+    [[nodiscard]] bool is_directory() const;
+};
+
+/**
+ * @brief Reads and validates the archive's central directory
+ * @returns Why the archive was rejected, or nullopt if entries was filled in
+ */
+std::optional<std::string> read_entries(
+    const std::filesystem::path& archive,
+    const Limits& limits,
+    std::vector<Entry>& entries
+);
+
+/**
+ * @brief Extracts one entry of the archive under directory
+ *
+ * Fails, without leaving a partial file behind, if the data inflates past the size
+ * the central directory declared or doesn't match its checksum
+ */
+std::optional<std::string> extract(
+    const std::filesystem::path& archive,
+    const Entry& entry,
+    const std::filesystem::path& directory
+);
+
+// Extracts every entry, stopping at the first that fails
+std::optional<std::string> extract_all(
+    const std::filesystem::path& archive,
+    const std::vector<Entry>& entries,
+    const std::filesystem::path& directory
+);
+
+} // namespace zip
+} // namespace nutc
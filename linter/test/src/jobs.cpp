@@ -0,0 +1,87 @@
+#include "jobs/jobs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+using nutc::jobs::Job;
+using nutc::jobs::JobState;
+using nutc::jobs::JobTable;
+
+TEST(JobTable, NewJobsAreQueued)
+{
+    JobTable table(4);
+    std::string id = table.create("uid", "algo", 2);
+    EXPECT_EQ(id.size(), 16);
+
+    std::optional<Job> job = table.get(id);
+    ASSERT_TRUE(job.has_value());
+    EXPECT_EQ(job->uid, "uid");
+    EXPECT_EQ(job->algo_id, "algo");
+    EXPECT_EQ(job->task, 2);
+    EXPECT_EQ(job->state, JobState::queued);
+    EXPECT_FALSE(job->finished());
+}
+
+TEST(JobTable, IdsAreUnique)
+{
+    JobTable table(4);
+    std::unordered_set<std::string> ids;
+    for (int i = 0; i < 1000; i++)
+        ids.insert(table.create("uid", "algo", 1));
+    EXPECT_EQ(ids.size(), 1000);
+}
+
+TEST(JobTable, TracksStateChanges)
+{
+    JobTable table(4);
+    std::string done = table.create("uid", "a", 1);
+    std::string failed = table.create("uid", "b", 1);
+
+    table.set_linting(done);
+    EXPECT_EQ(table.get(done)->state, JobState::linting);
+
+    table.finish(done, "Success!", true);
+    table.finish(failed, "Timed out", false);
+    EXPECT_EQ(table.get(done)->state, JobState::done);
+    EXPECT_EQ(table.get(done)->message, "Success!");
+    EXPECT_TRUE(table.get(done)->finished());
+    EXPECT_EQ(table.get(failed)->state, JobState::error);
+    EXPECT_EQ(table.get(failed)->message, "Timed out");
+}
+
+TEST(JobTable, ForgetsTheOldestFinishedJobs)
+{
+    JobTable table(2);
+    std::string pending = table.create("uid", "pending", 1);
+    std::string first = table.create("uid", "first", 1);
+    std::string second = table.create("uid", "second", 1);
+    std::string third = table.create("uid", "third", 1);
+
+    table.finish(first, "", true);
+    table.finish(second, "", true);
+    EXPECT_TRUE(table.get(first).has_value());
+
+    table.finish(third, "", true);
+    EXPECT_FALSE(table.get(first).has_value());
+    EXPECT_TRUE(table.get(second).has_value());
+    EXPECT_TRUE(table.get(third).has_value());
+
+    // Unfinished jobs never count against the limit
+    EXPECT_TRUE(table.get(pending).has_value());
+}
+
+TEST(JobTable, ErasedAndUnknownJobsDoNotResolve)
+{
+    JobTable table(2);
+    std::string id = table.create("uid", "algo", 1);
+    table.erase(id);
+    EXPECT_FALSE(table.get(id).has_value());
+
+    // Updates for forgotten jobs are dropped
+    table.finish(id, "late", true);
+    EXPECT_FALSE(table.get(id).has_value());
+    EXPECT_FALSE(table.get("0123456789abcdef").has_value());
+}
@@ -0,0 +1,52 @@
+#include "lint_cache/lint_cache.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+using nutc::lint_cache::LintCache;
+using nutc::lint_cache::LintResult;
+
+class LintCacheTest : public ::testing::Test {
+protected:
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path()
+        / ("lint_cache_test_" + std::to_string(getpid()));
+
+    void
+    TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+};
+
+TEST_F(LintCacheTest, RemembersResultsByKindAndSource)
+{
+    LintCache cache(directory, 4, "abc123");
+    EXPECT_FALSE(cache.get("2", "code").has_value());
+
+    cache.put("2", "code", {false, "failed"});
+    std::optional<LintResult> result = cache.get("2", "code");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(result->succeeded);
+    EXPECT_EQ(result->message, "failed");
+
+    EXPECT_FALSE(cache.get("1", "code").has_value());
+    EXPECT_FALSE(cache.get("2", "other code").has_value());
+}
+
+TEST_F(LintCacheTest, SharesResultsOnDiskWithinOneLinterVersion)
+{
+    LintCache(directory, 4, "abc123").put("2", "code", {true, "Success!\nline two"});
+
+    std::optional<LintResult> result =
+        LintCache(directory, 4, "abc123").get("2", "code");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->succeeded);
+    EXPECT_EQ(result->message, "Success!\nline two");
+
+    EXPECT_FALSE(LintCache(directory, 4, "def456").get("2", "code").has_value());
+}
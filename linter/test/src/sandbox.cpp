@@ -0,0 +1,103 @@
+#include "logging.hpp"
+#include "sandbox/sandbox.hpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/embed.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nutc::lint_cache::LintResult;
+using nutc::sandbox::Limits;
+using nutc::sandbox::SandboxResult;
+
+class SandboxTest : public ::testing::Test {
+protected:
+    const Limits limits{std::chrono::seconds(1), 0, 0};
+
+    // The sandbox forks the interpreter, so one has to be running
+    static void
+    SetUpTestSuite()
+    {
+        if (!Py_IsInitialized())
+            pybind11::initialize_interpreter();
+    }
+
+    // Collects what the parent logs, which includes the records its children send
+    static inline std::vector<std::string> logged;
+
+    static void
+    capture_log(quill::LogLevel, const char* category, const std::string& message)
+    {
+        logged.push_back(std::string(category) + ": " + message);
+    }
+
+    void
+    SetUp() override
+    {
+        logged.clear();
+        nutc::logging::forward_logs(capture_log);
+    }
+
+    void
+    TearDown() override
+    {
+        nutc::logging::forward_logs(nullptr);
+    }
+};
+
+TEST_F(SandboxTest, ReturnsTheLintsVerdict)
+{
+    SandboxResult sandboxed =
+        nutc::sandbox::run(limits, [] { return LintResult{false, "Bad algo"}; });
+    EXPECT_TRUE(sandboxed.completed);
+    EXPECT_FALSE(sandboxed.result.succeeded);
+    EXPECT_EQ(sandboxed.result.message, "Bad algo");
+
+    sandboxed = nutc::sandbox::run(limits, [] {
+        return LintResult{true, std::string(100000, 'x')};
+    });
+    EXPECT_TRUE(sandboxed.completed);
+    EXPECT_TRUE(sandboxed.result.succeeded);
+    EXPECT_EQ(sandboxed.result.message.size(), 100000);
+}
+
+TEST_F(SandboxTest, CrashesAndTimeoutsAreNotVerdicts)
+{
+    SandboxResult crashed = nutc::sandbox::run(limits, []() -> LintResult {
+        std::abort();
+    });
+    EXPECT_FALSE(crashed.completed);
+    EXPECT_FALSE(crashed.result.succeeded);
+    EXPECT_NE(crashed.result.message.find("crashed"), std::string::npos);
+
+    SandboxResult timed_out = nutc::sandbox::run(limits, [] {
+        std::this_thread::sleep_for(std::chrono::seconds(10));
+        return LintResult{true, ""};
+    });
+    EXPECT_FALSE(timed_out.completed);
+    EXPECT_FALSE(timed_out.result.succeeded);
+    EXPECT_NE(timed_out.result.message.find("1 second"), std::string::npos);
+}
+
+TEST_F(SandboxTest, ChildLogsReachTheParent)
+{
+    SandboxResult sandboxed = nutc::sandbox::run(limits, []() -> LintResult {
+        log_i(mock_api, "Placed order {}", 1);
+        log_w(linting, "Multi-line\nrecord");
+        std::abort();
+    });
+    EXPECT_FALSE(sandboxed.completed);
+
+    // The parent logs each record under linting
+    std::vector<std::string> expected = {
+        "linting: Sandbox: mock_api: Placed order 1",
+        "linting: Sandbox: linting: Multi-line\nrecord"
+    };
+    ASSERT_GE(logged.size(), expected.size());
+    EXPECT_EQ(logged[0], expected[0]);
+    EXPECT_EQ(logged[1], expected[1]);
+}
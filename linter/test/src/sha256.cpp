@@ -0,0 +1,60 @@
+#include "lint_cache/sha256.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using nutc::lint_cache::Sha256;
+using nutc::lint_cache::sha256_hex;
+
+// Known answers from the NIST SHA-256 examples
+TEST(Sha256, MatchesKnownDigests)
+{
+    EXPECT_EQ(
+        sha256_hex(""),
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"
+    );
+    EXPECT_EQ(
+        sha256_hex("abc"),
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"
+    );
+    EXPECT_EQ(
+        sha256_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"
+    );
+    EXPECT_EQ(
+        sha256_hex(std::string(1000000, 'a')),
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"
+    );
+}
+
+// Lengths around the block size, where the padding spills into a second block
+TEST(Sha256, PadsAtBlockBoundaries)
+{
+    EXPECT_EQ(
+        sha256_hex(std::string(55, 'a')),
+        "9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318"
+    );
+    EXPECT_EQ(
+        sha256_hex(std::string(56, 'a')),
+        "b35439a4ac6f0948b6d6f9e3c6af0f5f590ce20f1bde7090ef7970686ec6738a"
+    );
+    EXPECT_EQ(
+        sha256_hex(std::string(64, 'a')),
+        "ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb"
+    );
+}
+
+TEST(Sha256, UpdatesMatchOneShotHashing)
+{
+    std::string data;
+    for (int i = 0; i < 1000; i++)
+        data += static_cast<char>(i * 7);
+
+    for (size_t chunk : {1, 3, 63, 64, 65, 200}) {
+        Sha256 hash;
+        for (size_t offset = 0; offset < data.size(); offset += chunk)
+            hash.update(std::string_view(data).substr(offset, chunk));
+        EXPECT_EQ(hash.hex_digest(), sha256_hex(data)) << "chunk " << chunk;
+    }
+}
@@ -0,0 +1,120 @@
+#include "thread_safe_queue/tsq.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using nutc::tsq::ThreadSafeQueue;
+
+TEST(ThreadSafeQueue, PopsInPushOrder)
+{
+    ThreadSafeQueue<int> queue(4);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_TRUE(queue.try_push(3));
+    EXPECT_EQ(queue.size(), 3);
+
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.try_pop(), 2);
+    EXPECT_EQ(queue.pop_for(std::chrono::milliseconds(10)), 3);
+    EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(ThreadSafeQueue, TryPushKeepsTheValueWhenFull)
+{
+    ThreadSafeQueue<std::unique_ptr<int>> queue(1);
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(1)));
+
+    auto value = std::make_unique<int>(2);
+    EXPECT_FALSE(queue.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 2);
+    EXPECT_EQ(queue.size(), queue.max_size());
+}
+
+TEST(ThreadSafeQueue, EmptyPopsGiveUp)
+{
+    ThreadSafeQueue<int> queue(1);
+    EXPECT_FALSE(queue.try_pop().has_value());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop_for(std::chrono::milliseconds(20)).has_value());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST(ThreadSafeQueue, PushBlocksUntilThereIsRoom)
+{
+    ThreadSafeQueue<int> queue(1);
+    queue.push(1);
+
+    std::thread producer([&queue] { queue.push(2); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(queue.size(), 1);
+
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+    EXPECT_EQ(queue.pop(), 2);
+}
+
+TEST(ThreadSafeQueue, PopBlocksUntilAValueArrives)
+{
+    ThreadSafeQueue<int> queue(1);
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(7);
+    });
+    EXPECT_EQ(queue.pop(), 7);
+    producer.join();
+}
+
+TEST(ThreadSafeQueue, DrainTakesAtMostMaxValues)
+{
+    ThreadSafeQueue<int> queue(8);
+    for (int i = 0; i < 5; i++)
+        queue.push(i);
+
+    std::vector<int> first = queue.drain(3);
+    EXPECT_EQ(first, (std::vector<int>{0, 1, 2}));
+    std::vector<int> rest = queue.drain(10);
+    EXPECT_EQ(rest, (std::vector<int>{3, 4}));
+}
+
+TEST(ThreadSafeQueue, EveryValueIsPoppedOnce)
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int VALUES_PER_PRODUCER = 1000;
+    ThreadSafeQueue<int> queue(16);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < VALUES_PER_PRODUCER; i++)
+                queue.push(p * VALUES_PER_PRODUCER + i);
+        });
+    }
+
+    std::vector<int> seen(PRODUCERS * VALUES_PER_PRODUCER, 0);
+    std::vector<std::thread> consumers;
+    std::mutex seen_mutex;
+    for (int c = 0; c < 2; c++) {
+        consumers.emplace_back([&] {
+            while (std::optional<int> value =
+                       queue.pop_for(std::chrono::milliseconds(100))) {
+                std::lock_guard<std::mutex> lock(seen_mutex);
+                seen[static_cast<size_t>(value.value())]++;
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+    for (auto& consumer : consumers)
+        consumer.join();
+    for (int count : seen)
+        EXPECT_EQ(count, 1);
+}
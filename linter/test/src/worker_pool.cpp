@@ -0,0 +1,124 @@
+#include "thread_safe_queue/tsq.hpp"
+#include "worker_pool/worker_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+using nutc::worker_pool::LintJob;
+using nutc::worker_pool::LintOutcome;
+using nutc::worker_pool::Submission;
+using nutc::worker_pool::WorkerPool;
+
+using LintResult = std::pair<LintJob, LintOutcome>;
+
+// Stands in for linting; the algo id picks how the lint behaves
+static std::string
+fake_lint(const Submission& submission)
+{
+    const auto& [uid, algo_id, task] = submission;
+    if (algo_id == "crash")
+        std::abort();
+    if (algo_id == "hang")
+        std::this_thread::sleep_for(std::chrono::seconds(30));
+    return "linted " + uid;
+}
+
+// The pool execs this binary as its workers, which run only this test
+TEST(WorkerPoolChild, DISABLED_Serve)
+{
+    _exit(nutc::worker_pool::serve_worker(fake_lint));
+}
+
+class WorkerPoolTest : public ::testing::Test {
+protected:
+    static constexpr size_t NUM_WORKERS = 2;
+    static constexpr auto TIMEOUT = std::chrono::seconds(1);
+
+    // The pool runs until the process exits, so it and its queues are shared by every
+    // test and never destroyed
+    static void
+    SetUpTestSuite()
+    {
+        if (pool != nullptr)
+            return;
+        jobs = new nutc::tsq::ThreadSafeQueue<LintJob>(16);
+        results = new nutc::tsq::ThreadSafeQueue<LintResult>(16);
+        pool = new WorkerPool(
+            NUM_WORKERS,
+            TIMEOUT,
+            *jobs,
+            {"NUTC-client_test",
+             "--gtest_filter=WorkerPoolChild.DISABLED_Serve",
+             "--gtest_also_run_disabled_tests"},
+            [](const LintJob&) { started++; },
+            [](const LintJob& job, const LintOutcome& outcome) {
+                results->push({job, outcome});
+            }
+        );
+    }
+
+    static LintResult
+    lint(const std::string& uid, const std::string& algo_id)
+    {
+        jobs->push(LintJob{uid, Submission{uid, algo_id, 2}});
+        std::optional<LintResult> result = results->pop_for(std::chrono::seconds(10));
+        EXPECT_TRUE(result.has_value());
+        return result.value_or(LintResult{});
+    }
+
+    static inline nutc::tsq::ThreadSafeQueue<LintJob>* jobs = nullptr;
+    static inline nutc::tsq::ThreadSafeQueue<LintResult>* results = nullptr;
+    static inline WorkerPool* pool = nullptr;
+    static inline std::atomic<int> started = 0;
+};
+
+TEST_F(WorkerPoolTest, LintsEverySubmission)
+{
+    int started_before = started;
+    for (int i = 0; i < 4; i++)
+        jobs->push(LintJob{std::to_string(i), Submission{std::to_string(i), "ok", 2}});
+
+    for (int i = 0; i < 4; i++) {
+        std::optional<LintResult> result = results->pop_for(std::chrono::seconds(10));
+        ASSERT_TRUE(result.has_value());
+        auto& [job, outcome] = result.value();
+        EXPECT_TRUE(outcome.completed);
+        EXPECT_EQ(outcome.message, "linted " + job.id);
+    }
+    EXPECT_EQ(started - started_before, 4);
+}
+
+TEST_F(WorkerPoolTest, ReplacesWorkersThatCrash)
+{
+    auto [crashed_job, crashed] = lint("a", "crash");
+    EXPECT_EQ(crashed_job.id, "a");
+    EXPECT_FALSE(crashed.completed);
+
+    // Enough lints that the replaced worker must take one
+    for (size_t i = 0; i < NUM_WORKERS; i++) {
+        auto [job, outcome] = lint("b", "ok");
+        EXPECT_TRUE(outcome.completed);
+        EXPECT_EQ(outcome.message, "linted b");
+    }
+}
+
+TEST_F(WorkerPoolTest, KillsLintsPastTheTimeout)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto [job, outcome] = lint("a", "hang");
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_FALSE(outcome.completed);
+    EXPECT_NE(outcome.message.find("1 seconds"), std::string::npos);
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+
+    for (size_t i = 0; i < NUM_WORKERS; i++)
+        EXPECT_TRUE(lint("b", "ok").second.completed);
+}
@@ -0,0 +1,201 @@
+#include "firebase/write_batcher.hpp"
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nutc::client::WriteBatcher;
+
+namespace {
+struct Patch {
+    std::string method;
+    std::string path;
+    std::string body;
+};
+
+// Records the requests it receives and answers each with 200 and an empty object
+class FakeFirebase {
+public:
+    FakeFirebase() : listener(socket(AF_INET, SOCK_STREAM, 0))
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        bind(listener, reinterpret_cast<sockaddr*>(&address), length);
+        listen(listener, 16);
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+        server = std::thread([this] { serve(); });
+    }
+
+    ~FakeFirebase()
+    {
+        // Wakes the accept
+        shutdown(listener, SHUT_RDWR);
+        close(listener);
+        server.join();
+    }
+
+    FakeFirebase(const FakeFirebase&) = delete;
+    FakeFirebase& operator=(const FakeFirebase&) = delete;
+
+    std::string
+    url() const
+    {
+        return "http://127.0.0.1:" + std::to_string(port);
+    }
+
+    std::vector<Patch>
+    wait_for(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        received.wait_for(lock, std::chrono::seconds(5), [&] {
+            return patches.size() >= count;
+        });
+        return patches;
+    }
+
+private:
+    int listener;
+    uint16_t port = 0;
+    std::thread server;
+    std::mutex mutex;
+    std::condition_variable received;
+    std::vector<Patch> patches;
+
+    void
+    serve()
+    {
+        while (true) {
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0)
+                return;
+            handle(client);
+            close(client);
+        }
+    }
+
+    void
+    handle(int client)
+    {
+        std::string request;
+        char buffer[4096];
+        size_t header_end = std::string::npos;
+        size_t content_length = 0;
+        while (true) {
+            if (header_end == std::string::npos) {
+                header_end = request.find("\r\n\r\n");
+                if (header_end != std::string::npos) {
+                    size_t field = request.find("Content-Length: ");
+                    if (field != std::string::npos && field < header_end)
+                        content_length = std::stoul(request.substr(field + 16));
+                }
+            }
+            if (header_end != std::string::npos
+                && request.size() >= header_end + 4 + content_length) {
+                break;
+            }
+            ssize_t bytes = read(client, buffer, sizeof(buffer));
+            if (bytes <= 0)
+                return;
+            request.append(buffer, static_cast<size_t>(bytes));
+        }
+
+        std::string response =
+            "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\n{}";
+        if (write(client, response.data(), response.size()) < 0)
+            return;
+
+        size_t method_end = request.find(' ');
+        size_t path_end = request.find(' ', method_end + 1);
+        std::lock_guard<std::mutex> lock(mutex);
+        patches.push_back(
+            {request.substr(0, method_end),
+             request.substr(method_end + 1, path_end - method_end - 1),
+             request.substr(header_end + 4, content_length)}
+        );
+        received.notify_all();
+    }
+};
+
+constexpr auto DELAY = std::chrono::milliseconds(50);
+} // namespace
+
+TEST(WriteBatcher, CombinesEachUsersWritesIntoOnePatch)
+{
+    FakeFirebase firebase;
+    WriteBatcher batcher(DELAY, firebase.url());
+    batcher.set("u1", "algos/a/lintResults", "failure");
+    batcher.set("u1", "algos/a/lintFailureMessage", "bad");
+    batcher.set("u2", "latestAlgoId", "b");
+    // Replaces the unsent write to the same path
+    batcher.set("u1", "algos/a/lintResults", "success");
+    batcher.flush();
+
+    std::vector<Patch> patches = firebase.wait_for(2);
+    ASSERT_EQ(patches.size(), 2);
+    if (patches[0].path != "/users/u1.json")
+        std::swap(patches[0], patches[1]);
+    EXPECT_EQ(patches[0].method, "PATCH");
+    EXPECT_EQ(patches[0].path, "/users/u1.json");
+    EXPECT_EQ(
+        patches[0].body,
+        R"({"algos/a/lintFailureMessage":"bad","algos/a/lintResults":"success"})"
+    );
+    EXPECT_EQ(patches[1].path, "/users/u2.json");
+    EXPECT_EQ(patches[1].body, R"({"latestAlgoId":"b"})");
+}
+
+TEST(WriteBatcher, EscapesPathsAndValues)
+{
+    FakeFirebase firebase;
+    WriteBatcher batcher(DELAY, firebase.url());
+    batcher.set(
+        "u1", "algos/\"a\"/lintFailureMessage", "Line 1.\n\"quoted\" $#[] \\"
+    );
+    batcher.flush();
+
+    std::vector<Patch> patches = firebase.wait_for(1);
+    ASSERT_EQ(patches.size(), 1);
+    std::string expected =
+        R"({"algos/\"a\"/lintFailureMessage":)" R"("Line 1.\n\"quoted\" $#[] \\"})";
+    EXPECT_EQ(patches[0].body, expected);
+}
+
+TEST(WriteBatcher, SendsLaterWritesInLaterPatches)
+{
+    FakeFirebase firebase;
+    WriteBatcher batcher(DELAY, firebase.url());
+    batcher.set("u1", "latestAlgoId", "a");
+    batcher.flush();
+    EXPECT_EQ(firebase.wait_for(1).size(), 1);
+
+    batcher.set("u1", "latestAlgoId", "b");
+    batcher.flush();
+    std::vector<Patch> patches = firebase.wait_for(2);
+    ASSERT_EQ(patches.size(), 2);
+    EXPECT_EQ(patches[0].body, R"({"latestAlgoId":"a"})");
+    EXPECT_EQ(patches[1].body, R"({"latestAlgoId":"b"})");
+}
+
+TEST(WriteBatcher, SendsPendingWritesWhenDestroyed)
+{
+    FakeFirebase firebase;
+    {
+        WriteBatcher batcher(std::chrono::seconds(10), firebase.url());
+        batcher.set("u1", "latestAlgoId", "a");
+    }
+    std::vector<Patch> patches = firebase.wait_for(1);
+    ASSERT_EQ(patches.size(), 1);
+    EXPECT_EQ(patches[0].body, R"({"latestAlgoId":"a"})");
+}
@@ -0,0 +1,286 @@
+#include "zip/zip.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace zip = nutc::zip;
+
+namespace {
+struct TestEntry {
+    std::string name;
+    std::string data;
+    bool deflate = false;
+    // Overrides for what the headers claim, to craft corrupt archives
+    std::optional<uint32_t> crc32{};
+    std::optional<uint32_t> uncompressed_size{};
+};
+
+void
+put_u16(std::string& out, uint32_t value)
+{
+    out += static_cast<char>(value & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+}
+
+void
+put_u32(std::string& out, uint32_t value)
+{
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+std::string
+raw_deflate(const std::string& data)
+{
+    z_stream stream{};
+    deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, 0);
+    std::string output(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+    deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return output;
+}
+
+// A minimal zip writer; total_entries overrides the end of central directory's count
+std::string
+build_zip(
+    const std::vector<TestEntry>& entries,
+    std::optional<uint16_t> total_entries = std::nullopt
+)
+{
+    std::string archive;
+    std::string directory;
+    for (const TestEntry& entry : entries) {
+        std::string stored = entry.deflate ? raw_deflate(entry.data) : entry.data;
+        auto crc = static_cast<uint32_t>(crc32(
+            0L,
+            reinterpret_cast<const Bytef*>(entry.data.data()),
+            static_cast<uInt>(entry.data.size())
+        ));
+        crc = entry.crc32.value_or(crc);
+        uint32_t size =
+            entry.uncompressed_size.value_or(static_cast<uint32_t>(entry.data.size()));
+        uint16_t method = entry.deflate ? 8 : 0;
+        auto offset = static_cast<uint32_t>(archive.size());
+
+        put_u32(archive, 0x04034b50);
+        put_u16(archive, 20);
+        put_u16(archive, 0);
+        put_u16(archive, method);
+        put_u32(archive, 0);
+        put_u32(archive, crc);
+        put_u32(archive, static_cast<uint32_t>(stored.size()));
+        put_u32(archive, size);
+        put_u16(archive, static_cast<uint32_t>(entry.name.size()));
+        put_u16(archive, 0);
+        archive += entry.name;
+        archive += stored;
+
+        put_u32(directory, 0x02014b50);
+        put_u16(directory, 20);
+        put_u16(directory, 20);
+        put_u16(directory, 0);
+        put_u16(directory, method);
+        put_u32(directory, 0);
+        put_u32(directory, crc);
+        put_u32(directory, static_cast<uint32_t>(stored.size()));
+        put_u32(directory, size);
+        put_u16(directory, static_cast<uint32_t>(entry.name.size()));
+        put_u16(directory, 0);
+        put_u16(directory, 0);
+        put_u16(directory, 0);
+        put_u16(directory, 0);
+        put_u32(directory, 0);
+        put_u32(directory, offset);
+        directory += entry.name;
+    }
+
+    auto directory_offset = static_cast<uint32_t>(archive.size());
+    archive += directory;
+    uint16_t count = total_entries.value_or(static_cast<uint16_t>(entries.size()));
+    put_u32(archive, 0x06054b50);
+    put_u16(archive, 0);
+    put_u16(archive, 0);
+    put_u16(archive, count);
+    put_u16(archive, count);
+    put_u32(archive, static_cast<uint32_t>(directory.size()));
+    put_u32(archive, directory_offset);
+    put_u16(archive, 0);
+    return archive;
+}
+
+constexpr zip::Limits LIMITS{10, 1024 * 1024};
+} // namespace
+
+class ZipTest : public ::testing::Test {
+protected:
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path()
+        / ("zip_test_" + std::to_string(getpid()));
+    const std::filesystem::path archive = directory / "archive.zip";
+    const std::filesystem::path extracted = directory / "extracted";
+
+    void
+    SetUp() override
+    {
+        std::filesystem::create_directories(directory);
+    }
+
+    void
+    TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    void
+    write_archive(const std::string& contents) const
+    {
+        std::ofstream(archive, std::ios::binary) << contents;
+    }
+
+    std::optional<std::string>
+    read(std::vector<zip::Entry>& entries, const zip::Limits& limits = LIMITS) const
+    {
+        return zip::read_entries(archive, limits, entries);
+    }
+
+    std::string
+    read_extracted(const std::string& name) const
+    {
+        std::ifstream file(extracted / name, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), {}};
+    }
+};
+
+TEST_F(ZipTest, ExtractsStoredAndDeflatedEntries)
+{
+    std::string model(200000, 'm');
+    write_archive(build_zip({
+        {"model/", ""},
+        {"model/weights.bin", model, true},
+        {"readme.txt", "hello"},
+    }));
+
+    std::vector<zip::Entry> entries;
+    ASSERT_EQ(read(entries), std::nullopt);
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_TRUE(entries[0].is_directory());
+    EXPECT_EQ(entries[1].name, "model/weights.bin");
+    EXPECT_EQ(entries[1].uncompressed_size, model.size());
+    EXPECT_LT(entries[1].compressed_size, model.size());
+
+    ASSERT_EQ(zip::extract_all(archive, entries, extracted), std::nullopt);
+    EXPECT_EQ(read_extracted("model/weights.bin"), model);
+    EXPECT_EQ(read_extracted("readme.txt"), "hello");
+}
+
+TEST_F(ZipTest, RejectsPathsOutsideTheDirectory)
+{
+    for (const char* name :
+         {"../evil.py", "a/../../evil.py", "/etc/evil.py", "a\\..\\evil.py", ".."}) {
+        write_archive(build_zip({{"ok.txt", "ok"}, {name, "evil"}}));
+        std::vector<zip::Entry> entries;
+        std::optional<std::string> err = read(entries);
+        ASSERT_TRUE(err.has_value()) << name;
+        EXPECT_NE(err->find("unsafe path"), std::string::npos) << name;
+    }
+
+    // Dots that don't climb are fine
+    write_archive(build_zip({{"a/..b/c..", "ok"}}));
+    std::vector<zip::Entry> entries;
+    EXPECT_EQ(read(entries), std::nullopt);
+}
+
+TEST_F(ZipTest, RejectsZip64)
+{
+    std::vector<zip::Entry> entries;
+    write_archive(build_zip({{"big.bin", "data", false, std::nullopt, 0xFFFFFFFF}}));
+    EXPECT_EQ(read(entries), "ZIP64 archives are not supported");
+
+    write_archive(build_zip({{"a.txt", "a"}}, 0xFFFF));
+    EXPECT_EQ(read(entries), "ZIP64 archives are not supported");
+}
+
+TEST_F(ZipTest, RejectsBadChecksumsWithoutLeavingAFile)
+{
+    write_archive(build_zip({
+        {"stored.txt", "stored data", false, 0x12345678},
+        {"deflated.txt", std::string(5000, 'd'), true, 0x12345678},
+    }));
+
+    std::vector<zip::Entry> entries;
+    ASSERT_EQ(read(entries), std::nullopt);
+    for (const zip::Entry& entry : entries) {
+        std::optional<std::string> err = zip::extract(archive, entry, extracted);
+        ASSERT_TRUE(err.has_value()) << entry.name;
+        EXPECT_NE(err->find("bad checksum"), std::string::npos) << entry.name;
+        EXPECT_FALSE(std::filesystem::exists(extracted / entry.name)) << entry.name;
+    }
+}
+
+TEST_F(ZipTest, EnforcesTheLimits)
+{
+    std::vector<zip::Entry> entries;
+    std::vector<TestEntry> many;
+    for (int i = 0; i < 11; i++)
+        many.push_back({std::to_string(i), "x"});
+    write_archive(build_zip(many));
+    std::optional<std::string> err = read(entries);
+    ASSERT_TRUE(err.has_value());
+    EXPECT_NE(err->find("more than the limit of 10"), std::string::npos);
+
+    // The declared sizes add up past the limit
+    write_archive(build_zip({
+        {"a", "a", false, std::nullopt, 600 * 1024},
+        {"b", "b", false, std::nullopt, 600 * 1024},
+    }));
+    err = read(entries);
+    ASSERT_TRUE(err.has_value());
+    EXPECT_NE(err->find("larger than 1 MB"), std::string::npos);
+}
+
+TEST_F(ZipTest, StopsEntriesThatInflatePastTheirDeclaredSize)
+{
+    // A bomb that claims to be small: 10 MB of zeros declared as 1 KB
+    write_archive(build_zip({
+        {"bomb.bin", std::string(10 * 1024 * 1024, '\0'), true, std::nullopt, 1024},
+    }));
+
+    std::vector<zip::Entry> entries;
+    ASSERT_EQ(read(entries), std::nullopt);
+    std::optional<std::string> err = zip::extract(archive, entries[0], extracted);
+    ASSERT_TRUE(err.has_value());
+    EXPECT_NE(err->find("larger than it claims"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(extracted / "bomb.bin"));
+}
+
+TEST_F(ZipTest, RejectsFilesThatAreNotZips)
+{
+    std::vector<zip::Entry> entries;
+    write_archive("PK");
+    EXPECT_EQ(read(entries), "Not a zip archive");
+
+    write_archive(std::string(100, 'x'));
+    EXPECT_EQ(read(entries), "Not a zip archive: no end of central directory record");
+
+    // A central directory pointing past the end of the file
+    std::string archive_data = build_zip({{"a.txt", "a"}});
+    archive_data[archive_data.size() - 3] = '\x7f';
+    write_archive(archive_data);
+    std::optional<std::string> err = read(entries);
+    ASSERT_TRUE(err.has_value());
+    EXPECT_NE(err->find("out of bounds"), std::string::npos);
+}
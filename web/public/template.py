@@ -1,4 +1,11 @@
-def place_market_order(side: str, ticker: str, quantity: float, price: float) -> bool:
+def place_market_order(
+    side: str,
+    ticker: str,
+    quantity: float,
+    price: float,
+    order_type: str = "LIMIT",
+    time_in_force: str = "GTC",
+) -> bool:
     """Place a market order - DO NOT MODIFY
 
     Parameters
@@ -10,7 +17,14 @@ def place_market_order(side: str, ticker: str, quantity: float, price: float) ->
     quantity
         Volume of order to place
     price
-        Price of order to place
+        Price of order to place (ignored for "MARKET" orders)
+    order_type
+        "LIMIT", "MARKET" (fills at whatever prices the book offers) or "POST_ONLY"
+        (rejected if it would trade as soon as it is placed)
+    time_in_force
+        How long the unfilled part of the order stays in the book: "GTC" (until it is
+        filled), "IOC" (cancelled right away) or "FOK" (the order fills completely as
+        soon as it is placed, or not at all). "MARKET" orders never stay in the book
 
     Returns
     -------
@@ -56,7 +70,7 @@ class Strategy:
         price
             Price of orderbook that has an update
         quantity
-            Volume placed into orderbook
+            Total volume now resting at this price; 0 if the level is empty
         """
         print(f"Python Orderbook update: {ticker} {side} {price} {quantity}")
 
@@ -4,6 +4,8 @@ from conan import ConanFile
 class Recipe(ConanFile):
     settings = "os", "compiler", "build_type", "arch"
     generators = "CMakeToolchain", "CMakeDeps", "VirtualRunEnv"
+    # HTTP/2 lets firebase requests share one connection
+    default_options = {"libcurl/*:with_nghttp2": True}
 
     def layout(self):
         self.folders.generators = "conan"
@@ -1,8 +1,77 @@
 #include "firebase.hpp"
 
+#include "http/http_client.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
 namespace nutc {
 namespace firebase {
 
+// Algo ids are never reused for a new upload, so cached algos never go stale
+static std::optional<std::filesystem::path>
+algo_cache_path(const std::string& algo_id)
+{
+    auto valid_char = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+    };
+    if (algo_id.empty() || !std::all_of(algo_id.begin(), algo_id.end(), valid_char)) {
+        return std::nullopt;
+    }
+    return std::filesystem::path(ALGO_CACHE_DIR) / (algo_id + ".py");
+}
+
+std::optional<std::string>
+read_cached_algo(const std::string& algo_id)
+{
+    auto path = algo_cache_path(algo_id);
+    if (!path.has_value()) {
+        return std::nullopt;
+    }
+
+    std::ifstream file(path.value(), std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+bool
+cache_algo(const std::string& algo_id, const std::string& algo)
+{
+    auto path = algo_cache_path(algo_id);
+    if (!path.has_value()) {
+        return false;
+    }
+
+    // Written under a temporary name so other clients never read a partial file
+    std::error_code error;
+    std::filesystem::create_directories(ALGO_CACHE_DIR, error);
+    std::filesystem::path tmp_path = path.value();
+    tmp_path += ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !(file << algo)) {
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp_path, path.value(), error);
+    if (error) {
+        std::filesystem::remove(tmp_path, error);
+        return false;
+    }
+    return true;
+}
+
 void
 print_algo_info(const glz::json_t& algo, const std::string& algo_id)
 {
@@ -20,42 +89,20 @@ get_user_info(const std::string& uid)
     return firebase_request("GET", url);
 }
 
-static size_t
-write_callback(void* contents, size_t size, size_t nmemb, void* userp)
-{
-    auto* str = reinterpret_cast<std::string*>(userp);
-    auto* data = static_cast<char*>(contents);
-
-    str->append(data, size * nmemb);
-    return size * nmemb;
-}
-
-std::string
+std::optional<std::string>
 storage_request(const std::string& firebase_url)
 {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if (!curl) {
-        throw std::runtime_error("curl_easy_init() failed");
+    http::Response response = http::Client::instance().perform({"GET", firebase_url});
+    if (response.error.has_value()) {
+        throw std::runtime_error(fmt::format(
+            "Request to {} failed: {}", firebase_url, response.error.value()
+        ));
     }
-
-    curl_easy_setopt(curl, CURLOPT_URL, firebase_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-
-    res = curl_easy_perform(curl);
-
-    if (res != CURLE_OK) {
-        std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res)
-                  << std::endl;
+    // The body is storage's error page, not the file
+    if (!response.ok()) {
+        return std::nullopt;
     }
-
-    curl_easy_cleanup(curl);
-
-    return readBuffer;
+    return response.body;
 }
 
 std::optional<std::string>
@@ -76,8 +123,16 @@ get_most_recent_algo(const std::string& uid)
         return std::nullopt;
     }
 
+    std::optional<std::string> cached_algo = read_cached_algo(latestAlgoId);
+    if (cached_algo.has_value()) {
+        return cached_algo;
+    }
+
     std::string downloadURL = algo_info["downloadURL"].get<std::string>();
-    std::string algo_file = storage_request(downloadURL);
+    std::optional<std::string> algo_file = storage_request(downloadURL);
+    if (algo_file.has_value() && !algo_file->empty()) {
+        cache_algo(latestAlgoId, algo_file.value());
+    }
     return algo_file;
 }
 
@@ -86,41 +141,19 @@ firebase_request(
     const std::string& method, const std::string& url, const std::string& data
 )
 {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if (!curl) {
-        throw std::runtime_error("curl_easy_init() failed");
-    }
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-
-    if (method == "POST") {
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-    }
-    else if (method == "PUT") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-    }
-    else if (method == "DELETE") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+    http::Response response = http::Client::instance().perform({method, url, data});
+    if (response.error.has_value()) {
+        throw std::runtime_error(
+            fmt::format("Request to {} failed: {}", url, response.error.value())
+        );
     }
 
-    res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-        log_e(firebase, "curl_easy_perform() failed: {}", curl_easy_strerror(res));
-    }
-
-    curl_easy_cleanup(curl);
-
     glz::json_t json{};
-    auto error = glz::read_json(json, readBuffer);
+    auto error = glz::read_json(json, response.body);
     if (error) {
-        std::string descriptive_error = glz::format_error(error, readBuffer);
-        log_e(firebase, "glz::read_json() failed: {}", descriptive_error);
+        throw std::runtime_error(fmt::format(
+            "glz::read_json() failed: {}", glz::format_error(error, response.body)
+        ));
     }
     return json;
 }
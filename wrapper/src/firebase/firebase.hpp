@@ -14,15 +14,36 @@
 namespace nutc {
 namespace firebase {
 
+// Requests made here throw std::runtime_error instead of logging when they fail, so
+// the fork server can download algos before logging is initialized
+
 // database request - change name
 glz::json_t firebase_request(
     const std::string& method, const std::string& url, const std::string& data = ""
 );
 
-std::string storage_request(const std::string& id, const std::string& url);
+/**
+ * @return nullopt if storage responds with a non-2xx status
+ */
+std::optional<std::string> storage_request(const std::string& firebase_url);
 
 glz::json_t get_user_info(const std::string& uid);
 
+/**
+ * @brief Reads an algo from the on-disk cache shared with the exchange
+ */
+std::optional<std::string> read_cached_algo(const std::string& algo_id);
+
+/**
+ * @return false if the algo could not be written to the cache
+ */
+bool cache_algo(const std::string& algo_id, const std::string& algo);
+
+/**
+ * @brief Gets the user's latest algo, from the cache if it has already been downloaded
+ * @return nullopt if the user has not uploaded an algo or it could not be downloaded
+ * @throws std::runtime_error if a request to firebase fails
+ */
 std::optional<std::string> get_most_recent_algo(const std::string& uid);
 
 } // namespace firebase
@@ -0,0 +1,138 @@
+#include "fork_server.hpp"
+
+#include <pybind11/embed.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <thread>
+
+namespace nutc {
+namespace fork_server {
+
+std::vector<std::optional<std::string>>
+prefetch_algos(
+    const std::vector<std::string>& uids,
+    const AlgoFetcher& fetch,
+    size_t max_parallel
+)
+{
+    std::vector<std::optional<std::string>> algos(uids.size());
+    std::atomic<size_t> next_uid = 0;
+
+    auto fetch_remaining = [&]() {
+        for (size_t i = next_uid++; i < uids.size(); i = next_uid++) {
+            try {
+                algos[i] = fetch(uids[i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to fetch algo for " << uids[i] << ": "
+                          << e.what() << std::endl;
+            }
+        }
+    };
+
+    size_t num_threads = std::clamp<size_t>(uids.size(), 1, std::max<size_t>(max_parallel, 1));
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back(fetch_remaining);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return algos;
+}
+
+static void
+report_exit(const std::string& uid, pid_t pid, int status)
+{
+    if (WIFSIGNALED(status)) {
+        std::cerr << "Client " << uid << " (pid " << pid << ") was killed by signal "
+                  << WTERMSIG(status) << std::endl;
+    }
+    else if (WEXITSTATUS(status) != 0) {
+        std::cerr << "Client " << uid << " (pid " << pid << ") exited with code "
+                  << WEXITSTATUS(status) << std::endl;
+    }
+}
+
+int
+serve(
+    const std::vector<std::string>& uids,
+    const std::vector<std::optional<std::string>>& algos,
+    const ClientRunner& run_client,
+    int max_restarts
+)
+{
+    int failures = 0;
+    std::map<pid_t, size_t> children;
+    std::vector<int> restarts(uids.size(), 0);
+
+    auto start_client = [&](size_t i) {
+        // Lets the interpreter take its locks so the child inherits them in a sane
+        // state; the child then resets its GIL and thread state
+        PyOS_BeforeFork();
+        pid_t pid = fork();
+        if (pid == 0) {
+            PyOS_AfterFork_Child();
+            int code = run_client(uids[i], algos[i]);
+            std::cout.flush();
+            std::cerr.flush();
+            _exit(code);
+        }
+        PyOS_AfterFork_Parent();
+        if (pid < 0) {
+            std::cerr << "Failed to fork client " << uids[i] << std::endl;
+            return false;
+        }
+        children.emplace(pid, i);
+        return true;
+    };
+
+    for (size_t i = 0; i < uids.size(); i++) {
+        if (!start_client(i)) {
+            failures++;
+        }
+    }
+
+    while (!children.empty()) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        auto child = children.find(pid);
+        if (child == children.end()) {
+            continue;
+        }
+        size_t i = child->second;
+        children.erase(child);
+
+        report_exit(uids[i], pid, status);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            continue;
+        }
+        if (restarts[i] >= max_restarts || !start_client(i)) {
+            failures++;
+            continue;
+        }
+        restarts[i]++;
+        std::cerr << "Restarted client " << uids[i] << " (restart " << restarts[i]
+                  << " of " << max_restarts << ")" << std::endl;
+    }
+
+    return failures;
+}
+
+} // namespace fork_server
+} // namespace nutc
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief Starts many clients from a single warm process
+ *
+ * Instead of the exchange exec'ing one NUTC-client per user, a fork server starts
+ * the interpreter and imports common modules once, downloads every algorithm in
+ * parallel, and then forks a child per user. Children inherit the initialized
+ * interpreter and their algorithm, so they only need to connect to the exchange
+ */
+namespace fork_server {
+
+using AlgoFetcher = std::function<std::optional<std::string>(const std::string&)>;
+using ClientRunner =
+    std::function<int(const std::string&, const std::optional<std::string>&)>;
+
+/**
+ * @brief Fetches the algorithm of every uid concurrently
+ *
+ * @param fetch Called from worker threads; exceptions are treated as a missing algo
+ * @param max_parallel Upper bound on the number of concurrent fetches
+ * @returns One entry per uid, in the same order
+ */
+std::vector<std::optional<std::string>> prefetch_algos(
+    const std::vector<std::string>& uids,
+    const AlgoFetcher& fetch,
+    size_t max_parallel
+);
+
+/**
+ * @brief Forks a child per uid that runs the client, then supervises all of them
+ *
+ * Children are reaped as they exit. Those that crash or exit unsuccessfully are
+ * reported on stderr and forked again, up to max_restarts times each; the exchange
+ * only sees the fork server, so it can't do this itself
+ *
+ * Must be called from a single-threaded process: only the forking thread survives
+ * in the children. The logging backend is one such thread, so it must not be
+ * started before serving
+ *
+ * @param run_client Runs a single client in the child; its result is the exit code
+ * @returns The number of clients that failed to start or still failed once out of
+ * restarts
+ */
+int serve(
+    const std::vector<std::string>& uids,
+    const std::vector<std::optional<std::string>>& algos,
+    const ClientRunner& run_client,
+    int max_restarts
+);
+
+} // namespace fork_server
+} // namespace nutc
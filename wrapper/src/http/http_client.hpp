@@ -0,0 +1,130 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief HTTP client shared by every firebase and storage request
+ *
+ * Curl handles are kept between requests, so that the TCP and TLS handshakes are
+ * only paid once per host instead of once per request. The exchange, wrapper and
+ * linter each build their own copy of this module
+ */
+namespace http {
+
+struct Request {
+    std::string method = "GET";
+    std::string url{};
+    std::string body{};
+    // Receives the response body as it arrives, instead of Response::body; returning
+    // false aborts the transfer
+    std::function<bool(std::string_view)> on_data{};
+    // 0 waits forever
+    long timeout_secs = 0;
+};
+
+struct Response {
+    // Set if the transfer itself failed
+    std::optional<std::string> error{};
+    // 0 for file:// urls
+    long status = 0;
+    std::string body{};
+
+    [[nodiscard]] bool ok() const;
+};
+
+/**
+ * @brief Thread-safe pool of idle curl easy handles
+ *
+ * A handle keeps its open connections when it is returned, so the next request to
+ * the same host skips connecting. Handles also share DNS and TLS session caches
+ */
+class HandlePool {
+public:
+    explicit HandlePool(size_t max_idle);
+    ~HandlePool();
+
+    HandlePool(const HandlePool&) = delete;
+    HandlePool& operator=(const HandlePool&) = delete;
+
+    // Never null; curl failing to allocate a handle is treated like bad_alloc
+    CURL* acquire();
+    void release(CURL* handle);
+
+private:
+    const size_t max_idle;
+    std::mutex mutex;
+    std::vector<CURL*> idle;
+
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> share_mutexes;
+
+    static void lock_share(CURL*, curl_lock_data data, curl_lock_access, void* pool);
+    static void unlock_share(CURL*, curl_lock_data data, void* pool);
+};
+
+class Client {
+public:
+    explicit Client(size_t max_idle_handles = 16);
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    /**
+     * @brief The client of this process
+     *
+     * A forked child gets a new client, since the parent's transfer thread does not
+     * survive the fork and its handles' connections are shared with the parent
+     */
+    static Client& instance();
+
+    // Blocks the calling thread for the whole transfer
+    Response perform(Request request);
+
+    /**
+     * @brief Runs the transfer on a single background curl multi handle
+     *
+     * Transfers to the same host are multiplexed over one HTTP/2 connection where
+     * the server supports it
+     */
+    std::future<Response> perform_async(Request request);
+
+private:
+    struct Transfer {
+        Request request;
+        Response response;
+        std::promise<Response> promise;
+    };
+
+    HandlePool pool;
+
+    // The multi handle and its thread are only created by the first async request
+    std::mutex async_mutex;
+    CURLM* multi = nullptr;
+    std::thread transfer_thread;
+    bool stopping = false;
+    std::vector<std::unique_ptr<Transfer>> pending;
+
+    static size_t write_callback(char* data, size_t size, size_t nmemb, void* userp);
+    static void prepare(CURL* handle, Transfer& transfer);
+    static void finish(CURL* handle, Transfer& transfer, CURLcode result);
+
+    void run_transfers();
+};
+
+} // namespace http
+} // namespace nutc
@@ -1,7 +1,9 @@
 #include "common.hpp"
 #include "dev_mode/dev_mode.hpp"
 #include "firebase/firebase.hpp"
+#include "fork_server/fork_server.hpp"
 #include "git.h"
+#include "native/native_strategy.hpp"
 #include "pywrapper/pywrapper.hpp"
 #include "rabbitmq/rabbitmq.hpp"
 
@@ -10,11 +12,29 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <string>
-#include <tuple>
+#include <vector>
 
-static std::tuple<uint8_t, std::string, bool>
+struct ClientArguments {
+    uint8_t verbosity;
+    bool development_mode;
+    // Empty when running as a fork server
+    std::string uid;
+    // Id of the uid's algo in the on-disk cache; empty if the exchange didn't cache it
+    std::string algo_id;
+    // Only set when running as a fork server
+    std::vector<std::string> fork_server_uids;
+    // The algo_id of each fork server uid, in the same order
+    std::vector<std::string> fork_server_algo_ids;
+    int fork_server_max_restarts;
+    std::vector<std::string> preload_modules;
+    // Path to a native strategy library; empty to run the user's Python algorithm
+    std::string native_strategy;
+};
+
+static ClientArguments
 process_arguments(int argc, const char** argv)
 {
     argparse::ArgumentParser program(
@@ -34,8 +54,34 @@ process_arguments(int argc, const char** argv)
             std::string uid = std::string(value);
             std::replace(uid.begin(), uid.end(), ' ', '-');
             return uid;
-        })
-        .required();
+        });
+
+    program.add_argument("-A", "--algo-id")
+        .help("id of the user's algo in the cache the exchange shares with clients")
+        .default_value(std::string());
+
+    program.add_argument("-F", "--fork-server")
+        .help("run one client per user ID by forking a single warm process")
+        .nargs(argparse::nargs_pattern::at_least_one);
+
+    program.add_argument("--algo-ids")
+        .help("--algo-id of each fork server user ID, in order; empty if not cached")
+        .nargs(argparse::nargs_pattern::any)
+        .default_value(std::vector<std::string>{});
+
+    program.add_argument("--max-restarts")
+        .help("times the fork server restarts each client that crashes")
+        .default_value(FORK_SERVER_MAX_RESTARTS)
+        .scan<'i', int>();
+
+    program.add_argument("-P", "--preload")
+        .help("modules the fork server imports before forking")
+        .nargs(argparse::nargs_pattern::any)
+        .default_value(std::vector<std::string>{FORK_SERVER_PRELOAD_MODULES});
+
+    program.add_argument("-S", "--strategy")
+        .help("run a native strategy library instead of the Python algorithm")
+        .default_value(std::string());
 
     program.add_argument("-V", "--version")
         .help("prints version information and exits")
@@ -56,17 +102,47 @@ process_arguments(int argc, const char** argv)
         .implicit_value(true)
         .nargs(0);
 
+    ClientArguments args;
     try {
         program.parse_args(argc, argv);
+
+        if (program.is_used("--fork-server")) {
+            args.fork_server_uids =
+                program.get<std::vector<std::string>>("--fork-server");
+            for (auto& uid : args.fork_server_uids)
+                std::replace(uid.begin(), uid.end(), ' ', '-');
+
+            args.fork_server_algo_ids =
+                program.get<std::vector<std::string>>("--algo-ids");
+            for (auto& algo_id : args.fork_server_algo_ids)
+                std::replace(algo_id.begin(), algo_id.end(), ' ', '-');
+            if (args.fork_server_algo_ids.empty()) {
+                args.fork_server_algo_ids.resize(args.fork_server_uids.size());
+            }
+            else if (args.fork_server_algo_ids.size() != args.fork_server_uids.size()) {
+                throw std::runtime_error("--algo-ids needs one entry per user ID");
+            }
+        }
+        else if (program.is_used("--uid")) {
+            args.uid = program.get<std::string>("--uid");
+            args.algo_id = program.get<std::string>("--algo-id");
+            std::replace(args.algo_id.begin(), args.algo_id.end(), ' ', '-');
+        }
+        else {
+            throw std::runtime_error("Either --uid or --fork-server is required");
+        }
     } catch (const std::runtime_error& err) {
         std::cerr << err.what() << std::endl;
         std::cerr << program;
         exit(1); // NOLINT(concurrency-*)
     }
 
-    return std::make_tuple(
-        verbosity, program.get<std::string>("--uid"), program.get<bool>("--dev")
-    );
+    args.verbosity = verbosity;
+    args.development_mode = program.get<bool>("--dev");
+    args.preload_modules = program.get<std::vector<std::string>>("--preload");
+    args.fork_server_max_restarts = program.get<int>("--max-restarts");
+    args.native_strategy = program.get<std::string>("--strategy");
+    return args;
 }
 
 static void
@@ -83,13 +159,38 @@ log_build_info()
         log_w(main, "Built from dirty commit!");
 }
 
-int
-main(int argc, const char** argv)
+// Throws instead of logging, so the fork server can call it before logging::init
+static std::optional<std::string>
+fetch_algo(const std::string& uid, const std::string& algo_id, bool development_mode)
 {
-    // Parse args
-    auto [verbosity, uid, development_mode] = process_arguments(argc, argv);
-    pybind11::scoped_interpreter guard{};
+    if (development_mode) {
+        return nutc::dev_mode::get_algo_from_file(uid);
+    }
+    // The exchange already looked up and cached the latest algo
+    if (!algo_id.empty()) {
+        std::optional<std::string> algo = nutc::firebase::read_cached_algo(algo_id);
+        if (algo.has_value()) {
+            return algo;
+        }
+    }
+    return nutc::firebase::get_most_recent_algo(uid);
+}
 
+/**
+ * @brief Runs a single client until the exchange shuts it down
+ *
+ * @param algo The already downloaded algorithm, or nullopt to download it here
+ * @param algo_id The algo's id in the on-disk cache, if the exchange passed one
+ */
+static int
+run_client(
+    const std::string& uid,
+    std::optional<std::string> algo,
+    const std::string& algo_id,
+    uint8_t verbosity,
+    bool development_mode
+)
+{
     // Start logging and print build info
     nutc::logging::init(verbosity, uid);
     log_build_info();
@@ -98,12 +199,12 @@ main(int argc, const char** argv)
     // Initialize the RMQ connection to the exchange
     nutc::rabbitmq::RabbitMQ conn(uid);
 
-    std::optional<std::string> algo;
-    if (development_mode) {
-        algo = nutc::dev_mode::get_algo_from_file(uid);
-    }
-    else {
-        algo = nutc::firebase::get_most_recent_algo(uid);
+    if (!algo.has_value()) {
+        try {
+            algo = fetch_algo(uid, algo_id, development_mode);
+        } catch (const std::exception& e) {
+            log_e(main, "Failed to fetch algo for {}: {}", uid, e.what());
+        }
     }
 
     // Send message to exchange to let it know we successfully initialized
@@ -117,11 +218,105 @@ main(int argc, const char** argv)
     }
     conn.waitForStartTime();
 
-    // Initialize the algorithm. For now, only designed for py
-    nutc::pywrapper::create_api_module(conn.getMarketFunc(uid));
+    // Initialize the algorithm. Native strategies are run by run_native_client
+    nutc::pywrapper::create_api_module(
+        conn.getMarketFunc(uid),
+        conn.getOrderFunc(uid),
+        conn.getBatchMarketFunc(uid),
+        conn.getOrderBooks()
+    );
     nutc::pywrapper::run_code_init(algo.value());
+    nutc::pywrapper::PythonStrategy strategy;
 
     // Main event loop
-    conn.handleIncomingMessages();
+    conn.handleIncomingMessages(strategy);
     return 0;
 }
+
+/**
+ * @brief Runs a native strategy as the given uid until the exchange shuts it down
+ */
+static int
+run_native_client(
+    const std::string& uid,
+    const std::string& strategy_path,
+    uint8_t verbosity
+)
+{
+    nutc::logging::init(verbosity, uid);
+    log_build_info();
+    log_i(main, "Starting NUTC Client for UID {} with a native strategy", uid);
+
+    nutc::rabbitmq::RabbitMQ conn(uid);
+
+    auto strategy = nutc::native::NativeStrategy::load(strategy_path);
+    bool published_init = conn.publishInit(uid, strategy != nullptr);
+    if (!published_init) {
+        log_e(main, "Failed to publish init message");
+        return 1;
+    }
+    if (strategy == nullptr) {
+        return 1;
+    }
+    conn.waitForStartTime();
+
+    strategy->start(conn.getMarketFunc(uid));
+    conn.handleIncomingMessages(*strategy);
+    return 0;
+}
+
+static int
+run_fork_server(const ClientArguments& args)
+{
+    // Imports and downloads happen once here instead of once per client
+    nutc::pywrapper::preload_modules(args.preload_modules);
+
+    std::map<std::string, std::string> algo_ids;
+    for (size_t i = 0; i < args.fork_server_uids.size(); i++) {
+        algo_ids.emplace(args.fork_server_uids[i], args.fork_server_algo_ids[i]);
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    auto algos = nutc::fork_server::prefetch_algos(
+        args.fork_server_uids,
+        [&](const std::string& uid) {
+            return fetch_algo(uid, algo_ids.at(uid), args.development_mode);
+        },
+        FORK_SERVER_PREFETCH_THREADS
+    );
+
+    return nutc::fork_server::serve(
+        args.fork_server_uids,
+        algos,
+        [&](const std::string& uid, const std::optional<std::string>& algo) {
+            int code = run_client(
+                uid, algo, algo_ids.at(uid), args.verbosity, args.development_mode
+            );
+            quill::flush();
+            return code;
+        },
+        args.fork_server_max_restarts
+    );
+}
+
+int
+main(int argc, const char** argv)
+{
+    // Parse args
+    ClientArguments args = process_arguments(argc, argv);
+
+    if (!args.fork_server_uids.empty()) {
+        pybind11::scoped_interpreter guard{};
+        return run_fork_server(args) == 0 ? 0 : 1;
+    }
+
+    // Native strategies never start the interpreter
+    if (!args.native_strategy.empty()) {
+        return run_native_client(args.uid, args.native_strategy, args.verbosity);
+    }
+
+    pybind11::scoped_interpreter guard{};
+    return run_client(
+        args.uid, std::nullopt, args.algo_id, args.verbosity, args.development_mode
+    );
+}
@@ -0,0 +1,138 @@
+#include "native_strategy.hpp"
+
+#include "logging.hpp"
+
+#include <dlfcn.h>
+
+namespace nutc {
+namespace native {
+
+static nutc_side
+to_native_side(messages::SIDE side)
+{
+    return side == messages::SIDE::BUY ? NUTC_SIDE_BUY : NUTC_SIDE_SELL;
+}
+
+std::unique_ptr<NativeStrategy>
+NativeStrategy::load(const std::string& path)
+{
+    void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) {
+        log_e(main, "Failed to load native strategy {}: {}", path, dlerror());
+        return nullptr;
+    }
+
+    auto get_strategy =
+        reinterpret_cast<nutc_get_strategy_fn>(dlsym(library, "nutc_get_strategy"));
+    const nutc_strategy_v1* abi = get_strategy ? get_strategy() : nullptr;
+    if (abi == nullptr) {
+        log_e(main, "Native strategy {} does not export nutc_get_strategy", path);
+        dlclose(library);
+        return nullptr;
+    }
+
+    // Versions only append fields, so every version up to ours starts with v1's.
+    // Fields added by later versions must only be read when abi_version has them
+    bool supported =
+        abi->abi_version >= 1 && abi->abi_version <= NUTC_STRATEGY_ABI_VERSION;
+    if (!supported || abi->create == nullptr || abi->destroy == nullptr
+        || abi->on_orderbook_update == nullptr || abi->on_trade_update == nullptr
+        || abi->on_account_update == nullptr) {
+        log_e(
+            main,
+            "Native strategy {} has ABI version {}, expected 1 to {} with every "
+            "callback",
+            path,
+            abi->abi_version,
+            NUTC_STRATEGY_ABI_VERSION
+        );
+        dlclose(library);
+        return nullptr;
+    }
+
+    log_i(main, "Loaded native strategy {}", path);
+    return std::unique_ptr<NativeStrategy>(new NativeStrategy(library, abi));
+}
+
+NativeStrategy::NativeStrategy(void* library, const nutc_strategy_v1* abi) :
+    library(library), abi(abi)
+{}
+
+NativeStrategy::~NativeStrategy()
+{
+    if (instance != nullptr) {
+        abi->destroy(instance);
+    }
+    dlclose(library);
+}
+
+void
+NativeStrategy::start(PlaceOrderFunction place_market_order)
+{
+    this->place_market_order = std::move(place_market_order);
+    instance = abi->create(&NativeStrategy::place_order_trampoline, this);
+}
+
+bool
+NativeStrategy::place_order_trampoline(
+    void* context,
+    nutc_side side,
+    const char* ticker,
+    float quantity,
+    float price
+)
+{
+    auto* strategy = static_cast<NativeStrategy*>(context);
+    return strategy->place_market_order(
+        side == NUTC_SIDE_BUY ? "BUY" : "SELL", ticker, quantity, price
+    );
+}
+
+void
+NativeStrategy::on_orderbook_update(const messages::ObUpdate& update)
+{
+    if (instance == nullptr) {
+        return;
+    }
+    abi->on_orderbook_update(
+        instance,
+        update.security.c_str(),
+        to_native_side(update.side),
+        update.price,
+        update.quantity
+    );
+}
+
+void
+NativeStrategy::on_trade_update(const messages::Match& match)
+{
+    if (instance == nullptr) {
+        return;
+    }
+    abi->on_trade_update(
+        instance,
+        match.ticker.c_str(),
+        to_native_side(match.side),
+        match.price,
+        match.quantity
+    );
+}
+
+void
+NativeStrategy::on_account_update(const messages::AccountUpdate& update)
+{
+    if (instance == nullptr) {
+        return;
+    }
+    abi->on_account_update(
+        instance,
+        update.ticker.c_str(),
+        to_native_side(update.side),
+        update.price,
+        update.quantity,
+        update.capital_remaining
+    );
+}
+
+} // namespace native
+} // namespace nutc
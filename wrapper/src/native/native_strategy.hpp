@@ -0,0 +1,66 @@
+#pragma once
+
+#include "native/strategy_abi.h"
+#include "strategy/strategy.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace nutc {
+
+/**
+ * @brief Runs strategies compiled to shared libraries against native/strategy_abi.h
+ *
+ * An alternative to the embedded interpreter for strategies that need to react in
+ * microseconds
+ */
+namespace native {
+
+using PlaceOrderFunction =
+    std::function<bool(const std::string&, const std::string&, float, float)>;
+
+/**
+ * @class NativeStrategy
+ * @brief A strategy loaded with dlopen, calling straight into its callbacks
+ */
+class NativeStrategy : public strategy::Strategy {
+public:
+    /**
+     * @brief Loads the library and checks it exports a compatible strategy
+     * @returns nullptr (after logging why) if it can't be used
+     */
+    static std::unique_ptr<NativeStrategy> load(const std::string& path);
+
+    ~NativeStrategy() override;
+
+    /**
+     * @brief Creates the strategy's state; callbacks before this are dropped
+     * @param place_market_order Takes side, ticker, quantity and price, like the
+     * Python API's place_market_order
+     */
+    void start(PlaceOrderFunction place_market_order);
+
+    void on_orderbook_update(const messages::ObUpdate& update) override;
+    void on_trade_update(const messages::Match& match) override;
+    void on_account_update(const messages::AccountUpdate& update) override;
+
+private:
+    NativeStrategy(void* library, const nutc_strategy_v1* abi);
+
+    static bool place_order_trampoline(
+        void* context,
+        nutc_side side,
+        const char* ticker,
+        float quantity,
+        float price
+    );
+
+    void* library;
+    const nutc_strategy_v1* abi;
+    void* instance = nullptr;
+    PlaceOrderFunction place_market_order;
+};
+
+} // namespace native
+} // namespace nutc
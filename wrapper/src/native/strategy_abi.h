@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * Stable C ABI for native strategies.
+ *
+ * A strategy is a shared library exporting
+ *
+ *     const nutc_strategy_v1* nutc_get_strategy(void);
+ *
+ * and is run with `NUTC-client --uid <uid> --strategy <path to .so>`. Only this header
+ * is needed to build one. All callbacks are made from the client's event loop thread,
+ * one at a time; place_market_order must only be called from that thread.
+ *
+ * New fields are only ever appended, with a new NUTC_STRATEGY_ABI_VERSION. The client
+ * loads any version from 1 up to its own and reads only the fields the plugin's version
+ * defines, so plugins built against an older header keep working.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUTC_STRATEGY_ABI_VERSION 1
+
+typedef enum { NUTC_SIDE_BUY = 0, NUTC_SIDE_SELL = 1 } nutc_side;
+
+/**
+ * Places an order on behalf of the strategy. Returns false if it was rate limited.
+ * `context` is the value given to create.
+ */
+typedef bool (*nutc_place_market_order_fn)(
+    void* context, nutc_side side, const char* ticker, float quantity, float price
+);
+
+typedef struct {
+    /* NUTC_STRATEGY_ABI_VERSION of the header the plugin was built against */
+    uint32_t abi_version;
+
+    /* Creates the strategy once the exchange has started; returns its state */
+    void* (*create)(nutc_place_market_order_fn place_market_order, void* context);
+    void (*destroy)(void* strategy);
+
+    void (*on_orderbook_update)(
+        void* strategy, const char* ticker, nutc_side side, float price, float quantity
+    );
+    void (*on_trade_update)(
+        void* strategy, const char* ticker, nutc_side side, float price, float quantity
+    );
+    void (*on_account_update)(
+        void* strategy,
+        const char* ticker,
+        nutc_side side,
+        float price,
+        float quantity,
+        float capital_remaining
+    );
+} nutc_strategy_v1;
+
+typedef const nutc_strategy_v1* (*nutc_get_strategy_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+#include "orderbook.hpp"
+
+#include <algorithm>
+
+namespace nutc {
+namespace orderbook {
+
+BookSide::BookSide(messages::SIDE side, size_t capacity) :
+    side(side), capacity_(capacity), levels(2 * capacity)
+{}
+
+bool
+BookSide::better(float price, float other) const
+{
+    return side == messages::SIDE::BUY ? price > other : price < other;
+}
+
+void
+BookSide::set_level(float price, float quantity)
+{
+    float* begin = mutable_prices();
+    float* end = begin + depth_;
+    float* level = std::lower_bound(begin, end, price, [this](float lhs, float rhs) {
+        return better(lhs, rhs);
+    });
+    auto index = static_cast<size_t>(level - begin);
+
+    if (level != end && *level == price) {
+        if (quantity > 0)
+            mutable_quantities()[index] = quantity;
+        else
+            erase_level(index);
+        return;
+    }
+
+    if (quantity > 0)
+        insert_level(index, price, quantity);
+}
+
+void
+BookSide::insert_level(size_t index, float price, float quantity)
+{
+    if (index >= capacity_)
+        return;
+
+    // Make room by dropping the deepest level
+    if (depth_ == capacity_)
+        depth_--;
+
+    float* prices = mutable_prices();
+    float* quantities = mutable_quantities();
+    std::copy_backward(prices + index, prices + depth_, prices + depth_ + 1);
+    std::copy_backward(quantities + index, quantities + depth_, quantities + depth_ + 1);
+    prices[index] = price;
+    quantities[index] = quantity;
+    depth_++;
+}
+
+void
+BookSide::erase_level(size_t index)
+{
+    float* prices = mutable_prices();
+    float* quantities = mutable_quantities();
+    std::copy(prices + index + 1, prices + depth_, prices + index);
+    std::copy(quantities + index + 1, quantities + depth_, quantities + index);
+    depth_--;
+    // Python views span the whole capacity, so vacated levels must not look live
+    prices[depth_] = 0;
+    quantities[depth_] = 0;
+}
+
+Book::Book(size_t capacity) :
+    bids(messages::SIDE::BUY, capacity), asks(messages::SIDE::SELL, capacity)
+{}
+
+OrderBooks::OrderBooks(size_t capacity) : capacity(capacity) {}
+
+void
+OrderBooks::apply(const messages::ObUpdate& update)
+{
+    BookSide& side = get_book(update.security).get_side(update.side);
+    side.set_level(update.price, update.quantity);
+}
+
+Book&
+OrderBooks::get_book(const std::string& ticker)
+{
+    return books.try_emplace(ticker, capacity).first->second;
+}
+
+} // namespace orderbook
+} // namespace nutc
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "util/messages.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief Native level 2 order books, kept up to date from the exchange's ObUpdates,
+ * each of which carries the new total of one price level
+ *
+ * Levels are stored in flat, fixed capacity arrays so Python can read them through
+ * NumPy views without copying or allocating per level
+ */
+namespace orderbook {
+
+/**
+ * @class BookSide
+ * @brief The price levels of one side of a book, best price first
+ *
+ * Storage is a single buffer of 2 * capacity floats: prices, then quantities. It is
+ * never reallocated, so pointers into it stay valid for the life of the BookSide.
+ * Entries past the depth are zero
+ */
+class BookSide {
+public:
+    BookSide(messages::SIDE side, size_t capacity);
+
+    /**
+     * @brief Sets the quantity resting at a price, removing the level if it is zero
+     * Levels worse than the deepest one are dropped once the side is at capacity
+     */
+    void set_level(float price, float quantity);
+
+    size_t
+    depth() const
+    {
+        return depth_;
+    }
+
+    size_t
+    capacity() const
+    {
+        return capacity_;
+    }
+
+    const float*
+    prices() const
+    {
+        return levels.data();
+    }
+
+    const float*
+    quantities() const
+    {
+        return levels.data() + capacity_;
+    }
+
+private:
+    messages::SIDE side;
+    size_t capacity_;
+    size_t depth_ = 0;
+    std::vector<float> levels;
+
+    float*
+    mutable_prices()
+    {
+        return levels.data();
+    }
+
+    float*
+    mutable_quantities()
+    {
+        return levels.data() + capacity_;
+    }
+
+    bool better(float price, float other) const;
+    void insert_level(size_t index, float price, float quantity);
+    void erase_level(size_t index);
+};
+
+struct Book {
+    BookSide bids;
+    BookSide asks;
+
+    explicit Book(size_t capacity);
+
+    BookSide&
+    get_side(messages::SIDE side)
+    {
+        return side == messages::SIDE::BUY ? bids : asks;
+    }
+};
+
+/**
+ * @class OrderBooks
+ * @brief One Book per ticker, created the first time the ticker is seen
+ *
+ * References to books stay valid as new tickers are added
+ */
+class OrderBooks {
+public:
+    explicit OrderBooks(size_t capacity);
+
+    void apply(const messages::ObUpdate& update);
+
+    Book& get_book(const std::string& ticker);
+
+private:
+    size_t capacity;
+    std::unordered_map<std::string, Book> books;
+};
+
+} // namespace orderbook
+} // namespace nutc
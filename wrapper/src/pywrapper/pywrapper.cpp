@@ -1,18 +1,74 @@
 #include "pywrapper.hpp"
 
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <iostream>
+
 namespace nutc {
 namespace pywrapper {
 
+/**
+ * @brief A zero-copy 2 x capacity view of a book side's prices and quantities
+ *
+ * The whole capacity is exposed so the view stays correct as levels are added or
+ * removed
+ */
+static py::array_t<float>
+book_side_view(const orderbook::BookSide& side)
+{
+    // The books outlive the interpreter's use of them, so the owner doesn't free
+    py::capsule owner(&side, [](void* /* unused */) {});
+    py::array_t<float> view(
+        {size_t{2}, side.capacity()},
+        {side.capacity() * sizeof(float), sizeof(float)},
+        side.prices(),
+        owner
+    );
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
 void
 create_api_module(
     std::function<bool(const std::string&, const std::string&, float, float)>
-        publish_market_order
+        publish_market_order,
+    PublishOrderFunction publish_order,
+    PublishOrdersFunction publish_orders,
+    orderbook::OrderBooks& books
 )
 {
     py::module m = py::module::create_extension_module(
         "nutc_api", "NUTC Exchange API", new py::module::module_def
     );
     m.def("publish_market_order", publish_market_order);
+    m.def("publish_order", publish_order);
+    m.def("publish_orders", publish_orders);
+
+    py::class_<orderbook::Book>(m, "OrderBook")
+        .def(
+            "bids",
+            [](const orderbook::Book& book) { return book_side_view(book.bids); }
+        )
+        .def(
+            "asks",
+            [](const orderbook::Book& book) { return book_side_view(book.asks); }
+        )
+        .def(
+            "bid_depth",
+            [](const orderbook::Book& book) { return book.bids.depth(); }
+        )
+        .def(
+            "ask_depth",
+            [](const orderbook::Book& book) { return book.asks.depth(); }
+        );
+    m.def(
+        "get_orderbook",
+        [&books](const std::string& ticker) -> orderbook::Book& {
+            return books.get_book(ticker);
+        },
+        py::return_value_policy::reference
+    );
 
     py::module_ sys = py::module_::import("sys");
     py::dict sys_modules = sys.attr("modules").cast<py::dict>();
@@ -21,22 +77,111 @@ create_api_module(
     py::exec(R"(import nutc_api)");
 }
 
-const py::object
-get_ob_update_function()
+static std::optional<py::object>
+get_optional_function(const py::object& strat, const char* name)
+{
+    if (!py::hasattr(strat, name)) {
+        return std::nullopt;
+    }
+    return strat.attr(name);
+}
+
+StrategyCallbacks
+get_strategy_callbacks()
+{
+    py::object strat = py::globals()["strat"];
+    return StrategyCallbacks{
+        strat.attr("on_orderbook_update"),
+        strat.attr("on_trade_update"),
+        strat.attr("on_account_update"),
+        get_optional_function(strat, "on_orderbook_updates"),
+        get_optional_function(strat, "on_order_rejected")
+    };
+}
+
+PythonStrategy::PythonStrategy() : callbacks(get_strategy_callbacks()) {}
+
+void
+PythonStrategy::on_orderbook_update(const messages::ObUpdate& update)
+{
+    callbacks.on_orderbook_update(
+        update.security, callbacks.side(update.side), update.price, update.quantity
+    );
+}
+
+bool
+PythonStrategy::batches_orderbook_updates() const
 {
-    return py::globals()["strat"].attr("on_orderbook_update");
+    return callbacks.on_orderbook_updates.has_value();
 }
 
-const py::object
-get_trade_update_function()
+void
+PythonStrategy::on_orderbook_updates(const std::vector<messages::ObUpdate>& updates)
+{
+    if (!batches_orderbook_updates()) {
+        strategy::Strategy::on_orderbook_updates(updates);
+        return;
+    }
+
+    py::list batch(updates.size());
+    for (size_t i = 0; i < updates.size(); i++) {
+        const messages::ObUpdate& update = updates[i];
+        batch[i] = py::make_tuple(
+            update.security,
+            callbacks.side(update.side),
+            update.price,
+            update.quantity
+        );
+    }
+    callbacks.on_orderbook_updates.value()(batch);
+}
+
+void
+PythonStrategy::on_trade_update(const messages::Match& match)
+{
+    callbacks.on_trade_update(
+        match.ticker, callbacks.side(match.side), match.price, match.quantity
+    );
+}
+
+void
+PythonStrategy::on_account_update(const messages::AccountUpdate& update)
+{
+    callbacks.on_account_update(
+        update.ticker,
+        callbacks.side(update.side),
+        update.price,
+        update.quantity,
+        update.capital_remaining
+    );
+}
+
+void
+PythonStrategy::on_order_rejected(const messages::OrderReject& reject)
 {
-    return py::globals()["strat"].attr("on_trade_update");
+    if (!callbacks.on_order_rejected.has_value()) {
+        return;
+    }
+    callbacks.on_order_rejected.value()(
+        reject.ticker,
+        callbacks.side(reject.side),
+        reject.price,
+        reject.quantity,
+        messages::reject_reason_to_string(reject.reason)
+    );
 }
 
-const py::object
-get_account_update_function()
+void
+preload_modules(const std::vector<std::string>& modules)
 {
-    return py::globals()["strat"].attr("on_account_update");
+    for (const auto& module : modules) {
+        try {
+            py::module_::import(module.c_str());
+        } catch (const py::error_already_set& e) {
+            std::cerr << "Skipping preload of " << module << ": " << e.what()
+                      << std::endl;
+        }
+    }
 }
 
 void
@@ -44,8 +189,24 @@ run_code_init(const std::string& py_code)
 {
     py::exec(py_code);
     py::exec(R"(
-        def place_market_order(side, ticker, quantity, price):
-            nutc_api.publish_market_order(side, ticker, quantity, price)
+        def place_market_order(
+            side, ticker, quantity, price, order_type="LIMIT", time_in_force="GTC"
+        ):
+            if order_type == "LIMIT" and time_in_force == "GTC":
+                return nutc_api.publish_market_order(side, ticker, quantity, price)
+            return nutc_api.publish_order(
+                side, ticker, quantity, price, order_type, time_in_force
+            )
+
+        def place_market_orders(orders):
+            # Fills in the order type and time in force orders leave out
+            defaults = ("LIMIT", "GTC")
+            return nutc_api.publish_orders(
+                [tuple(order) + defaults[len(order) - 4 :] for order in orders]
+            )
+
+        def get_orderbook(ticker):
+            return nutc_api.get_orderbook(ticker)
     )");
     py::exec("strat = Strategy()");
 }
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "logging.hpp"
+#include "orderbook/orderbook.hpp"
+#include "strategy/strategy.hpp"
 #include "util/messages.hpp"
 
 #include <pybind11/embed.h>
 #include <pybind11/pybind11.h>
 
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace py = pybind11;
 
 namespace nutc {
@@ -16,26 +23,95 @@ namespace nutc {
  * Contains functions to create the Python API module and run the client algorithm
  */
 namespace pywrapper {
+
+// side, ticker, quantity, price, order type, time in force; as taken by
+// place_market_order
+using OrderParameters =
+    std::tuple<std::string, std::string, float, float, std::string, std::string>;
+
+/**
+ * @brief Places one order of the given type (LIMIT, MARKET or POST_ONLY) and time in
+ * force (GTC, IOC or FOK)
+ * Takes side, ticker, quantity, price, order type and time in force
+ */
+using PublishOrderFunction = std::function<bool(
+    const std::string&,
+    const std::string&,
+    float,
+    float,
+    const std::string&,
+    const std::string&
+)>;
+
 /**
- * @brief Gets the callback function for orderbook orderbook_update
+ * @brief Places several orders with one message to the exchange
+ * @returns How many orders, from the front, were placed; the rest were rate limited
+ * or had an unknown order type or time in force
+ */
+using PublishOrdersFunction =
+    std::function<size_t(const std::vector<OrderParameters>&)>;
+
+/**
+ * @brief The algorithm's callbacks, bound to its Strategy instance
  *
- * Designed to be triggered by the rabbitmq class when an orderbook update is received
+ * Looked up once after initialization so the event loop doesn't search the
+ * interpreter's globals on every message
  */
-const py::object get_ob_update_function();
+struct StrategyCallbacks {
+    py::object on_orderbook_update;
+    py::object on_trade_update;
+    py::object on_account_update;
+
+    /**
+     * Optional on_orderbook_updates(updates), called with a list of
+     * (ticker, side, price, quantity) tuples instead of on_orderbook_update
+     */
+    std::optional<py::object> on_orderbook_updates;
+
+    /**
+     * Optional on_order_rejected(ticker, side, price, quantity, reason), so algorithms
+     * can learn why the exchange refused an order instead of blindly resending it
+     */
+    std::optional<py::object> on_order_rejected;
+
+    // Side arguments, created once instead of converted on every call
+    py::str buy_side{"BUY"};
+    py::str sell_side{"SELL"};
+
+    const py::str&
+    side(messages::SIDE order_side) const
+    {
+        return order_side == messages::SIDE::BUY ? buy_side : sell_side;
+    }
+};
 
 /**
- * @brief Gets the callback function for trade updates
+ * @brief Binds all callbacks of the algorithm's Strategy instance
  *
- * Designed to be triggered by the rabbitmq class when a trade update is received
+ * Must be called after run_code_init
  */
-const py::object get_trade_update_function();
+StrategyCallbacks get_strategy_callbacks();
 
 /**
- * @brief Gets the callback function for account updates
+ * @class PythonStrategy
+ * @brief Forwards the exchange's messages to the Python algorithm's callbacks
  *
- * Designed to be triggered by the rabbitmq class when an account update is received
+ * Must be constructed after run_code_init
  */
-const py::object get_account_update_function();
+class PythonStrategy : public strategy::Strategy {
+public:
+    PythonStrategy();
+
+    void on_orderbook_update(const messages::ObUpdate& update) override;
+    bool batches_orderbook_updates() const override;
+    void on_orderbook_updates(const std::vector<messages::ObUpdate>& updates) override;
+    void on_trade_update(const messages::Match& match) override;
+    void on_account_update(const messages::AccountUpdate& update) override;
+    void on_order_rejected(const messages::OrderReject& reject) override;
+
+private:
+    StrategyCallbacks callbacks;
+};
 
 /**
  * @brief Creates the Python API module
@@ -44,14 +120,42 @@ const py::object get_account_update_function();
  * This allows the client algorithm to place orders with the global function
  * "place_market_order" which is a callback to the rabbitmq class
  *
+ * It also exposes get_orderbook(ticker), whose bids() and asks() return read-only
+ * 2 x capacity float32 NumPy arrays (prices, then quantities; best level first) that
+ * view the native book directly. bid_depth() and ask_depth() give how many columns
+ * are levels; the rest are zero. The arrays reflect later updates, so algorithms
+ * should copy them to keep a snapshot
+ *
+ * publish_orders (exposed to algorithms as place_market_orders) takes a list of
+ * (side, ticker, quantity, price, order_type, time_in_force) tuples and sends them in
+ * one message. place_market_orders also accepts tuples without the last one or two
+ * fields, which default to LIMIT and GTC
+ *
+ * publish_order is used by place_market_order when it is given an order_type or
+ * time_in_force other than the default LIMIT and GTC
+ *
  * @param publish_market_order The callback function to place market orders
+ * @param publish_order The callback function to place orders of any type
+ * @param publish_orders The callback function to place a batch of market orders
+ * @param books The order books kept up to date by the rabbitmq class
  */
 void create_api_module(
     std::function<
         bool(const std::string&, const std::string&, float, float)>
-        publish_market_order
+        publish_market_order,
+    PublishOrderFunction publish_order,
+    PublishOrdersFunction publish_orders,
+    orderbook::OrderBooks& books
 );
 
+/**
+ * @brief Imports modules into the interpreter ahead of running any algorithm
+ *
+ * Used by the fork server so every forked client starts with them already loaded.
+ * Modules that aren't installed are skipped
+ */
+void preload_modules(const std::vector<std::string>& modules);
+
 /**
  * @brief Runs the initialize() function in the client algorithm
  */
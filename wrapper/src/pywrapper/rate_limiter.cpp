@@ -1,21 +1,30 @@
 #include "rate_limiter.hpp"
 
+#include <algorithm>
+
 namespace nutc {
 namespace rate_limiter {
+RateLimiter::RateLimiter(double burst, double refill_per_sec) :
+    burst(burst),
+    refill_per_sec(refill_per_sec),
+    tokens(burst),
+    last_refill(std::chrono::steady_clock::now())
+{}
+
 bool
 RateLimiter::should_rate_limit()
 {
     auto now = std::chrono::steady_clock::now();
 
-    while (!timestamps.empty() && (now - timestamps.front()) > TIME_WINDOW) {
-        timestamps.pop();
-    }
+    std::chrono::duration<double> elapsed = now - last_refill;
+    tokens = std::min(burst, tokens + elapsed.count() * refill_per_sec);
+    last_refill = now;
 
-    if (timestamps.size() >= MAX_CALLS) {
+    if (tokens < 1.0) {
         return true;
     }
 
-    timestamps.push(now);
+    tokens -= 1.0;
     return false;
 }
 } // namespace rate_limiter
@@ -1,18 +1,32 @@
-#include <chrono>
+#pragma once
+
+#include "config.h"
 
-#include <iostream>
-#include <queue>
-#include <stdexcept>
+#include <chrono>
 
 namespace nutc {
 namespace rate_limiter {
+/**
+ * @class RateLimiter
+ * @brief Token bucket limiting how fast the algo can place orders
+ *
+ * Holds up to `burst` tokens and regains `refill_per_sec` tokens every second, so
+ * state stays constant no matter how many orders are placed. The exchange enforces
+ * the same limit per client and rejects anything over it
+ */
 class RateLimiter {
 private:
-    std::queue<std::chrono::steady_clock::time_point> timestamps;
-    const size_t MAX_CALLS = 30;
-    const std::chrono::seconds TIME_WINDOW = std::chrono::seconds(60);
+    double burst;
+    double refill_per_sec;
+    double tokens;
+    std::chrono::steady_clock::time_point last_refill;
 
 public:
+    explicit RateLimiter(
+        double burst = ORDER_RATE_LIMIT_BURST,
+        double refill_per_sec = ORDER_RATE_LIMIT_PER_SEC
+    );
+
     bool should_rate_limit();
 };
 } // namespace rate_limiter
@@ -2,11 +2,23 @@
 
 #include "logging.hpp"
 
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include <array>
 #include <chrono>
 
 namespace nutc {
 namespace rabbitmq {
 
+static void
+wake_io_thread(int outbound_event)
+{
+    uint64_t wake = 1;
+    // Can only fail if the counter would overflow, in which case it is already set
+    [[maybe_unused]] ssize_t written = write(outbound_event, &wake, sizeof(wake));
+}
+
 bool
 RabbitMQ::connectToRabbitMQ(
     const std::string& hostname,
@@ -48,76 +60,206 @@ RabbitMQ::connectToRabbitMQ(
 }
 
 std::variant<ShutdownMessage, RMQError>
-RabbitMQ::handleIncomingMessages()
+RabbitMQ::handleIncomingMessages(strategy::Strategy& strategy)
 {
+    bool batch_updates = strategy.batches_orderbook_updates();
+    std::vector<ObUpdate> pending_updates;
+
+    startIoThread();
     while (true) {
-        std::variant<
-            StartTime,
-            ShutdownMessage,
-            RMQError,
-            ObUpdate,
-            Match,
-            AccountUpdate>
-            data = consumeMessage();
-        if (std::holds_alternative<ShutdownMessage>(data)) {
-            log_w(
-                rabbitmq,
-                "Received shutdown message: {}",
-                std::get<ShutdownMessage>(data).shutdown_reason
-            );
-            return std::get<ShutdownMessage>(data);
+        IncomingMessage data = nextMessage();
+        if (std::holds_alternative<ObUpdate>(data)) {
+            books.apply(std::get<ObUpdate>(data));
         }
-        else if (std::holds_alternative<RMQError>(data)) {
-            log_e(
-                rabbitmq,
-                "Failed to consume message: {}",
-                std::get<RMQError>(data).message
-            );
-            return std::get<RMQError>(data);
+
+        // Order book updates that have already arrived are collected and delivered
+        // together, so the algorithm pays for one callback instead of one per update
+        if (batch_updates && std::holds_alternative<ObUpdate>(data)) {
+            pending_updates.push_back(std::get<ObUpdate>(data));
+            if (pending_updates.size() < ORDERBOOK_BATCH_LIMIT && !inbound.empty()) {
+                continue;
+            }
+            dispatchOrderbookUpdates(strategy, pending_updates);
+            continue;
         }
-        else if (std::holds_alternative<ObUpdate>(data)) {
-            log_i(
-                rabbitmq,
-                "Received order book update: {}",
-                glz::write_json(std::get<ObUpdate>(data))
-            );
-            ObUpdate update = std::get<ObUpdate>(data);
-            std::string side = update.side == messages::SIDE::BUY ? "BUY" : "SELL";
-            nutc::pywrapper::get_ob_update_function()(
-                update.security, side, update.price, update.quantity
-            );
+
+        // Anything else is handled after the updates that preceded it
+        if (!pending_updates.empty()) {
+            dispatchOrderbookUpdates(strategy, pending_updates);
         }
-        else if (std::holds_alternative<Match>(data)) {
-            log_i(
-                rabbitmq, "Received match: {}", glz::write_json(std::get<Match>(data))
-            );
-            Match match = std::get<Match>(data);
-            std::string side = match.side == messages::SIDE::BUY ? "BUY" : "SELL";
-            nutc::pywrapper::get_trade_update_function()(
-                match.ticker, side, match.price, match.quantity
-            );
+
+        auto result = handleMessage(strategy, data);
+        if (result.has_value()) {
+            stopIoThread();
+            return result.value();
         }
-        else if (std::holds_alternative<AccountUpdate>(data)) {
-            AccountUpdate update = std::get<AccountUpdate>(data);
-            log_i(
-                rabbitmq,
-                "Received account update with capital remaining: {}",
-                update.capital_remaining
-            );
-            std::string side = update.side == messages::SIDE::BUY ? "BUY" : "SELL";
-            nutc::pywrapper::get_account_update_function()(
-                update.ticker,
-                side,
-                update.price,
-                update.quantity,
-                update.capital_remaining
-            );
+    }
+}
+
+void
+RabbitMQ::dispatchOrderbookUpdates(
+    strategy::Strategy& strategy, std::vector<ObUpdate>& updates
+)
+{
+    log_i(rabbitmq, "Received {} order book updates", updates.size());
+    strategy.on_orderbook_updates(updates);
+    updates.clear();
+}
+
+std::optional<std::variant<ShutdownMessage, RMQError>>
+RabbitMQ::handleMessage(strategy::Strategy& strategy, const IncomingMessage& data)
+{
+    if (std::holds_alternative<ShutdownMessage>(data)) {
+        log_w(
+            rabbitmq,
+            "Received shutdown message: {}",
+            std::get<ShutdownMessage>(data).shutdown_reason
+        );
+        return std::get<ShutdownMessage>(data);
+    }
+    else if (std::holds_alternative<RMQError>(data)) {
+        log_e(
+            rabbitmq, "Failed to consume message: {}", std::get<RMQError>(data).message
+        );
+        return std::get<RMQError>(data);
+    }
+    else if (std::holds_alternative<ObUpdate>(data)) {
+        const ObUpdate& update = std::get<ObUpdate>(data);
+        log_i(rabbitmq, "Received order book update: {}", glz::write_json(update));
+        strategy.on_orderbook_update(update);
+    }
+    else if (std::holds_alternative<Match>(data)) {
+        const Match& match = std::get<Match>(data);
+        log_i(rabbitmq, "Received match: {}", glz::write_json(match));
+        strategy.on_trade_update(match);
+    }
+    else if (std::holds_alternative<AccountUpdate>(data)) {
+        const AccountUpdate& update = std::get<AccountUpdate>(data);
+        log_i(
+            rabbitmq,
+            "Received account update with capital remaining: {}",
+            update.capital_remaining
+        );
+        strategy.on_account_update(update);
+    }
+    else if (std::holds_alternative<OrderAck>(data)) {
+        log_i(
+            rabbitmq,
+            "Order accepted by exchange: {}",
+            glz::write_json(std::get<OrderAck>(data))
+        );
+    }
+    else if (std::holds_alternative<OrderReject>(data)) {
+        const OrderReject& reject = std::get<OrderReject>(data);
+        log_w(
+            rabbitmq,
+            "Order rejected by exchange with reason {}: {}",
+            messages::reject_reason_to_string(reject.reason),
+            glz::write_json(reject)
+        );
+        strategy.on_order_rejected(reject);
+    }
+    else {
+        log_e(rabbitmq, "Unknown message type");
+        return RMQError{"Unknown message type"};
+    }
+    return std::nullopt;
+}
+
+void
+RabbitMQ::startIoThread()
+{
+    io_running = true;
+    io_thread = std::thread([this] { runIo(); });
+}
+
+void
+RabbitMQ::stopIoThread()
+{
+    if (!io_thread.joinable()) {
+        return;
+    }
+
+    io_running = false;
+    wake_io_thread(outbound_event);
+
+    // The I/O thread may be waiting for room in the inbound queue
+    while (!io_finished) {
+        inbound.try_pop();
+        std::this_thread::yield();
+    }
+    io_thread.join();
+}
+
+void
+RabbitMQ::runIo()
+{
+    std::array<pollfd, 2> fds{
+        pollfd{amqp_socket_get_sockfd(amqp_get_socket(conn)), POLLIN, 0},
+        pollfd{outbound_event, POLLIN, 0}
+    };
+
+    while (io_running) {
+        flushOutbound();
+
+        // Frames rabbitmq-c has already read from the socket won't wake poll()
+        bool buffered = amqp_frames_enqueued(conn) || amqp_data_in_buffer(conn);
+        if (!buffered) {
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                continue;
+            }
+            if (fds[1].revents & POLLIN) {
+                uint64_t count = 0;
+                [[maybe_unused]] ssize_t bytes =
+                    read(outbound_event, &count, sizeof(count));
+            }
+            if (!(fds[0].revents & POLLIN)) {
+                continue;
+            }
+        }
+
+        IncomingMessage message = consumeMessage();
+        bool last_message = std::holds_alternative<ShutdownMessage>(message)
+                            || std::holds_alternative<RMQError>(message);
+
+        while (!inbound.try_push(std::move(message))) {
+            // The algorithm is behind; this backs up into the socket and the broker
+            inbound.wait_for_space();
         }
-        else {
-            log_e(rabbitmq, "Unknown message type");
-            return RMQError{"Unknown message type"};
+        if (last_message) {
+            break;
         }
     }
+
+    io_finished = true;
+}
+
+void
+RabbitMQ::flushOutbound()
+{
+    while (auto message = outbound.try_pop()) {
+        if (!publishMessage("market_order", message.value())) {
+            log_e(rabbitmq, "Failed to publish order: {}", message.value());
+        }
+    }
+}
+
+RabbitMQ::IncomingMessage
+RabbitMQ::nextMessage()
+{
+    while (true) {
+        if (auto message = inbound.try_pop()) {
+            return std::move(message.value());
+        }
+
+        // Python threads the algorithm started may run while we wait. Native
+        // strategies run without an interpreter, so there is no GIL to release
+        std::optional<py::gil_scoped_release> release;
+        if (Py_IsInitialized()) {
+            release.emplace();
+        }
+        inbound.wait_for_items();
+    }
 }
 
 bool
@@ -129,6 +271,34 @@ RabbitMQ::publishMarketOrder(
     float price
 )
 {
+    return publishOrder(client_uid, side, ticker, quantity, price, "LIMIT", "GTC");
+}
+
+bool
+RabbitMQ::publishOrder(
+    const std::string& client_uid,
+    const std::string& side,
+    const std::string& ticker,
+    float quantity,
+    float price,
+    const std::string& order_type,
+    const std::string& time_in_force
+)
+{
+    std::optional<messages::OrderType> type =
+        messages::order_type_from_string(order_type);
+    std::optional<messages::TimeInForce> tif =
+        messages::time_in_force_from_string(time_in_force);
+    if (!type.has_value() || !tif.has_value()) {
+        log_w(
+            rabbitmq,
+            "Not placing order with unknown order type {} or time in force {}",
+            order_type,
+            time_in_force
+        );
+        return false;
+    }
+
     if (limiter.should_rate_limit()) {
         return false;
     }
@@ -137,12 +307,75 @@ RabbitMQ::publishMarketOrder(
         side == "BUY" ? messages::SIDE::BUY : messages::SIDE::SELL,
         ticker,
         quantity,
-        price
+        price,
+        type.value(),
+        tif.value()
     };
     std::string message = glz::write_json(order);
 
     log_i(rabbitmq, "Publishing order: {}", message);
-    return publishMessage("market_order", message);
+    return queueOrderMessage(std::move(message));
+}
+
+size_t
+RabbitMQ::publishMarketOrders(
+    const std::string& client_uid,
+    const std::vector<pywrapper::OrderParameters>& orders
+)
+{
+    messages::MarketOrderBatch batch;
+    batch.orders.reserve(orders.size());
+    for (const auto& [side, ticker, quantity, price, order_type, time_in_force] :
+         orders) {
+        std::optional<messages::OrderType> type =
+            messages::order_type_from_string(order_type);
+        std::optional<messages::TimeInForce> tif =
+            messages::time_in_force_from_string(time_in_force);
+        if (!type.has_value() || !tif.has_value()) {
+            log_w(
+                rabbitmq,
+                "Not placing order with unknown order type {} or time in force {}",
+                order_type,
+                time_in_force
+            );
+            break;
+        }
+
+        if (limiter.should_rate_limit()) {
+            break;
+        }
+        batch.orders.emplace_back(
+            client_uid,
+            side == "BUY" ? messages::SIDE::BUY : messages::SIDE::SELL,
+            ticker,
+            quantity,
+            price,
+            type.value(),
+            tif.value()
+        );
+    }
+    if (batch.orders.empty()) {
+        return 0;
+    }
+
+    std::string message = glz::write_json(batch);
+    log_i(rabbitmq, "Publishing {} orders: {}", batch.orders.size(), message);
+    if (!queueOrderMessage(std::move(message))) {
+        return 0;
+    }
+    return batch.orders.size();
+}
+
+bool
+RabbitMQ::queueOrderMessage(std::string message)
+{
+    if (!outbound.try_push(std::move(message))) {
+        log_w(rabbitmq, "Dropping order, too many orders waiting to be sent");
+        return false;
+    }
+
+    wake_io_thread(outbound_event);
+    return true;
 }
 
 bool
@@ -168,7 +401,7 @@ RabbitMQ::publishMessage(const std::string& queueName, const std::string& messag
     return true;
 }
 
-std::variant<StartTime, ShutdownMessage, RMQError, ObUpdate, Match, AccountUpdate>
+RabbitMQ::IncomingMessage
 RabbitMQ::consumeMessage()
 {
     std::string buf = consumeMessageAsString();
@@ -176,8 +409,7 @@ RabbitMQ::consumeMessage()
         return RMQError{"Failed to consume message."};
     }
 
-    std::variant<StartTime, ShutdownMessage, RMQError, ObUpdate, Match, AccountUpdate>
-        data{};
+    IncomingMessage data{};
     auto err = glz::read_json(data, buf);
     if (err) {
         std::string error = glz::format_error(err, buf);
@@ -256,7 +488,8 @@ RabbitMQ::initializeConsume(const std::string& queueName)
     return true;
 }
 
-RabbitMQ::RabbitMQ(const std::string& uid)
+RabbitMQ::RabbitMQ(const std::string& uid) :
+    outbound_event(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
 {
     if (!initializeConnection(uid)) {
         log_c(rabbitmq, "Failed to initialize connection to RabbitMQ");
@@ -284,6 +517,31 @@ RabbitMQ::getMarketFunc(const std::string& uid)
     );
 }
 
+pywrapper::PublishOrderFunction
+RabbitMQ::getOrderFunc(const std::string& uid)
+{
+    return [this, uid](
+               const std::string& side,
+               const std::string& ticker,
+               float quantity,
+               float price,
+               const std::string& order_type,
+               const std::string& time_in_force
+           ) {
+        return publishOrder(
+            uid, side, ticker, quantity, price, order_type, time_in_force
+        );
+    };
+}
+
+pywrapper::PublishOrdersFunction
+RabbitMQ::getBatchMarketFunc(const std::string& uid)
+{
+    return [this, uid](const std::vector<pywrapper::OrderParameters>& orders) {
+        return publishMarketOrders(uid, orders);
+    };
+}
+
 bool
 RabbitMQ::publishInit(const std::string& uid, bool ready)
 {
@@ -328,6 +586,9 @@ RabbitMQ::initializeQueue(const std::string& queueName)
 
 RabbitMQ::~RabbitMQ()
 {
+    stopIoThread();
+    close(outbound_event);
+
     amqp_channel_close(conn, 1, AMQP_REPLY_SUCCESS);
     amqp_connection_close(conn, AMQP_REPLY_SUCCESS);
     amqp_destroy_connection(conn);
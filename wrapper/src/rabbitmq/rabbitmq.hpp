@@ -1,15 +1,23 @@
 #pragma once
 
+#include "config.h"
+#include "orderbook/orderbook.hpp"
 #include "pywrapper/pywrapper.hpp"
 #include "pywrapper/rate_limiter.hpp"
+#include "strategy/strategy.hpp"
 #include "util/messages.hpp"
+#include "util/spsc_queue.hpp"
 
 #include <unistd.h>
 
+#include <atomic>
 #include <chrono>
-
 #include <iostream>
+#include <optional>
 #include <string>
+#include <thread>
+#include <variant>
+#include <vector>
 
 #include <rabbitmq-c/amqp.h>
 #include <rabbitmq-c/tcp_socket.h>
@@ -22,6 +30,8 @@ using ShutdownMessage = nutc::messages::ShutdownMessage;
 using Match = nutc::messages::Match;
 using AccountUpdate = nutc::messages::AccountUpdate;
 using StartTime = nutc::messages::StartTime;
+using OrderAck = nutc::messages::OrderAck;
+using OrderReject = nutc::messages::OrderReject;
 
 /**
  * @brief The namespace for the NUTC client
@@ -38,6 +48,9 @@ namespace rabbitmq {
  *
  * Main event loop (i.e., program loops on this class)
  * Handles initialization and closure of the RMQ connection
+ * Once the event loop starts, a dedicated I/O thread owns the connection: it decodes
+ * incoming messages into a queue the Python thread drains, and publishes the orders
+ * the Python thread queues, so neither side waits on the other
  * Handles incoming messages from exchange (i.e., order book updates, matches, etc.)
  * Handles outgoing messages to exchange (i.e., market orders)
  * Provides a callback for the market order function (so it can be triggered by algo)
@@ -89,8 +102,32 @@ public:
     std::function<bool(const std::string&, const std::string&, float, float)>
     getMarketFunc(const std::string& uid);
 
+    /**
+     * @brief Callback for the batched market order function
+     *
+     * Like getMarketFunc, but places every order it is given in a single message
+     */
+    pywrapper::PublishOrdersFunction getBatchMarketFunc(const std::string& uid);
+
+    /**
+     * @brief Callback for the order function, which also takes an order type and time
+     * in force
+     *
+     * Like getMarketFunc, but bound to publishOrder
+     */
+    pywrapper::PublishOrderFunction getOrderFunc(const std::string& uid);
+
     void waitForStartTime();
 
+    /**
+     * @brief The books built from every order book update received so far
+     */
+    orderbook::OrderBooks&
+    getOrderBooks()
+    {
+        return books;
+    }
+
     /**
      * @brief Main event loop; handles incoming messages from exchange
      *
@@ -98,12 +135,25 @@ public:
      * SIGINT, it will continually receive messages from the exchange (orderbook update,
      * account update, or trade update)
      *
+     * @param strategy The algorithm to deliver messages to
      * @returns A shutdown or error message
      */
-    std::variant<ShutdownMessage, RMQError> handleIncomingMessages();
+    std::variant<ShutdownMessage, RMQError>
+    handleIncomingMessages(strategy::Strategy& strategy);
 
 private:
+    using IncomingMessage = std::variant<
+        StartTime,
+        ShutdownMessage,
+        RMQError,
+        ObUpdate,
+        Match,
+        AccountUpdate,
+        OrderAck,
+        OrderReject>;
+
     rate_limiter::RateLimiter limiter;
+    orderbook::OrderBooks books{ORDERBOOK_MAX_LEVELS};
     [[nodiscard]] bool initializeConnection(const std::string& queueName);
     [[nodiscard]] bool initializeConsume(const std::string& queueName);
     [[nodiscard]] bool connectToRabbitMQ(
@@ -124,10 +174,77 @@ private:
         float quantity,
         float price
     );
+    /**
+     * @param order_type One of LIMIT, MARKET and POST_ONLY
+     * @param time_in_force One of GTC, IOC and FOK
+     * @returns false if the order was rate limited or not understood
+     */
+    [[nodiscard]] bool publishOrder(
+        const std::string& client_uid,
+        const std::string& side,
+        const std::string& ticker,
+        float quantity,
+        float price,
+        const std::string& order_type,
+        const std::string& time_in_force
+    );
+    /**
+     * @returns How many orders, from the front, were placed. Placing stops at the
+     * first order that is rate limited or has an unknown order type or time in force
+     */
+    [[nodiscard]] size_t publishMarketOrders(
+        const std::string& client_uid,
+        const std::vector<pywrapper::OrderParameters>& orders
+    );
+
+    // Hands a serialized order message to the I/O thread
+    [[nodiscard]] bool queueOrderMessage(std::string message);
 
     std::string consumeMessageAsString();
-    std::variant<StartTime, ShutdownMessage, RMQError, ObUpdate, Match, AccountUpdate>
-    consumeMessage();
+    IncomingMessage consumeMessage();
+
+    // Connection I/O happens on io_thread while the event loop runs; both queues have
+    // the I/O thread on one end and the Python thread on the other
+    util::SPSCQueue<IncomingMessage> inbound{IO_QUEUE_CAPACITY};
+    util::SPSCQueue<std::string> outbound{IO_QUEUE_CAPACITY};
+    // Signalled when an order is queued, to wake the I/O thread
+    int outbound_event;
+    std::atomic<bool> io_running{false};
+    std::atomic<bool> io_finished{false};
+    std::thread io_thread;
+
+    void startIoThread();
+    void stopIoThread();
+
+    /**
+     * @brief Body of the I/O thread
+     *
+     * Sleeps in poll() until the socket is readable or an order is queued, so it uses
+     * no CPU while idle. Exits after passing on a shutdown message or error
+     */
+    void runIo();
+    void flushOutbound();
+
+    /**
+     * @brief Pops the next decoded message, sleeping (without the GIL) until one
+     * arrives
+     */
+    IncomingMessage nextMessage();
+
+    /**
+     * @brief Calls the algorithm's callback for a single message
+     * @returns The message to stop the event loop with, if any
+     */
+    std::optional<std::variant<ShutdownMessage, RMQError>>
+    handleMessage(strategy::Strategy& strategy, const IncomingMessage& data);
+
+    /**
+     * @brief Delivers the pending updates in one on_orderbook_updates call and clears
+     * them
+     */
+    static void dispatchOrderbookUpdates(
+        strategy::Strategy& strategy, std::vector<ObUpdate>& updates
+    );
 };
 
 } // namespace rabbitmq
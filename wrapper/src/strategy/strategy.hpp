@@ -0,0 +1,60 @@
+#pragma once
+
+#include "util/messages.hpp"
+
+#include <string>
+#include <vector>
+
+namespace nutc {
+
+/**
+ * @brief The interface between the event loop and a trading algorithm
+ */
+namespace strategy {
+
+/**
+ * @class Strategy
+ * @brief Receives the exchange's messages on behalf of an algorithm
+ *
+ * Implemented for Python algorithms (pywrapper::PythonStrategy) and for native shared
+ * libraries (native::NativeStrategy)
+ */
+class Strategy {
+public:
+    Strategy() = default;
+    virtual ~Strategy() = default;
+
+    Strategy(const Strategy&) = delete;
+    Strategy& operator=(const Strategy&) = delete;
+    Strategy(Strategy&&) = delete;
+    Strategy& operator=(Strategy&&) = delete;
+
+    virtual void on_orderbook_update(const messages::ObUpdate& update) = 0;
+
+    /**
+     * @brief Whether the event loop should collect order book updates that arrive
+     * together and deliver them through on_orderbook_updates
+     */
+    virtual bool
+    batches_orderbook_updates() const
+    {
+        return false;
+    }
+
+    virtual void
+    on_orderbook_updates(const std::vector<messages::ObUpdate>& updates)
+    {
+        for (const auto& update : updates)
+            on_orderbook_update(update);
+    }
+
+    virtual void on_trade_update(const messages::Match& match) = 0;
+    virtual void on_account_update(const messages::AccountUpdate& update) = 0;
+
+    virtual void
+    on_order_rejected(const messages::OrderReject& /* unused */)
+    {}
+};
+
+} // namespace strategy
+} // namespace nutc
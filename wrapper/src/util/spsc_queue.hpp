@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace nutc {
+namespace util {
+
+/**
+ * @class SPSCQueue
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * Pushing and popping never lock. Either side can block until the other makes
+ * progress through wait_for_items/wait_for_space, which sleep on the atomic indices
+ * (C++20 atomic wait) instead of spinning
+ */
+template <typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(size_t min_capacity) :
+        slots(round_up_to_power_of_two(min_capacity)), mask(slots.size() - 1)
+    {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // Producer only
+    bool
+    try_push(T&& value)
+    {
+        size_t tail = tail_index.load(std::memory_order_relaxed);
+        if (tail - cached_head >= slots.size()) {
+            cached_head = head_index.load(std::memory_order_acquire);
+            if (tail - cached_head >= slots.size())
+                return false;
+        }
+
+        slots[tail & mask] = std::move(value);
+        tail_index.store(tail + 1, std::memory_order_release);
+        tail_index.notify_one();
+        return true;
+    }
+
+    // Consumer only
+    std::optional<T>
+    try_pop()
+    {
+        size_t head = head_index.load(std::memory_order_relaxed);
+        if (head == cached_tail) {
+            cached_tail = tail_index.load(std::memory_order_acquire);
+            if (head == cached_tail)
+                return std::nullopt;
+        }
+
+        T value = std::move(slots[head & mask]);
+        head_index.store(head + 1, std::memory_order_release);
+        head_index.notify_one();
+        return value;
+    }
+
+    // Consumer only
+    bool
+    empty() const
+    {
+        return head_index.load(std::memory_order_relaxed)
+               == tail_index.load(std::memory_order_acquire);
+    }
+
+    // Consumer only; blocks until there is something to pop
+    void
+    wait_for_items() const
+    {
+        size_t head = head_index.load(std::memory_order_relaxed);
+        tail_index.wait(head, std::memory_order_acquire);
+    }
+
+    // Producer only; blocks until there is room to push
+    void
+    wait_for_space() const
+    {
+        size_t tail = tail_index.load(std::memory_order_relaxed);
+        size_t full_head = tail - slots.size();
+        head_index.wait(full_head, std::memory_order_acquire);
+    }
+
+private:
+    static size_t
+    round_up_to_power_of_two(size_t value)
+    {
+        size_t capacity = 1;
+        while (capacity < value)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    std::vector<T> slots;
+    size_t mask;
+
+    // Each index is written by one side only; kept apart to avoid false sharing
+    alignas(64) std::atomic<size_t> head_index{0};
+    alignas(64) size_t cached_tail = 0; // consumer's last view of tail_index
+    alignas(64) std::atomic<size_t> tail_index{0};
+    alignas(64) size_t cached_head = 0; // producer's last view of head_index
+};
+
+} // namespace util
+} // namespace nutc
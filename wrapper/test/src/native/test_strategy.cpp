@@ -0,0 +1,81 @@
+// A native strategy for the tests, built once per TEST_STRATEGY_ABI_VERSION. It
+// answers every callback with an order, so tests can see what it was given
+
+#include "native/strategy_abi.h"
+
+#include <new>
+
+#ifndef TEST_STRATEGY_ABI_VERSION
+#    define TEST_STRATEGY_ABI_VERSION NUTC_STRATEGY_ABI_VERSION
+#endif
+
+namespace {
+struct TestStrategy {
+    nutc_place_market_order_fn place_market_order;
+    void* context;
+};
+
+void*
+create(nutc_place_market_order_fn place_market_order, void* context)
+{
+    return new (std::nothrow) TestStrategy{place_market_order, context};
+}
+
+void
+destroy(void* strategy)
+{
+    delete static_cast<TestStrategy*>(strategy);
+}
+
+void
+on_orderbook_update(
+    void* strategy, const char* ticker, nutc_side side, float price, float quantity
+)
+{
+    auto* state = static_cast<TestStrategy*>(strategy);
+    state->place_market_order(state->context, side, ticker, quantity, price);
+}
+
+void
+on_trade_update(
+    void* strategy, const char* ticker, nutc_side side, float price, float quantity
+)
+{
+    // Trades are answered from the other side
+    auto* state = static_cast<TestStrategy*>(strategy);
+    nutc_side other = side == NUTC_SIDE_BUY ? NUTC_SIDE_SELL : NUTC_SIDE_BUY;
+    state->place_market_order(state->context, other, ticker, quantity, price);
+}
+
+void
+on_account_update(
+    void* strategy,
+    const char* ticker,
+    nutc_side side,
+    float /* price */,
+    float quantity,
+    float capital_remaining
+)
+{
+    // Account updates are answered at the capital remaining
+    auto* state = static_cast<TestStrategy*>(strategy);
+    state->place_market_order(
+        state->context, side, ticker, quantity, capital_remaining
+    );
+}
+
+const nutc_strategy_v1 STRATEGY{
+    TEST_STRATEGY_ABI_VERSION,
+    create,
+    destroy,
+    on_orderbook_update,
+    on_trade_update,
+    on_account_update
+};
+} // namespace
+
+extern "C" const nutc_strategy_v1*
+nutc_get_strategy(void)
+{
+    return &STRATEGY;
+}
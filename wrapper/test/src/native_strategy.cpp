@@ -0,0 +1,77 @@
+#include "native/native_strategy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using nutc::native::NativeStrategy;
+using nutc::messages::SIDE;
+
+namespace {
+struct PlacedOrder {
+    std::string side;
+    std::string ticker;
+    float quantity;
+    float price;
+
+    bool operator==(const PlacedOrder&) const = default;
+};
+} // namespace
+
+// The test strategy answers every callback with an order (see native/test_strategy.cpp)
+class NativeStrategyTest : public ::testing::Test {
+protected:
+    std::vector<PlacedOrder> orders;
+
+    nutc::native::PlaceOrderFunction
+    record_orders()
+    {
+        return [this](
+                   const std::string& side,
+                   const std::string& ticker,
+                   float quantity,
+                   float price
+               ) {
+            orders.push_back({side, ticker, quantity, price});
+            return true;
+        };
+    }
+};
+
+TEST_F(NativeStrategyTest, DeliversCallbacks)
+{
+    auto strategy = NativeStrategy::load(TEST_STRATEGY_PATH);
+    ASSERT_NE(strategy, nullptr);
+    strategy->start(record_orders());
+
+    strategy->on_orderbook_update({"A", SIDE::BUY, 100, 2});
+    strategy->on_trade_update({"B", "buyer", "seller", SIDE::BUY, 200, 3});
+    strategy->on_account_update({5000, "C", SIDE::SELL, 300, 4});
+
+    std::vector<PlacedOrder> expected{
+        {"BUY", "A", 2, 100}, {"SELL", "B", 3, 200}, {"SELL", "C", 4, 5000}
+    };
+    EXPECT_EQ(orders, expected);
+}
+
+TEST_F(NativeStrategyTest, DropsCallbacksBeforeStart)
+{
+    auto strategy = NativeStrategy::load(TEST_STRATEGY_PATH);
+    ASSERT_NE(strategy, nullptr);
+
+    strategy->on_orderbook_update({"A", SIDE::BUY, 100, 2});
+    strategy->start(record_orders());
+    EXPECT_TRUE(orders.empty());
+}
+
+TEST_F(NativeStrategyTest, RejectsUnsupportedAbiVersions)
+{
+    EXPECT_EQ(NativeStrategy::load(TEST_STRATEGY_NEWER_ABI_PATH), nullptr);
+    EXPECT_EQ(NativeStrategy::load(TEST_STRATEGY_ZERO_ABI_PATH), nullptr);
+}
+
+TEST_F(NativeStrategyTest, RejectsMissingLibraries)
+{
+    EXPECT_EQ(NativeStrategy::load("/nonexistent/strategy.so"), nullptr);
+}
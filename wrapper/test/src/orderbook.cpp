@@ -0,0 +1,124 @@
+#include "orderbook/orderbook.hpp"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+using nutc::messages::SIDE;
+using nutc::orderbook::BookSide;
+using nutc::orderbook::OrderBooks;
+
+namespace {
+// Every (price, quantity) column of the side, including those past the depth
+std::vector<std::pair<float, float>>
+columns(const BookSide& side)
+{
+    std::vector<std::pair<float, float>> result;
+    for (size_t i = 0; i < side.capacity(); i++)
+        result.emplace_back(side.prices()[i], side.quantities()[i]);
+    return result;
+}
+
+using Columns = std::vector<std::pair<float, float>>;
+} // namespace
+
+TEST(BookSide, KeepsBidsBestFirst)
+{
+    BookSide bids{SIDE::BUY, 4};
+    bids.set_level(100, 1);
+    bids.set_level(102, 2);
+    bids.set_level(101, 3);
+
+    EXPECT_EQ(bids.depth(), 3);
+    EXPECT_EQ(columns(bids), (Columns{{102, 2}, {101, 3}, {100, 1}, {0, 0}}));
+}
+
+TEST(BookSide, KeepsAsksBestFirst)
+{
+    BookSide asks{SIDE::SELL, 4};
+    asks.set_level(102, 1);
+    asks.set_level(100, 2);
+    asks.set_level(101, 3);
+
+    EXPECT_EQ(asks.depth(), 3);
+    EXPECT_EQ(columns(asks), (Columns{{100, 2}, {101, 3}, {102, 1}, {0, 0}}));
+}
+
+TEST(BookSide, UpdatesExistingLevels)
+{
+    BookSide bids{SIDE::BUY, 4};
+    bids.set_level(100, 1);
+    bids.set_level(100, 5);
+
+    EXPECT_EQ(bids.depth(), 1);
+    EXPECT_EQ(bids.quantities()[0], 5);
+}
+
+TEST(BookSide, RemovesLevelsAndZeroesTheVacatedColumn)
+{
+    BookSide bids{SIDE::BUY, 4};
+    bids.set_level(100, 1);
+    bids.set_level(101, 2);
+    bids.set_level(102, 3);
+
+    bids.set_level(101, 0);
+    EXPECT_EQ(bids.depth(), 2);
+    EXPECT_EQ(columns(bids), (Columns{{102, 3}, {100, 1}, {0, 0}, {0, 0}}));
+
+    // Removing a level that isn't there changes nothing
+    bids.set_level(99, 0);
+    EXPECT_EQ(bids.depth(), 2);
+
+    bids.set_level(102, 0);
+    bids.set_level(100, 0);
+    EXPECT_EQ(bids.depth(), 0);
+    EXPECT_EQ(columns(bids), (Columns{{0, 0}, {0, 0}, {0, 0}, {0, 0}}));
+}
+
+TEST(BookSide, DropsTheDeepestLevelAtCapacity)
+{
+    BookSide asks{SIDE::SELL, 3};
+    asks.set_level(101, 1);
+    asks.set_level(102, 2);
+    asks.set_level(103, 3);
+
+    // Better than the deepest, so 103 makes room for it
+    asks.set_level(100, 4);
+    EXPECT_EQ(asks.depth(), 3);
+    EXPECT_EQ(columns(asks), (Columns{{100, 4}, {101, 1}, {102, 2}}));
+
+    // Worse than every level kept, so it is dropped
+    asks.set_level(105, 5);
+    EXPECT_EQ(columns(asks), (Columns{{100, 4}, {101, 1}, {102, 2}}));
+}
+
+TEST(BookSide, StorageIsNeverReallocated)
+{
+    BookSide bids{SIDE::BUY, 2};
+    const float* prices = bids.prices();
+    for (int price = 0; price < 10; price++)
+        bids.set_level(static_cast<float>(price), 1);
+
+    EXPECT_EQ(bids.prices(), prices);
+    EXPECT_EQ(bids.quantities(), prices + 2);
+}
+
+TEST(OrderBooks, AppliesUpdatesToEachTickersBook)
+{
+    OrderBooks books{4};
+    books.apply({"A", SIDE::BUY, 100, 1});
+    books.apply({"A", SIDE::SELL, 101, 2});
+    books.apply({"B", SIDE::BUY, 50, 3});
+
+    auto& a = books.get_book("A");
+    EXPECT_EQ(a.bids.depth(), 1);
+    EXPECT_EQ(a.asks.depth(), 1);
+    EXPECT_EQ(a.asks.prices()[0], 101);
+    EXPECT_EQ(books.get_book("B").bids.quantities()[0], 3);
+
+    // Books stay put as others are created
+    for (int i = 0; i < 100; i++)
+        books.get_book(std::to_string(i));
+    EXPECT_EQ(&books.get_book("A"), &a);
+}
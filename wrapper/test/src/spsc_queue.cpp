@@ -0,0 +1,126 @@
+#include "util/spsc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using nutc::util::SPSCQueue;
+
+TEST(SPSCQueue, StartsEmpty)
+{
+    SPSCQueue<int> queue{4};
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.try_pop(), std::nullopt);
+}
+
+TEST(SPSCQueue, RoundsCapacityUpToAPowerOfTwo)
+{
+    SPSCQueue<int> queue{5};
+    for (int i = 0; i < 8; i++)
+        EXPECT_TRUE(queue.try_push(int{i})) << i;
+    EXPECT_FALSE(queue.try_push(8));
+
+    // Popping one makes room for one
+    EXPECT_EQ(queue.try_pop(), 0);
+    EXPECT_TRUE(queue.try_push(8));
+    EXPECT_FALSE(queue.try_push(9));
+}
+
+TEST(SPSCQueue, PopsInOrderAcrossWraparound)
+{
+    SPSCQueue<int> queue{4};
+    int next_push = 0;
+    int next_pop = 0;
+    // Keeps the queue partly full so the indices wrap many times
+    for (int round = 0; round < 100; round++) {
+        while (queue.try_push(int{next_push}))
+            next_push++;
+        for (int i = 0; i < 3; i++)
+            EXPECT_EQ(queue.try_pop(), next_pop++);
+    }
+    while (auto value = queue.try_pop())
+        EXPECT_EQ(value, next_pop++);
+    EXPECT_EQ(next_pop, next_push);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue, HoldsMoveOnlyValues)
+{
+    SPSCQueue<std::unique_ptr<int>> queue{2};
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(7)));
+
+    std::optional<std::unique_ptr<int>> value = queue.try_pop();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(**value, 7);
+}
+
+TEST(SPSCQueue, WaitForItemsBlocksUntilAPush)
+{
+    SPSCQueue<int> queue{4};
+    std::atomic<bool> woke{false};
+    std::thread consumer([&] {
+        queue.wait_for_items();
+        woke = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(woke);
+    EXPECT_TRUE(queue.try_push(1));
+    consumer.join();
+    EXPECT_TRUE(woke);
+    EXPECT_EQ(queue.try_pop(), 1);
+}
+
+TEST(SPSCQueue, WaitForSpaceBlocksUntilAPop)
+{
+    SPSCQueue<int> queue{2};
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+
+    std::atomic<bool> woke{false};
+    std::thread producer([&] {
+        queue.wait_for_space();
+        woke = true;
+        EXPECT_TRUE(queue.try_push(3));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(woke);
+    EXPECT_EQ(queue.try_pop(), 1);
+    producer.join();
+    EXPECT_TRUE(woke);
+    EXPECT_EQ(queue.try_pop(), 2);
+    EXPECT_EQ(queue.try_pop(), 3);
+}
+
+TEST(SPSCQueue, TwoThreadsKeepEveryValueInOrder)
+{
+    constexpr int COUNT = 1000000;
+    SPSCQueue<int> queue{64};
+
+    std::thread producer([&] {
+        for (int i = 0; i < COUNT; i++) {
+            while (!queue.try_push(int{i}))
+                queue.wait_for_space();
+        }
+    });
+
+    int expected = 0;
+    bool in_order = true;
+    while (expected < COUNT) {
+        std::optional<int> value = queue.try_pop();
+        if (!value.has_value()) {
+            queue.wait_for_items();
+            continue;
+        }
+        in_order = in_order && value.value() == expected;
+        expected++;
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(queue.empty());
+}